@@ -0,0 +1,107 @@
+#ifndef CORE_BENCH_H
+#define CORE_BENCH_H
+
+/* This generated file contains includes for project dependencies */
+#include "core_bench/bake_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of entities created by benchmarks that operate on a populated world */
+#define BENCH_ENTITY_COUNT (100 * 1000)
+
+/* Number of tags used to spread entities out over archetypes */
+#define BENCH_TAG_COUNT (16)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+typedef struct Velocity {
+    float x;
+    float y;
+} Velocity;
+
+typedef struct Mass {
+    float value;
+} Mass;
+
+/* A benchmark action performs ops operations and returns the time in seconds
+ * that was spent on them. Setting up and tearing down the world is not
+ * measured. The meaning of param depends on the benchmark, and is for example
+ * the number of archetypes or the number of threads. */
+typedef double (*bench_action_t)(
+    int32_t param,
+    int32_t ops);
+
+/* Benchmarks assign computed values to this variable, so that the compiler
+ * can't optimize away the code that computes them. */
+extern volatile double bench_sink;
+
+/* Return the next number from the benchmark random number generator. The
+ * generator is reset to the same seed before each run, so that a run performs
+ * the same operations every time. */
+uint64_t bench_rng(void);
+
+/* Shuffle an array of entities with the benchmark random number generator */
+void bench_shuffle(
+    ecs_entity_t *entities,
+    int32_t count);
+
+/* Create BENCH_TAG_COUNT tags */
+void bench_create_tags(
+    ecs_world_t *world,
+    ecs_entity_t *tags);
+
+/* Add tags to an entity so that it ends up in one of archetype_count
+ * archetypes, selected by index. */
+void bench_add_archetype_tags(
+    ecs_world_t *world,
+    ecs_entity_t e,
+    const ecs_entity_t *tags,
+    int32_t index,
+    int32_t archetype_count);
+
+/* Entity benchmarks */
+double bench_entity_new(int32_t param, int32_t ops);
+double bench_entity_new_move(int32_t param, int32_t ops);
+double bench_entity_delete(int32_t param, int32_t ops);
+double bench_add_remove(int32_t param, int32_t ops);
+double bench_add_remove_random(int32_t param, int32_t ops);
+double bench_get(int32_t param, int32_t ops);
+double bench_set(int32_t param, int32_t ops);
+double bench_get_mut(int32_t param, int32_t ops);
+double bench_get_inherited(int32_t param, int32_t ops);
+double bench_defer_add_remove(int32_t param, int32_t ops);
+
+/* Query benchmarks */
+double bench_query_iter(int32_t param, int32_t ops);
+double bench_query_sorted(int32_t param, int32_t ops);
+double bench_query_iter_disabled(int32_t param, int32_t ops);
+double bench_query_iter_case(int32_t param, int32_t ops);
+double bench_query_each(int32_t param, int32_t ops);
+double bench_query_each_entity(int32_t param, int32_t ops);
+double bench_query_batches(int32_t param, int32_t ops);
+
+/* Pipeline benchmarks */
+double bench_pipeline_progress(int32_t param, int32_t ops);
+double bench_pipeline_new_id(int32_t param, int32_t ops);
+double bench_pipeline_timers(int32_t param, int32_t ops);
+
+/* Snapshot and reader/writer benchmarks */
+double bench_snapshot_take(int32_t param, int32_t ops);
+double bench_snapshot_take_incremental(int32_t param, int32_t ops);
+double bench_snapshot_diff(int32_t param, int32_t ops);
+double bench_snapshot_restore(int32_t param, int32_t ops);
+double bench_reader(int32_t param, int32_t ops);
+double bench_writer(int32_t param, int32_t ops);
+double bench_blob_write(int32_t param, int32_t ops);
+double bench_blob_read(int32_t param, int32_t ops);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
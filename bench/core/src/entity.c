@@ -0,0 +1,390 @@
+#include <core_bench.h>
+
+/* Number of entities that random add/remove operations are spread out over */
+#define CHURN_ENTITY_COUNT (1000)
+
+static
+ecs_entity_t* new_entities(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    int32_t count)
+{
+    ecs_entity_t *entities = ecs_os_malloc(ECS_SIZEOF(ecs_entity_t) * count);
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        entities[i] = ecs_new_w_id(world, component);
+    }
+    return entities;
+}
+
+double bench_entity_new(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t i;
+    for (i = 0; i < ops; i ++) {
+        ecs_new(world, Position);
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_fini(world);
+    return result;
+}
+
+double bench_entity_delete(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t *entities = new_entities(world, ecs_id(Position), ops);
+    bench_shuffle(entities, ops);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t i;
+    for (i = 0; i < ops; i ++) {
+        ecs_delete(world, entities[i]);
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_os_free(entities);
+    ecs_fini(world);
+    return result;
+}
+
+/* Each operation adds and removes a component, which moves the entity to
+ * another table and back. */
+double bench_add_remove(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t *entities = new_entities(world, ecs_id(Position), ops);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t i;
+    for (i = 0; i < ops; i ++) {
+        ecs_add(world, entities[i], Velocity);
+        ecs_remove(world, entities[i], Velocity);
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_os_free(entities);
+    ecs_fini(world);
+    return result;
+}
+
+/* Each operation toggles a random tag on a random entity, which moves entities
+ * between up to 2^param tables. */
+double bench_add_remove_random(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t tags[BENCH_TAG_COUNT];
+    bench_create_tags(world, tags);
+
+    ecs_entity_t *entities = new_entities(
+        world, ecs_id(Position), CHURN_ENTITY_COUNT);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t i;
+    for (i = 0; i < ops; i ++) {
+        uint64_t r = bench_rng();
+        ecs_entity_t e = entities[r % CHURN_ENTITY_COUNT];
+        ecs_entity_t tag = tags[(r >> 32) % (uint64_t)param];
+        if (ecs_has_id(world, e, tag)) {
+            ecs_remove_id(world, e, tag);
+        } else {
+            ecs_add_id(world, e, tag);
+        }
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_os_free(entities);
+    ecs_fini(world);
+    return result;
+}
+
+/* Entities are accessed in random order, and are spread out over archetypes so
+ * that the component is not always in the same column. */
+double bench_get(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t tags[BENCH_TAG_COUNT];
+    bench_create_tags(world, tags);
+
+    ecs_entity_t *entities = new_entities(world, ecs_id(Position), ops);
+    int32_t i;
+    for (i = 0; i < ops; i ++) {
+        ecs_add(world, entities[i], Velocity);
+        bench_add_archetype_tags(world, entities[i], tags, i, 16);
+    }
+    bench_shuffle(entities, ops);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    float sum = 0;
+    for (i = 0; i < ops; i ++) {
+        const Velocity *v = ecs_get(world, entities[i], Velocity);
+        sum += v->x;
+    }
+
+    double result = ecs_time_measure(&t);
+    bench_sink = sum;
+    ecs_os_free(entities);
+    ecs_fini(world);
+    return result;
+}
+
+double bench_set(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t tags[BENCH_TAG_COUNT];
+    bench_create_tags(world, tags);
+
+    ecs_entity_t *entities = new_entities(world, ecs_id(Position), ops);
+    int32_t i;
+    for (i = 0; i < ops; i ++) {
+        ecs_add(world, entities[i], Velocity);
+        bench_add_archetype_tags(world, entities[i], tags, i, 16);
+    }
+    bench_shuffle(entities, ops);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    for (i = 0; i < ops; i ++) {
+        ecs_set(world, entities[i], Velocity, {1, 2});
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_os_free(entities);
+    ecs_fini(world);
+    return result;
+}
+
+double bench_get_mut(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t tags[BENCH_TAG_COUNT];
+    bench_create_tags(world, tags);
+
+    ecs_entity_t *entities = new_entities(world, ecs_id(Position), ops);
+    int32_t i;
+    for (i = 0; i < ops; i ++) {
+        ecs_add(world, entities[i], Velocity);
+        bench_add_archetype_tags(world, entities[i], tags, i, 16);
+    }
+    bench_shuffle(entities, ops);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    for (i = 0; i < ops; i ++) {
+        Velocity *v = ecs_get_mut(world, entities[i], Velocity, NULL);
+        v->x ++;
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_os_free(entities);
+    ecs_fini(world);
+    return result;
+}
+
+/* Entities inherit Velocity from the root of a chain of prefab variants, with
+ * the instances spread out over a number of chains. */
+double bench_get_inherited(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    int32_t depth = param;
+    ecs_entity_t leafs[BENCH_TAG_COUNT];
+    int32_t i, d;
+    for (i = 0; i < BENCH_TAG_COUNT; i ++) {
+        ecs_entity_t base = ecs_set(world, 0, Velocity, {1, 2});
+        ecs_add_id(world, base, EcsPrefab);
+        for (d = 1; d < depth; d ++) {
+            base = ecs_new_w_pair(world, EcsIsA, base);
+            ecs_add_id(world, base, EcsPrefab);
+        }
+        leafs[i] = base;
+    }
+
+    ecs_entity_t *entities = new_entities(world, ecs_id(Position), ops);
+    for (i = 0; i < ops; i ++) {
+        ecs_add_pair(world, entities[i], EcsIsA, leafs[i % BENCH_TAG_COUNT]);
+    }
+    bench_shuffle(entities, ops);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    float sum = 0;
+    for (i = 0; i < ops; i ++) {
+        const Velocity *v = ecs_get(world, entities[i], Velocity);
+        sum += v->x;
+    }
+
+    double result = ecs_time_measure(&t);
+    bench_sink = sum;
+    ecs_os_free(entities);
+    ecs_fini(world);
+    return result;
+}
+
+/* Each operation enqueues an add and a remove for a different component, so
+ * that the measurement includes both enqueueing and flushing the commands. */
+double bench_defer_add_remove(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ecs_entity_t *entities = new_entities(world, ecs_id(Position), ops);
+    int32_t i;
+    for (i = 0; i < ops; i ++) {
+        ecs_add(world, entities[i], Velocity);
+    }
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    ecs_defer_begin(world);
+    for (i = 0; i < ops; i ++) {
+        ecs_add(world, entities[i], Mass);
+        ecs_remove(world, entities[i], Velocity);
+    }
+    ecs_defer_end(world);
+
+    double result = ecs_time_measure(&t);
+    ecs_os_free(entities);
+    ecs_fini(world);
+    return result;
+}
+
+static
+void position_ctor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *entity_ptr,
+    void *ptr,
+    size_t size,
+    int32_t count,
+    void *ctx)
+{
+    (void)world; (void)component; (void)entity_ptr; (void)ctx;
+    ecs_os_memset(ptr, 0, (ecs_size_t)size * count);
+}
+
+static
+void position_dtor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *entity_ptr,
+    void *ptr,
+    size_t size,
+    int32_t count,
+    void *ctx)
+{
+    (void)world; (void)component; (void)entity_ptr; (void)ptr; (void)size;
+    (void)count; (void)ctx;
+}
+
+static
+void position_move(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *dst_entity,
+    const ecs_entity_t *src_entity,
+    void *dst_ptr,
+    void *src_ptr,
+    size_t size,
+    int32_t count,
+    void *ctx)
+{
+    (void)world; (void)component; (void)dst_entity; (void)src_entity; 
+    (void)ctx;
+    ecs_os_memcpy(dst_ptr, src_ptr, (ecs_size_t)size * count);
+}
+
+/* Each operation creates an entity with a component that has lifecycle
+ * actions, so that growing the table relocates existing components with the
+ * move actions. If param is 1, the table is dimensioned up front. */
+double bench_entity_new_move(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_component_actions(world, Position, {
+        .ctor = position_ctor,
+        .dtor = position_dtor,
+        .move = position_move
+    });
+
+    if (param) {
+        ecs_dim_type(world, ecs_type(Position), ops);
+    }
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t i;
+    for (i = 0; i < ops; i ++) {
+        ecs_new(world, Position);
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_fini(world);
+    return result;
+}
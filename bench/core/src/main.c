@@ -0,0 +1,216 @@
+#include <core_bench.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Runs benchmarks for the core ECS operations and writes the results as JSON
+ * to stdout. Each benchmark is run once to warm up, after which it is run a
+ * number of times. The fastest and the median time per operation are reported
+ * in nanoseconds, as these are less sensitive to noise than the average.
+ *
+ * Usage: core_bench [--repeat count] [--filter name] */
+
+#define SEED (0x2545F4914F6CDD1Dull)
+#define DEFAULT_REPEAT (5)
+
+typedef struct bench_t {
+    const char *name;
+    bench_action_t action;
+    const char *param_name; /* Name of param in output, NULL if not used */
+    int32_t param;
+    int32_t ops;
+} bench_t;
+
+static const bench_t benchmarks[] = {
+    {"entity_new", bench_entity_new, NULL, 0, BENCH_ENTITY_COUNT},
+    {"entity_new_move", bench_entity_new_move, "reserved", 0, BENCH_ENTITY_COUNT},
+    {"entity_new_move", bench_entity_new_move, "reserved", 1, BENCH_ENTITY_COUNT},
+    {"entity_delete", bench_entity_delete, NULL, 0, BENCH_ENTITY_COUNT},
+    {"add_remove", bench_add_remove, NULL, 0, BENCH_ENTITY_COUNT},
+    {"add_remove_random", bench_add_remove_random, "tags", 4, BENCH_ENTITY_COUNT},
+    {"add_remove_random", bench_add_remove_random, "tags", 16, BENCH_ENTITY_COUNT},
+    {"get", bench_get, NULL, 0, BENCH_ENTITY_COUNT},
+    {"set", bench_set, NULL, 0, BENCH_ENTITY_COUNT},
+    {"get_mut", bench_get_mut, NULL, 0, BENCH_ENTITY_COUNT},
+    {"get_inherited", bench_get_inherited, "depth", 1, BENCH_ENTITY_COUNT},
+    {"get_inherited", bench_get_inherited, "depth", 4, BENCH_ENTITY_COUNT},
+    {"defer_add_remove", bench_defer_add_remove, NULL, 0, BENCH_ENTITY_COUNT},
+
+    {"query_iter", bench_query_iter, "archetypes", 1, 20 * BENCH_ENTITY_COUNT},
+    {"query_iter", bench_query_iter, "archetypes", 16, 20 * BENCH_ENTITY_COUNT},
+    {"query_iter", bench_query_iter, "archetypes", 256, 20 * BENCH_ENTITY_COUNT},
+    {"query_iter", bench_query_iter, "archetypes", 1024, 20 * BENCH_ENTITY_COUNT},
+    {"query_each", bench_query_each, "archetypes", 1, 20 * BENCH_ENTITY_COUNT},
+    {"query_each", bench_query_each, "archetypes", 1024, 20 * BENCH_ENTITY_COUNT},
+    {"query_each_entity", bench_query_each_entity, "archetypes", 1, 20 * BENCH_ENTITY_COUNT},
+    {"query_each_entity", bench_query_each_entity, "archetypes", 1024, 20 * BENCH_ENTITY_COUNT},
+    {"query_batches", bench_query_batches, "archetypes", 1, 20 * BENCH_ENTITY_COUNT},
+    {"query_batches", bench_query_batches, "archetypes", 1024, 20 * BENCH_ENTITY_COUNT},
+    {"query_iter_disabled", bench_query_iter_disabled, "run", 1, 20 * BENCH_ENTITY_COUNT},
+    {"query_iter_disabled", bench_query_iter_disabled, "run", 64, 20 * BENCH_ENTITY_COUNT},
+    {"query_iter_disabled", bench_query_iter_disabled, "run", 4096, 20 * BENCH_ENTITY_COUNT},
+    {"query_iter_case", bench_query_iter_case, "run", 1, 20 * BENCH_ENTITY_COUNT},
+    {"query_iter_case", bench_query_iter_case, "run", 64, 20 * BENCH_ENTITY_COUNT},
+    {"query_iter_case", bench_query_iter_case, "run", 4096, 20 * BENCH_ENTITY_COUNT},
+    {"query_sorted", bench_query_sorted, "changed", 10, 20},
+    {"query_sorted", bench_query_sorted, "changed", 1000, 20},
+
+    {"pipeline_progress", bench_pipeline_progress, "threads", 1, 100},
+    {"pipeline_progress", bench_pipeline_progress, "threads", 2, 100},
+    {"pipeline_progress", bench_pipeline_progress, "threads", 4, 100},
+    {"pipeline_progress", bench_pipeline_progress, "threads", 8, 100},
+    {"pipeline_new_id", bench_pipeline_new_id, "threads", 1, 100 * BENCH_ENTITY_COUNT},
+    {"pipeline_new_id", bench_pipeline_new_id, "threads", 2, 100 * BENCH_ENTITY_COUNT},
+    {"pipeline_new_id", bench_pipeline_new_id, "threads", 4, 100 * BENCH_ENTITY_COUNT},
+    {"pipeline_new_id", bench_pipeline_new_id, "threads", 8, 100 * BENCH_ENTITY_COUNT},
+    {"pipeline_timers", bench_pipeline_timers, "wheel", 0, 600},
+    {"pipeline_timers", bench_pipeline_timers, "wheel", 1, 600},
+
+    {"snapshot_take", bench_snapshot_take, NULL, 0, BENCH_ENTITY_COUNT},
+    {"snapshot_take_incremental", bench_snapshot_take_incremental, NULL, 0, BENCH_ENTITY_COUNT},
+    {"snapshot_diff", bench_snapshot_diff, NULL, 0, BENCH_ENTITY_COUNT},
+    {"snapshot_restore", bench_snapshot_restore, NULL, 0, BENCH_ENTITY_COUNT},
+    {"reader", bench_reader, NULL, 0, BENCH_ENTITY_COUNT},
+    {"writer", bench_writer, NULL, 0, BENCH_ENTITY_COUNT},
+    {"blob_write", bench_blob_write, NULL, 0, BENCH_ENTITY_COUNT},
+    {"blob_read", bench_blob_read, NULL, 0, BENCH_ENTITY_COUNT}
+};
+
+static uint64_t rng_state = SEED;
+
+volatile double bench_sink;
+
+uint64_t bench_rng(void) {
+    uint64_t x = rng_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rng_state = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+void bench_shuffle(
+    ecs_entity_t *entities,
+    int32_t count)
+{
+    int32_t i;
+    for (i = count - 1; i > 0; i --) {
+        int32_t j = (int32_t)(bench_rng() % (uint64_t)(i + 1));
+        ecs_entity_t tmp = entities[i];
+        entities[i] = entities[j];
+        entities[j] = tmp;
+    }
+}
+
+void bench_create_tags(
+    ecs_world_t *world,
+    ecs_entity_t *tags)
+{
+    int32_t i;
+    for (i = 0; i < BENCH_TAG_COUNT; i ++) {
+        tags[i] = ecs_new_id(world);
+    }
+}
+
+void bench_add_archetype_tags(
+    ecs_world_t *world,
+    ecs_entity_t e,
+    const ecs_entity_t *tags,
+    int32_t index,
+    int32_t archetype_count)
+{
+    ecs_assert(archetype_count <= (1 << BENCH_TAG_COUNT),
+        ECS_INVALID_PARAMETER, NULL);
+
+    int32_t i, bits = index % archetype_count;
+    for (i = 0; bits; i ++, bits >>= 1) {
+        if (bits & 1) {
+            ecs_add_id(world, e, tags[i]);
+        }
+    }
+}
+
+static
+int compare_time(
+    const void *ptr1,
+    const void *ptr2)
+{
+    double t1 = *(const double*)ptr1;
+    double t2 = *(const double*)ptr2;
+    return (t1 > t2) - (t1 < t2);
+}
+
+static
+void run(
+    const bench_t *bench,
+    int32_t repeat,
+    bool first)
+{
+    double *t = ecs_os_malloc(ECS_SIZEOF(double) * repeat);
+    int32_t i;
+
+    rng_state = SEED;
+    bench->action(bench->param, bench->ops);
+
+    for (i = 0; i < repeat; i ++) {
+        rng_state = SEED;
+        t[i] = bench->action(bench->param, bench->ops);
+    }
+
+    qsort(t, (size_t)repeat, sizeof(double), compare_time);
+
+    double ops = (double)bench->ops;
+    printf("%s\n    {\"name\": \"%s\"", first ? "" : ",", bench->name);
+    if (bench->param_name) {
+        printf(", \"%s\": %d", bench->param_name, bench->param);
+    }
+
+    printf(", \"ops\": %d, \"min_ns\": %.3f, \"median_ns\": %.3f}",
+        bench->ops, t[0] * 1e9 / ops, t[repeat / 2] * 1e9 / ops);
+    fflush(stdout);
+
+    ecs_os_free(t);
+}
+
+int main(int argc, char *argv[]) {
+    const char *filter = NULL;
+    int32_t repeat = DEFAULT_REPEAT;
+
+    int i;
+    for (i = 1; i < argc; i ++) {
+        if (!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+            repeat = atoi(argv[++ i]);
+        } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++ i];
+        } else {
+            fprintf(stderr,
+                "usage: %s [--repeat count] [--filter name]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    if (repeat < 1) {
+        repeat = 1;
+    }
+
+    posix_set_os_api();
+
+    printf("{\n  \"seed\": %llu,\n  \"repeat\": %d,\n  \"results\": [",
+        (unsigned long long)SEED, repeat);
+
+    bool first = true;
+    int32_t count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+    for (i = 0; i < count; i ++) {
+        const bench_t *bench = &benchmarks[i];
+        if (filter && !strstr(bench->name, filter)) {
+            continue;
+        }
+
+        run(bench, repeat, first);
+        first = false;
+    }
+
+    printf("\n  ]\n}\n");
+
+    return 0;
+}
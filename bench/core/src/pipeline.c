@@ -0,0 +1,162 @@
+#include <core_bench.h>
+
+static
+void Move(ecs_iter_t *it) {
+    Position *p = ecs_term(it, Position, 1);
+    Velocity *v = ecs_term(it, Velocity, 2);
+
+    int32_t i;
+    for (i = 0; i < it->count; i ++) {
+        p[i].x += v[i].x * it->delta_time;
+        p[i].y += v[i].y * it->delta_time;
+    }
+}
+
+static
+void Accelerate(ecs_iter_t *it) {
+    Velocity *v = ecs_term(it, Velocity, 1);
+    Mass *m = ecs_term(it, Mass, 2);
+
+    int32_t i;
+    for (i = 0; i < it->count; i ++) {
+        v[i].x += m[i].value * it->delta_time;
+        v[i].y += m[i].value * it->delta_time;
+    }
+}
+
+/* Each operation is a frame that runs two systems on BENCH_ENTITY_COUNT
+ * entities, with param threads. */
+double bench_pipeline_progress(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_SYSTEM(world, Accelerate, EcsOnUpdate, Velocity, Mass);
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position, Velocity);
+
+    ecs_entity_t tags[BENCH_TAG_COUNT];
+    bench_create_tags(world, tags);
+
+    int32_t i;
+    for (i = 0; i < BENCH_ENTITY_COUNT; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        bench_add_archetype_tags(world, e, tags, i, 16);
+        ecs_set(world, e, Position, {0, 0});
+        ecs_set(world, e, Velocity, {1, 1});
+        ecs_set(world, e, Mass, {1});
+    }
+
+    ecs_set_threads(world, param);
+
+    /* First frame initializes the pipeline and starts the workers */
+    ecs_progress(world, 0.01f);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    for (i = 0; i < ops; i ++) {
+        ecs_progress(world, 0.01f);
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_fini(world);
+    return result;
+}
+
+typedef struct Spawned {
+    ecs_entity_t id;
+} Spawned;
+
+static
+void Spawn(ecs_iter_t *it) {
+    Spawned *s = ecs_term(it, Spawned, 1);
+
+    int32_t i;
+    for (i = 0; i < it->count; i ++) {
+        s[i].id = ecs_new_id(it->world);
+    }
+}
+
+/* Each operation creates an entity id from a system with param threads. Only
+ * frames are measured. Ids are deleted in between frames so they can be
+ * recycled. */
+double bench_pipeline_new_id(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Spawned);
+
+    ECS_SYSTEM(world, Spawn, EcsOnUpdate, Spawned);
+
+    int32_t i;
+    for (i = 0; i < BENCH_ENTITY_COUNT; i ++) {
+        ecs_set(world, 0, Spawned, {0});
+    }
+
+    ecs_set_threads(world, param);
+
+    ecs_query_t *q = ecs_query_new(world, "Spawned");
+
+    /* First frame initializes the pipeline and starts the workers */
+    ecs_progress(world, 0);
+
+    double result = 0;
+    int32_t frame, frame_count = ops / BENCH_ENTITY_COUNT;
+    for (frame = 0; frame < frame_count; frame ++) {
+        ecs_time_t t;
+        ecs_os_get_time(&t);
+        ecs_progress(world, 0);
+        result += ecs_time_measure(&t);
+
+        ecs_iter_t it = ecs_query_iter(q);
+        while (ecs_query_next(&it)) {
+            Spawned *s = ecs_term(&it, Spawned, 1);
+            for (i = 0; i < it.count; i ++) {
+                ecs_delete(world, s[i].id);
+            }
+        }
+    }
+
+    ecs_fini(world);
+    return result;
+}
+
+/* Each operation is a frame of a world with BENCH_ENTITY_COUNT interval timers
+ * with intervals between 1 and 60 seconds. If param is set, the timers are
+ * progressed with the timer wheel. */
+double bench_pipeline_timers(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+
+    if (param) {
+        ecs_enable_timer_wheel(world, 0);
+    }
+
+    int32_t i;
+    for (i = 0; i < BENCH_ENTITY_COUNT; i ++) {
+        ecs_set_interval(world, 0, (FLECS_FLOAT)(1 + bench_rng() % 60));
+    }
+
+    /* First frame adds the tick sources to the timers */
+    ecs_progress(world, 1.0f / 60);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    for (i = 0; i < ops; i ++) {
+        ecs_progress(world, 1.0f / 60);
+    }
+
+    double result = ecs_time_measure(&t);
+
+    ecs_fini(world);
+
+    return result;
+}
@@ -0,0 +1,220 @@
+#include <core_bench.h>
+
+static
+void populate(
+    ecs_world_t *world,
+    ecs_entity_t *entities,
+    int32_t archetype_count)
+{
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t tags[BENCH_TAG_COUNT];
+    bench_create_tags(world, tags);
+
+    int32_t i;
+    for (i = 0; i < BENCH_ENTITY_COUNT; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        bench_add_archetype_tags(world, e, tags, i, archetype_count);
+        ecs_set(world, e, Position, {(float)(bench_rng() % 1000), 0});
+        ecs_set(world, e, Velocity, {1, 1});
+        if (entities) {
+            entities[i] = e;
+        }
+    }
+}
+
+/* Each operation is the iteration of a single entity. The query iterates all
+ * entities multiple times, so that ops / BENCH_ENTITY_COUNT is the number of
+ * times the query is iterated. */
+double bench_query_iter(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+    populate(world, NULL, param);
+
+    ecs_entity_t ecs_id(Position) = ecs_lookup(world, "Position");
+    ecs_entity_t ecs_id(Velocity) = ecs_lookup(world, "Velocity");
+
+    ecs_query_t *q = ecs_query_init(world, &(ecs_query_desc_t){
+        .filter.terms = {{ecs_id(Position)}, {ecs_id(Velocity)}}
+    });
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t pass, pass_count = ops / BENCH_ENTITY_COUNT;
+    for (pass = 0; pass < pass_count; pass ++) {
+        ecs_iter_t it = ecs_query_iter(q);
+        while (ecs_query_next(&it)) {
+            Position *p = ecs_term(&it, Position, 1);
+            Velocity *v = ecs_term(&it, Velocity, 2);
+
+            int32_t i;
+            for (i = 0; i < it.count; i ++) {
+                p[i].x += v[i].x;
+                p[i].y += v[i].y;
+            }
+        }
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_fini(world);
+    return result;
+}
+
+static
+int compare_position(
+    ecs_entity_t e1,
+    const void *ptr1,
+    ecs_entity_t e2,
+    const void *ptr2)
+{
+    (void)e1;
+    (void)e2;
+    const Position *p1 = ptr1;
+    const Position *p2 = ptr2;
+    return (p1->x > p2->x) - (p1->x < p2->x);
+}
+
+/* Each operation is a frame in which param entities change their position,
+ * after which the sorted query is iterated. */
+double bench_query_sorted(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+    ecs_entity_t *entities = ecs_os_malloc(
+        ECS_SIZEOF(ecs_entity_t) * BENCH_ENTITY_COUNT);
+    populate(world, entities, 16);
+
+    ecs_entity_t ecs_id(Position) = ecs_lookup(world, "Position");
+
+    ecs_query_t *q = ecs_query_init(world, &(ecs_query_desc_t){
+        .filter.terms = {{ecs_id(Position)}},
+        .order_by_id = ecs_id(Position),
+        .order_by = compare_position
+    });
+
+    /* Sort the query once, so the measurement doesn't include the first sort */
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) { }
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    float sum = 0;
+    int32_t frame;
+    for (frame = 0; frame < ops; frame ++) {
+        int32_t i;
+        for (i = 0; i < param; i ++) {
+            uint64_t r = bench_rng();
+            ecs_entity_t e = entities[r % BENCH_ENTITY_COUNT];
+            ecs_set(world, e, Position, {(float)((r >> 32) % 1000), 0});
+        }
+
+        it = ecs_query_iter(q);
+        while (ecs_query_next(&it)) {
+            Position *p = ecs_term(&it, Position, 1);
+            sum += p[0].x;
+        }
+    }
+
+    double result = ecs_time_measure(&t);
+    bench_sink = sum;
+    ecs_os_free(entities);
+    ecs_fini(world);
+    return result;
+}
+
+/* Each operation is the iteration of a single entity, as in query_iter. Half
+ * of the entities have Position disabled, in alternating runs of param
+ * entities. */
+double bench_query_iter_disabled(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    int32_t i;
+    for (i = 0; i < BENCH_ENTITY_COUNT; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        ecs_set(world, e, Position, {0, 0});
+        ecs_set(world, e, Velocity, {1, 1});
+        ecs_enable_component(world, e, Position, (i / param) % 2);
+    }
+
+    ecs_query_t *q = ecs_query_init(world, &(ecs_query_desc_t){
+        .filter.terms = {{ecs_id(Position)}, {ecs_id(Velocity)}}
+    });
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t pass, pass_count = ops / BENCH_ENTITY_COUNT;
+    for (pass = 0; pass < pass_count; pass ++) {
+        ecs_iter_t it = ecs_query_iter(q);
+        while (ecs_query_next(&it)) {
+            Position *p = ecs_term(&it, Position, 1);
+            Velocity *v = ecs_term(&it, Velocity, 2);
+
+            for (i = 0; i < it.count; i ++) {
+                p[i].x += v[i].x;
+                p[i].y += v[i].y;
+            }
+        }
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_fini(world);
+    return result;
+}
+
+/* Each operation is the iteration of a single entity. Half of the entities
+ * have the Running case, in alternating runs of param entities. */
+double bench_query_iter_case(
+    int32_t param,
+    int32_t ops)
+{
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Walking);
+    ECS_TAG(world, Running);
+    ECS_TYPE(world, Movement, Walking, Running);
+
+    int32_t i;
+    for (i = 0; i < BENCH_ENTITY_COUNT; i ++) {
+        ecs_entity_t e = ecs_new_w_id(world, ECS_SWITCH | Movement);
+        ecs_set(world, e, Position, {0, 0});
+        if ((i / param) % 2) {
+            ecs_add_id(world, e, ECS_CASE | Running);
+        } else {
+            ecs_add_id(world, e, ECS_CASE | Walking);
+        }
+    }
+
+    ecs_query_t *q = ecs_query_init(world, &(ecs_query_desc_t){
+        .filter.terms = {{ecs_id(Position)}, {ECS_CASE | Running}}
+    });
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t pass, pass_count = ops / BENCH_ENTITY_COUNT;
+    for (pass = 0; pass < pass_count; pass ++) {
+        ecs_iter_t it = ecs_query_iter(q);
+        while (ecs_query_next(&it)) {
+            Position *p = ecs_term(&it, Position, 1);
+            for (i = 0; i < it.count; i ++) {
+                p[i].x ++;
+            }
+        }
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_fini(world);
+    return result;
+}
@@ -0,0 +1,93 @@
+#include <core_bench.h>
+
+/* Benchmarks for the C++ query API. These can be compared with query_iter,
+ * which performs the same work with the C API. */
+
+static
+flecs::query<Position, const Velocity> populate(
+    flecs::world& world,
+    int32_t archetype_count)
+{
+    ecs_entity_t tags[BENCH_TAG_COUNT];
+    bench_create_tags(world.c_ptr(), tags);
+
+    int32_t i;
+    for (i = 0; i < BENCH_ENTITY_COUNT; i ++) {
+        flecs::entity e = world.entity();
+        bench_add_archetype_tags(world.c_ptr(), e.id(), tags, i,
+            archetype_count);
+        e.set<Position>({static_cast<float>(bench_rng() % 1000), 0});
+        e.set<Velocity>({1, 1});
+    }
+
+    return world.query<Position, const Velocity>();
+}
+
+/* Each operation is the iteration of a single entity, see bench_query_iter */
+double bench_query_each(
+    int32_t param,
+    int32_t ops)
+{
+    flecs::world world;
+    auto q = populate(world, param);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t pass, pass_count = ops / BENCH_ENTITY_COUNT;
+    for (pass = 0; pass < pass_count; pass ++) {
+        q.each([](Position& p, const Velocity& v) {
+            p.x += v.x;
+            p.y += v.y;
+        });
+    }
+
+    return ecs_time_measure(&t);
+}
+
+double bench_query_each_entity(
+    int32_t param,
+    int32_t ops)
+{
+    flecs::world world;
+    auto q = populate(world, param);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t pass, pass_count = ops / BENCH_ENTITY_COUNT;
+    for (pass = 0; pass < pass_count; pass ++) {
+        q.each([](flecs::entity, Position& p, const Velocity& v) {
+            p.x += v.x;
+            p.y += v.y;
+        });
+    }
+
+    return ecs_time_measure(&t);
+}
+
+/* Same as bench_query_each, iterated in batches of 8 entities */
+double bench_query_batches(
+    int32_t param,
+    int32_t ops)
+{
+    flecs::world world;
+    auto q = populate(world, param);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int32_t pass, pass_count = ops / BENCH_ENTITY_COUNT;
+    for (pass = 0; pass < pass_count; pass ++) {
+        q.iter_batches<8>([](size_t count, flecs::span<Position> p, 
+            flecs::span<const Velocity> v) 
+        {
+            for (size_t i = 0; i < count; i ++) {
+                p[i].x += v[i].x;
+                p[i].y += v[i].y;
+            }
+        });
+    }
+
+    return ecs_time_measure(&t);
+}
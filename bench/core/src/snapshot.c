@@ -0,0 +1,264 @@
+#include <core_bench.h>
+
+/* Size of the buffer used to read from and write to a blob */
+#define BLOB_BUFFER_SIZE (64 * 1024)
+
+static
+ecs_world_t* populate(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t tags[BENCH_TAG_COUNT];
+    bench_create_tags(world, tags);
+
+    int32_t i;
+    for (i = 0; i < BENCH_ENTITY_COUNT; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        bench_add_archetype_tags(world, e, tags, i, 16);
+        ecs_set(world, e, Position, {(float)i, 0});
+        ecs_set(world, e, Velocity, {1, 1});
+    }
+
+    return world;
+}
+
+static
+ecs_vector_t* read_world(
+    ecs_world_t *world)
+{
+    ecs_vector_t *blob = NULL;
+    ecs_reader_t reader = ecs_reader_init(world);
+    char *buffer = ecs_os_malloc(BLOB_BUFFER_SIZE);
+    int32_t read;
+
+    while ((read = ecs_reader_read(buffer, BLOB_BUFFER_SIZE, &reader))) {
+        void *ptr = ecs_vector_addn(&blob, char, read);
+        ecs_os_memcpy(ptr, buffer, read);
+    }
+
+    ecs_os_free(buffer);
+    return blob;
+}
+
+/* For each of the snapshot and reader/writer benchmarks, an operation is the
+ * processing of a single entity. */
+double bench_snapshot_take(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    (void)ops;
+    ecs_world_t *world = populate();
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    double result = ecs_time_measure(&t);
+    ecs_snapshot_free(s);
+    ecs_fini(world);
+    return result;
+}
+
+/* Take an incremental snapshot after a Position in each table changed, so that
+ * only the Velocity columns can be shared with the previous snapshot. */
+double bench_snapshot_take_incremental(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    (void)ops;
+    ecs_world_t *world = populate();
+    ecs_entity_t ecs_id(Position) = ecs_lookup(world, "Position");
+
+    ecs_snapshot_t *prev = ecs_snapshot_take_incremental(world, NULL);
+
+    ecs_query_t *q = ecs_query_init(world, &(ecs_query_desc_t){
+        .filter.terms = {{ecs_id(Position)}}
+    });
+
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        ecs_modified(world, it.entities[0], Position);
+    }
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    ecs_snapshot_t *s = ecs_snapshot_take_incremental(world, prev);
+
+    double result = ecs_time_measure(&t);
+    ecs_snapshot_free(s);
+    ecs_snapshot_free(prev);
+    ecs_fini(world);
+    return result;
+}
+
+/* Compute and encode the difference between a snapshot and the world, after
+ * the Position of one in every 16 entities changed. */
+double bench_snapshot_diff(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    (void)ops;
+    ecs_world_t *world = populate();
+    ecs_entity_t ecs_id(Position) = ecs_lookup(world, "Position");
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_query_t *q = ecs_query_init(world, &(ecs_query_desc_t){
+        .filter.terms = {{ecs_id(Position)}}
+    });
+
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        Position *p = ecs_term(&it, Position, 1);
+        int32_t i;
+        for (i = 0; i < it.count; i += 16) {
+            p[i].x ++;
+        }
+    }
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+
+    double result = ecs_time_measure(&t);
+    bench_sink = size;
+    ecs_os_free(blob);
+    ecs_snapshot_diff_free(d);
+    ecs_snapshot_free(s);
+    ecs_fini(world);
+    return result;
+}
+
+double bench_snapshot_restore(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    (void)ops;
+    ecs_world_t *world = populate();
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    ecs_snapshot_restore(world, s);
+
+    double result = ecs_time_measure(&t);
+    ecs_fini(world);
+    return result;
+}
+
+double bench_reader(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    (void)ops;
+    ecs_world_t *world = populate();
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    ecs_vector_t *blob = read_world(world);
+
+    double result = ecs_time_measure(&t);
+    ecs_vector_free(blob);
+    ecs_fini(world);
+    return result;
+}
+
+double bench_writer(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    (void)ops;
+    ecs_world_t *world = populate();
+    ecs_vector_t *blob = read_world(world);
+    ecs_fini(world);
+
+    world = ecs_init();
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    ecs_writer_t writer = ecs_writer_init(world);
+    char *ptr = ecs_vector_first(blob, char);
+    int32_t written, size = ecs_vector_count(blob);
+    for (written = 0; written < size; written += BLOB_BUFFER_SIZE) {
+        int32_t to_write = size - written;
+        if (to_write > BLOB_BUFFER_SIZE) {
+            to_write = BLOB_BUFFER_SIZE;
+        }
+
+        int result = ecs_writer_write(&ptr[written], to_write, &writer);
+        ecs_assert(result == 0, ECS_INTERNAL_ERROR, NULL);
+        (void)result;
+    }
+
+    double result = ecs_time_measure(&t);
+    ecs_assert(ecs_count_id(world, ecs_lookup(world, "Position")) ==
+        BENCH_ENTITY_COUNT, ECS_INTERNAL_ERROR, NULL);
+    ecs_vector_free(blob);
+    ecs_fini(world);
+    return result;
+}
+
+double bench_blob_write(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    (void)ops;
+    ecs_world_t *world = populate();
+    size_t size = ecs_world_to_blob(world, NULL, 0);
+    void *blob = ecs_os_malloc((ecs_size_t)size);
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    ecs_world_to_blob(world, blob, size);
+
+    double result = ecs_time_measure(&t);
+    ecs_os_free(blob);
+    ecs_fini(world);
+    return result;
+}
+
+double bench_blob_read(
+    int32_t param,
+    int32_t ops)
+{
+    (void)param;
+    (void)ops;
+    ecs_world_t *world = populate();
+    size_t size = ecs_world_to_blob(world, NULL, 0);
+    void *blob = ecs_os_malloc((ecs_size_t)size);
+    ecs_world_to_blob(world, blob, size);
+    ecs_fini(world);
+
+    world = ecs_init();
+
+    ecs_time_t t;
+    ecs_os_get_time(&t);
+
+    int err = ecs_world_from_blob(world, blob, size);
+
+    double result = ecs_time_measure(&t);
+    ecs_assert(err == 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(ecs_count_id(world, ecs_lookup(world, "Position")) ==
+        BENCH_ENTITY_COUNT, ECS_INTERNAL_ERROR, NULL);
+    (void)err;
+    ecs_os_free(blob);
+    ecs_fini(world);
+    return result;
+}
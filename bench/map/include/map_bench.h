@@ -0,0 +1,54 @@
+#ifndef MAP_BENCH_H
+#define MAP_BENCH_H
+
+/* This generated file contains includes for project dependencies */
+#include "map_bench/bake_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bucket based map that was used by flecs before the flat map. It is kept as
+ * a reference, so the benchmark can compare both implementations. */
+typedef struct chained_map_t chained_map_t;
+
+typedef struct chained_map_iter_t {
+    const chained_map_t *map;
+    int32_t bucket_index;
+    int32_t element_index;
+} chained_map_iter_t;
+
+chained_map_t* chained_map_new(
+    ecs_size_t elem_size,
+    int32_t elem_count);
+
+void chained_map_free(
+    chained_map_t *map);
+
+void* chained_map_get(
+    const chained_map_t *map,
+    ecs_map_key_t key);
+
+void* chained_map_ensure(
+    chained_map_t *map,
+    ecs_map_key_t key);
+
+void chained_map_remove(
+    chained_map_t *map,
+    ecs_map_key_t key);
+
+int32_t chained_map_count(
+    const chained_map_t *map);
+
+chained_map_iter_t chained_map_iter(
+    const chained_map_t *map);
+
+void* chained_map_next(
+    chained_map_iter_t *iter,
+    ecs_map_key_t *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,320 @@
+#include <map_bench.h>
+
+/* Reference copy of the bucket based map, with the same growth policy that
+ * flecs used before the flat map. */
+
+#define LOAD_FACTOR (1.5f)
+#define KEY_SIZE (ECS_SIZEOF(ecs_map_key_t))
+#define GET_ELEM(array, elem_size, index) \
+    ECS_OFFSET(array, (elem_size) * (index))
+
+typedef struct chained_bucket_t {
+    ecs_map_key_t *keys;    /* Array with keys */
+    void *payload;          /* Payload array */
+    int32_t count;          /* Number of elements in bucket */
+} chained_bucket_t;
+
+struct chained_map_t {
+    chained_bucket_t *buckets;
+    int32_t elem_size;
+    int32_t bucket_count;
+    int32_t count;
+};
+
+static
+int32_t next_pow_of_2(
+    int32_t n)
+{
+    n --;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+    n ++;
+
+    return n;
+}
+
+static
+int32_t get_bucket_count(
+    int32_t element_count)
+{
+    return next_pow_of_2((int32_t)((float)element_count * LOAD_FACTOR));
+}
+
+static
+int32_t get_bucket_id(
+    int32_t bucket_count,
+    ecs_map_key_t key)
+{
+    return (int32_t)(key & ((uint64_t)bucket_count - 1));
+}
+
+static
+chained_bucket_t* get_bucket(
+    const chained_map_t *map,
+    ecs_map_key_t key)
+{
+    int32_t bucket_count = map->bucket_count;
+    if (!bucket_count) {
+        return NULL;
+    }
+
+    return &map->buckets[get_bucket_id(bucket_count, key)];
+}
+
+static
+void ensure_buckets(
+    chained_map_t *map,
+    int32_t new_count)
+{
+    int32_t bucket_count = map->bucket_count;
+    new_count = next_pow_of_2(new_count);
+    if (new_count && new_count > bucket_count) {
+        map->buckets = ecs_os_realloc(
+            map->buckets, new_count * ECS_SIZEOF(chained_bucket_t));
+        map->bucket_count = new_count;
+
+        ecs_os_memset(
+            ECS_OFFSET(map->buckets, bucket_count * ECS_SIZEOF(chained_bucket_t)),
+            0, (new_count - bucket_count) * ECS_SIZEOF(chained_bucket_t));
+    }
+}
+
+static
+void clear_bucket(
+    chained_bucket_t *bucket)
+{
+    ecs_os_free(bucket->keys);
+    ecs_os_free(bucket->payload);
+    bucket->keys = NULL;
+    bucket->payload = NULL;
+    bucket->count = 0;
+}
+
+static
+chained_bucket_t* ensure_bucket(
+    chained_map_t *map,
+    ecs_map_key_t key)
+{
+    if (!map->bucket_count) {
+        ensure_buckets(map, 2);
+    }
+
+    return &map->buckets[get_bucket_id(map->bucket_count, key)];
+}
+
+static
+int32_t add_to_bucket(
+    chained_bucket_t *bucket,
+    ecs_size_t elem_size,
+    ecs_map_key_t key,
+    const void *payload)
+{
+    int32_t index = bucket->count ++;
+    int32_t bucket_count = index + 1;
+
+    bucket->keys = ecs_os_realloc(bucket->keys, KEY_SIZE * bucket_count);
+    bucket->payload = ecs_os_realloc(bucket->payload, elem_size * bucket_count);
+    bucket->keys[index] = key;
+
+    if (payload) {
+        void *elem = GET_ELEM(bucket->payload, elem_size, index);
+        ecs_os_memcpy(elem, payload, elem_size);
+    }
+
+    return index;
+}
+
+static
+void remove_from_bucket(
+    chained_bucket_t *bucket,
+    ecs_size_t elem_size,
+    int32_t index)
+{
+    int32_t bucket_count = -- bucket->count;
+
+    if (index != bucket->count) {
+        bucket->keys[index] = bucket->keys[bucket_count];
+
+        void *elem = GET_ELEM(bucket->payload, elem_size, index);
+        void *last_elem = GET_ELEM(bucket->payload, elem_size, bucket->count);
+
+        ecs_os_memcpy(elem, last_elem, elem_size);
+    }
+}
+
+static
+void* get_from_bucket(
+    chained_bucket_t *bucket,
+    ecs_map_key_t key,
+    ecs_size_t elem_size)
+{
+    ecs_map_key_t *keys = bucket->keys;
+    int32_t i, count = bucket->count;
+
+    for (i = 0; i < count; i ++) {
+        if (keys[i] == key) {
+            return GET_ELEM(bucket->payload, elem_size, i);
+        }
+    }
+    return NULL;
+}
+
+static
+void rehash(
+    chained_map_t *map,
+    int32_t bucket_count)
+{
+    ecs_size_t elem_size = map->elem_size;
+
+    ensure_buckets(map, bucket_count);
+
+    chained_bucket_t *buckets = map->buckets;
+    int32_t bucket_id;
+
+    for (bucket_id = bucket_count - 1; bucket_id >= 0; bucket_id --) {
+        chained_bucket_t *bucket = &buckets[bucket_id];
+
+        int i, count = bucket->count;
+        ecs_map_key_t *key_array = bucket->keys;
+        void *payload_array = bucket->payload;
+
+        for (i = 0; i < count; i ++) {
+            ecs_map_key_t key = key_array[i];
+            void *elem = GET_ELEM(payload_array, elem_size, i);
+            int32_t new_bucket_id = get_bucket_id(bucket_count, key);
+
+            if (new_bucket_id != bucket_id) {
+                chained_bucket_t *new_bucket = &buckets[new_bucket_id];
+
+                add_to_bucket(new_bucket, elem_size, key, elem);
+                remove_from_bucket(bucket, elem_size, i);
+
+                count --;
+                i --;
+            }
+        }
+
+        if (!bucket->count) {
+            clear_bucket(bucket);
+        }
+    }
+}
+
+chained_map_t* chained_map_new(
+    ecs_size_t elem_size,
+    int32_t element_count)
+{
+    chained_map_t *result = ecs_os_calloc(ECS_SIZEOF(chained_map_t) * 1);
+    result->elem_size = elem_size;
+    ensure_buckets(result, get_bucket_count(element_count));
+    return result;
+}
+
+void chained_map_free(
+    chained_map_t *map)
+{
+    int32_t i;
+    for (i = 0; i < map->bucket_count; i ++) {
+        clear_bucket(&map->buckets[i]);
+    }
+    ecs_os_free(map->buckets);
+    ecs_os_free(map);
+}
+
+void* chained_map_get(
+    const chained_map_t *map,
+    ecs_map_key_t key)
+{
+    chained_bucket_t *bucket = get_bucket(map, key);
+    if (!bucket) {
+        return NULL;
+    }
+
+    return get_from_bucket(bucket, key, map->elem_size);
+}
+
+void* chained_map_ensure(
+    chained_map_t *map,
+    ecs_map_key_t key)
+{
+    ecs_size_t elem_size = map->elem_size;
+    chained_bucket_t *bucket = ensure_bucket(map, key);
+
+    void *elem = get_from_bucket(bucket, key, elem_size);
+    if (elem) {
+        return elem;
+    }
+
+    int32_t index = add_to_bucket(bucket, elem_size, key, NULL);
+    int32_t target_bucket_count = get_bucket_count(++ map->count);
+
+    if (target_bucket_count > map->bucket_count) {
+        rehash(map, target_bucket_count);
+        bucket = ensure_bucket(map, key);
+        elem = get_from_bucket(bucket, key, elem_size);
+    } else {
+        elem = GET_ELEM(bucket->payload, elem_size, index);
+    }
+
+    ecs_os_memset(elem, 0, elem_size);
+    return elem;
+}
+
+void chained_map_remove(
+    chained_map_t *map,
+    ecs_map_key_t key)
+{
+    chained_bucket_t *bucket = get_bucket(map, key);
+    if (!bucket) {
+        return;
+    }
+
+    int32_t i, bucket_count = bucket->count;
+    for (i = 0; i < bucket_count; i ++) {
+        if (bucket->keys[i] == key) {
+            remove_from_bucket(bucket, map->elem_size, i);
+            map->count --;
+            break;
+        }
+    }
+}
+
+int32_t chained_map_count(
+    const chained_map_t *map)
+{
+    return map->count;
+}
+
+chained_map_iter_t chained_map_iter(
+    const chained_map_t *map)
+{
+    return (chained_map_iter_t){ .map = map };
+}
+
+void* chained_map_next(
+    chained_map_iter_t *iter,
+    ecs_map_key_t *key_out)
+{
+    const chained_map_t *map = iter->map;
+
+    while (iter->bucket_index < map->bucket_count) {
+        chained_bucket_t *bucket = &map->buckets[iter->bucket_index];
+        int32_t element_index = iter->element_index;
+
+        if (element_index < bucket->count) {
+            iter->element_index ++;
+            if (key_out) {
+                *key_out = bucket->keys[element_index];
+            }
+            return GET_ELEM(bucket->payload, map->elem_size, element_index);
+        }
+
+        iter->bucket_index ++;
+        iter->element_index = 0;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,201 @@
+#include <map_bench.h>
+#include <stdio.h>
+
+/* Compares the flat ecs_map_t with the bucket based map it replaced. Each
+ * measurement runs the same operations on both maps, with the same keys and
+ * with a fixed seed, so results can be compared between runs. */
+
+#define SEED (0x2545F4914F6CDD1Dull)
+#define OPS_PER_SIZE (4 * 1000 * 1000)
+
+typedef enum bench_op_t {
+    BenchInsert,
+    BenchLookup,
+    BenchLookupMiss,
+    BenchIterate,
+    BenchRemove,
+    BenchOpCount
+} bench_op_t;
+
+static const char *op_names[] = {
+    "insert", "lookup", "lookup_miss", "iterate", "remove"
+};
+
+/* Payload with the size of a table record */
+typedef struct bench_elem_t {
+    void *ptr;
+    int32_t value;
+    int32_t count;
+} bench_elem_t;
+
+static uint64_t rng_state = SEED;
+
+static
+uint64_t rng_next(void) {
+    uint64_t x = rng_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rng_state = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+/* Sequential keys are typical for table ids and component ids. Random keys
+ * resemble pairs, which have the relation in the upper 32 bits. */
+static
+void fill_keys(
+    ecs_map_key_t *keys,
+    ecs_map_key_t *missing,
+    int32_t count,
+    bool sequential)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        if (sequential) {
+            keys[i] = (ecs_map_key_t)(1000 + i);
+            missing[i] = (ecs_map_key_t)(1000 + count + i);
+        } else {
+            keys[i] = rng_next() | 1;
+            missing[i] = rng_next() & ~(uint64_t)1;
+        }
+    }
+}
+
+static
+void* flat_new(
+    ecs_size_t elem_size,
+    int32_t count)
+{
+    return _ecs_map_new(elem_size, ECS_ALIGNOF(bench_elem_t), count);
+}
+
+static
+void* flat_get(
+    const ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    return _ecs_map_get(map, ECS_SIZEOF(bench_elem_t), key);
+}
+
+static
+void* flat_ensure(
+    ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    return _ecs_map_ensure(map, ECS_SIZEOF(bench_elem_t), key);
+}
+
+static
+void* flat_next(
+    ecs_map_iter_t *it,
+    ecs_map_key_t *key)
+{
+    return _ecs_map_next(it, ECS_SIZEOF(bench_elem_t), key);
+}
+
+/* Generates a function that runs all operations for one map implementation.
+ * The operations are expanded inline so that both implementations are
+ * measured without the overhead of an indirect call. */
+#define BENCH_MAP(name, map_t, iter_t, map_new, map_free, map_get,\
+    map_ensure, map_remove, map_iter, map_next)\
+static \
+int64_t name(\
+    const ecs_map_key_t *keys,\
+    const ecs_map_key_t *missing,\
+    int32_t count,\
+    int32_t repeat,\
+    double *t)\
+{\
+    int64_t sum = 0;\
+    int32_t r, i;\
+    for (r = 0; r < repeat; r ++) {\
+        ecs_time_t start;\
+        map_t *map = map_new(ECS_SIZEOF(bench_elem_t), 0);\
+        ecs_os_get_time(&start);\
+        for (i = 0; i < count; i ++) {\
+            bench_elem_t *elem = map_ensure(map, keys[i]);\
+            elem->value = i;\
+        }\
+        t[BenchInsert] += ecs_time_measure(&start);\
+        for (i = 0; i < count; i ++) {\
+            bench_elem_t *elem = map_get(map, keys[i]);\
+            sum += elem->value;\
+        }\
+        t[BenchLookup] += ecs_time_measure(&start);\
+        for (i = 0; i < count; i ++) {\
+            sum += map_get(map, missing[i]) != NULL;\
+        }\
+        t[BenchLookupMiss] += ecs_time_measure(&start);\
+        iter_t it = map_iter(map);\
+        bench_elem_t *elem;\
+        while ((elem = map_next(&it, NULL))) {\
+            sum += elem->value;\
+        }\
+        t[BenchIterate] += ecs_time_measure(&start);\
+        for (i = 0; i < count; i ++) {\
+            map_remove(map, keys[i]);\
+        }\
+        t[BenchRemove] += ecs_time_measure(&start);\
+        map_free(map);\
+    }\
+    return sum;\
+}
+
+BENCH_MAP(bench_flat, ecs_map_t, ecs_map_iter_t, flat_new, ecs_map_free,
+    flat_get, flat_ensure, ecs_map_remove, ecs_map_iter, flat_next)
+
+BENCH_MAP(bench_chained, chained_map_t, chained_map_iter_t, chained_map_new,
+    chained_map_free, chained_map_get, chained_map_ensure, chained_map_remove,
+    chained_map_iter, chained_map_next)
+
+static
+void run(
+    int32_t count,
+    bool sequential)
+{
+    ecs_map_key_t *keys = ecs_os_malloc(ECS_SIZEOF(ecs_map_key_t) * count);
+    ecs_map_key_t *missing = ecs_os_malloc(ECS_SIZEOF(ecs_map_key_t) * count);
+    fill_keys(keys, missing, count, sequential);
+
+    int32_t repeat = OPS_PER_SIZE / count;
+    double flat[BenchOpCount] = {0}, chained[BenchOpCount] = {0};
+
+    int64_t sum_flat = bench_flat(keys, missing, count, repeat, flat);
+    int64_t sum_chained = bench_chained(keys, missing, count, repeat, chained);
+    ecs_assert(sum_flat == sum_chained, ECS_INTERNAL_ERROR, NULL);
+    (void)sum_flat;
+    (void)sum_chained;
+
+    int32_t op;
+    double ops = (double)count * (double)repeat;
+    for (op = 0; op < BenchOpCount; op ++) {
+        double ns_flat = flat[op] * 1e9 / ops;
+        double ns_chained = chained[op] * 1e9 / ops;
+        printf("%-12s %-11s %8d %10.2f %10.2f %8.2fx\n", op_names[op],
+            sequential ? "sequential" : "random", count, ns_flat, ns_chained,
+            ns_chained / ns_flat);
+    }
+
+    ecs_os_free(keys);
+    ecs_os_free(missing);
+}
+
+int main(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+
+    ecs_os_set_api_defaults();
+
+    int32_t sizes[] = {4, 64, 1024, 65536, 1048576};
+    int32_t i, size_count = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("%-12s %-11s %8s %10s %10s %9s\n", "op", "keys", "count",
+        "flat ns", "chained ns", "speedup");
+
+    for (i = 0; i < size_count; i ++) {
+        run(sizes[i], true);
+        run(sizes[i], false);
+    }
+
+    return 0;
+}
@@ -381,7 +381,12 @@ typedef struct ecs_entity_desc_t {
 typedef struct ecs_component_desc_t {
     ecs_entity_desc_t entity;           /* Parameters for component entity */
     size_t size;                        /* Component size */
-    size_t alignment;                   /* Component alignment */
+
+    /* Component alignment. Must be a power of two. Can be larger than the
+     * natural alignment of the type, for example to align component arrays
+     * to a cache line. Component arrays are padded to a multiple of the
+     * alignment. */
+    size_t alignment;
 } ecs_component_desc_t;
 
 
@@ -1156,6 +1161,49 @@ bool ecs_enable_range_check(
     ecs_world_t *world,
     bool enable);
 
+/** Enable automatic deletion of empty tables.
+ * Applications that add and remove many different combinations of components
+ * can end up with a large number of tables that are empty. Empty tables use
+ * memory and are still matched with queries. When table GC is enabled, tables
+ * that have been empty for more than the specified number of frames are deleted
+ * at the end of a frame. Tables that use much less storage than they have
+ * allocated are shrunk.
+ *
+ * Tables that are used as ecs_type_t, for example with ECS_TYPE or the type
+ * API, and tables with builtin components are not deleted. Tables are also not 
+ * deleted while snapshots are alive. Applications should not hold on to table
+ * pointers across frames when table GC is enabled.
+ *
+ * Table GC is disabled by default.
+ *
+ * @param world The world.
+ * @param empty_frames The number of frames after which an empty table is
+ *        deleted, or 0 to disable table GC.
+ */
+FLECS_API
+void ecs_set_table_gc(
+    ecs_world_t *world,
+    int32_t empty_frames);
+
+/** Delete empty tables and shrink table storage.
+ * This operation performs a single table GC pass, as is done at the end of a
+ * frame when table GC is enabled. Each time a table is empty during a pass, its
+ * empty count is increased. If the count is larger than empty_frames, the table
+ * is deleted. When empty_frames is 0, all empty tables are deleted. 
+ *
+ * This operation can be used by applications that do not use ecs_progress,
+ * and may not be called while the world is in readonly mode.
+ *
+ * @param world The world.
+ * @param empty_frames The number of passes a table must be empty before it is
+ *        deleted.
+ * @return The number of deleted tables.
+ */
+FLECS_API
+int32_t ecs_delete_empty_tables(
+    ecs_world_t *world,
+    int32_t empty_frames);
+
 /** Enable world locking while in progress.
  * When locking is enabled, Flecs will lock the world while in progress. This
  * allows applications to interact with the world from other threads without
@@ -3329,6 +3377,27 @@ void* ecs_term_w_size(
 #define ecs_term(it, T, index)\
     ((T*)ecs_term_w_size(it, sizeof(T), index))
 
+/** Obtain data for the first count terms of a query.
+ * This operation is equivalent to calling ecs_term_w_size for the terms 1 to
+ * count, but resolves all terms in a single call. This reduces the overhead
+ * per iterated table for code that knows the query terms in advance, such as
+ * the C++ each function.
+ *
+ * The sizes array may be NULL, in which case sizes are not checked.
+ *
+ * @param it The iterator.
+ * @param count The number of terms to obtain data for.
+ * @param sizes The sizes of the datatypes of the returned arrays.
+ * @param ptrs_out Array that will be populated with a pointer for each term.
+ * @return True if one or more terms are not owned, false if all are owned.
+ */
+FLECS_API
+bool ecs_terms_w_size(
+    const ecs_iter_t *it,
+    int32_t count,
+    const size_t *sizes,
+    void **ptrs_out);
+
 /** Obtain the component/pair id for a term.
  * This operation retrieves the id for the specified query term. Typically this
  * is the component id, but it can also be a pair id or a role annotated id,
@@ -3620,6 +3689,26 @@ FLECS_API
 bool ecs_defer_end(
     ecs_world_t *world);
 
+/** Enable or disable batching of deferred operations.
+ * By default deferred operations are executed one by one when they are 
+ * flushed. When batching is enabled, consecutive add and remove operations are
+ * grouped by entity, so that an entity moves to its final table only once.
+ * Entities that move between the same tables are then moved together, and
+ * OnAdd triggers and monitors are invoked once for all of them.
+ *
+ * With batching enabled, add and remove operations for different entities may
+ * be executed in a different order than they were enqueued in, and an add and
+ * remove of the same component for an entity cancel each other out. Operations
+ * other than add and remove are never reordered.
+ *
+ * @param world The world.
+ * @param enable Whether to enable batching.
+ */
+FLECS_API
+void ecs_set_defer_batching(
+    ecs_world_t *world,
+    bool enable);
+
 /** Enable/disable automerging for world or stage.
  * When automerging is enabled, staged data will automatically be merged with
  * the world when staging ends. This happens at the end of progress(), at a
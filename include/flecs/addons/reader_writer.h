@@ -7,6 +7,10 @@
  * API. The reader reads from a world and serializes it to N fixed-size buffers.
  * The writer reads from N fixed-size buffers and writes to the world.
  *
+ * The addon also contains a table-oriented blob format, which stores the world
+ * in a single buffer with aligned columns. This format can be stored in a file
+ * that is mapped into memory, and is loaded with one copy per column.
+ *
  * The current limitations of the serializer are:
  * - only POD types
  * - no support for switch types and component enabling/disabling
@@ -215,6 +219,88 @@ int32_t ecs_writer_write(
     int32_t size,
     ecs_writer_t *writer);
 
+/** Identifies a table-oriented blob. */
+#define ECS_BLOB_MAGIC (0x424C4546)
+
+/** Version of the table-oriented blob format. */
+#define ECS_BLOB_VERSION (1)
+
+/** Column stores offsets to entity names instead of EcsName values. */
+#define ECS_BLOB_COLUMN_NAME (1)
+
+/** Header of a table-oriented blob. 
+ * Offsets are relative to the start of the blob. Column data is aligned to the
+ * alignment of the component relative to the start of the blob, so that if the
+ * blob is mapped to an address with page alignment, the data is aligned. */
+typedef struct ecs_blob_header_t {
+    uint32_t magic;             /**< Must be ECS_BLOB_MAGIC */
+    uint32_t version;           /**< Must be ECS_BLOB_VERSION */
+    uint64_t size;              /**< Size of the blob in bytes */
+    uint64_t tables;            /**< Offset to array with ecs_blob_table_t */
+    uint32_t table_count;       /**< Number of tables */
+    uint32_t reserved;
+} ecs_blob_header_t;
+
+/** Table in a table-oriented blob. */
+typedef struct ecs_blob_table_t {
+    uint64_t type;              /**< Offset to array with ids of the type */
+    uint64_t columns;           /**< Offset to array with ecs_blob_column_t */
+    uint32_t type_count;        /**< Number of ids in type */
+    uint32_t column_count;      /**< Number of columns, including entities */
+    uint32_t row_count;         /**< Number of entities in table */
+    uint32_t reserved;
+} ecs_blob_table_t;
+
+/** Column in a table-oriented blob. The first column stores the entities. */
+typedef struct ecs_blob_column_t {
+    uint64_t data;              /**< Offset to column data */
+    uint32_t size;              /**< Size of element, 0 if column has no data */
+    uint16_t alignment;         /**< Alignment of element */
+    uint16_t flags;             /**< Column flags (ECS_BLOB_COLUMN_*) */
+} ecs_blob_column_t;
+
+/** Serialize a world to a table-oriented blob.
+ * This operation serializes the world to a single buffer. If buffer is NULL,
+ * or if size is smaller than the size of the blob, nothing is written. This 
+ * allows an application to first obtain the size of the blob, and then to 
+ * serialize the world into a buffer of that size, such as a file that is
+ * mapped into memory. The world must not change between the two calls.
+ *
+ * @param world The world to serialize.
+ * @param buffer The buffer to serialize to (optional).
+ * @param size The size of the buffer.
+ * @return The size of the blob.
+ */
+FLECS_API
+size_t ecs_world_to_blob(
+    ecs_world_t *world,
+    void *buffer,
+    size_t size);
+
+/** Deserialize a table-oriented blob into a world.
+ * This operation restores the entities in a blob created by ecs_world_to_blob
+ * into a world. The same compatibility rules as for ecs_writer_init apply.
+ *
+ * The blob is validated before the world is modified. The operation fails if
+ * the blob has a different version, or if it is corrupt. It also fails if the
+ * size of a serialized component does not match its size in the world, in 
+ * which case the tables that precede the table with the mismatch are already
+ * restored.
+ *
+ * The operation does not hold on to the buffer, which can be released after
+ * the operation returns.
+ *
+ * @param world The world in which to deserialize the blob.
+ * @param buffer The blob.
+ * @param size The size of the blob.
+ * @return Zero if success, non-zero if failed to deserialize.
+ */
+FLECS_API
+int ecs_world_from_blob(
+    ecs_world_t *world,
+    const void *buffer,
+    size_t size);
+
 #ifdef __cplusplus
 }
 #endif     
@@ -33,6 +33,27 @@ FLECS_API
 ecs_snapshot_t* ecs_snapshot_take(
     ecs_world_t *world);
 
+/** Create an incremental snapshot.
+ * This operation is the same as ecs_snapshot_take, but shares the component
+ * data that did not change since the previous snapshot was taken with the 
+ * previous snapshot, instead of copying it. Both snapshots can be restored or
+ * freed independently from each other.
+ *
+ * Changes are detected with the same mechanism as ecs_query_changed. Changes
+ * that are not communicated to the world, such as writing to a component 
+ * obtained with ecs_get_mut without calling ecs_modified, or writing to a
+ * component while iterating a filter, are not detected. When an incremental
+ * snapshot is restored, tables that did not change are left as is.
+ *
+ * @param world The world to snapshot.
+ * @param prev The previous snapshot (optional).
+ * @param return The snapshot.
+ */
+FLECS_API
+ecs_snapshot_t* ecs_snapshot_take_incremental(
+    ecs_world_t *world,
+    const ecs_snapshot_t *prev);
+
 /** Create a filtered snapshot.
  * This operation is the same as ecs_snapshot_take, but accepts an iterator so
  * an application can control what is stored by the snapshot. 
@@ -57,6 +78,9 @@ ecs_snapshot_t* ecs_snapshot_take_w_iter(
  * The world in which the snapshot is restored must be the same as the world in
  * which the snapshot is taken.
  *
+ * If the snapshot was created with ecs_snapshot_take_incremental, tables that
+ * did not change since the snapshot was taken are not restored.
+ *
  * @param world The world to restore the snapshot to.
  * @param snapshot The snapshot to restore. 
  */
@@ -93,6 +117,102 @@ bool ecs_snapshot_next(
 FLECS_API
 void ecs_snapshot_free(
     ecs_snapshot_t *snapshot);
+
+/** Entity that was created, or that moved to another table. */
+typedef struct ecs_snapshot_diff_entity_t {
+    ecs_entity_t entity;        /**< The entity */
+    ecs_type_t type;            /**< Type of the entity after the change */
+} ecs_snapshot_diff_entity_t;
+
+/** Range of entities in a table for which the value of a component changed. */
+typedef struct ecs_snapshot_diff_range_t {
+    ecs_entity_t component;     /**< The component that changed */
+    ecs_size_t size;            /**< Size of the component */
+    int32_t count;              /**< Number of entities in the range */
+    bool is_set;                /**< If true, there is no previous value */
+    ecs_entity_t *entities;     /**< Entities in the range */
+    void *delta;                /**< New values XOR'd with previous values */
+} ecs_snapshot_diff_range_t;
+
+/** Difference between two states of a world. */
+typedef struct ecs_snapshot_diff_t {
+    ecs_vector_t *deleted;      /**< Deleted entities (ecs_entity_t) */
+    ecs_vector_t *created;      /**< Created entities (ecs_snapshot_diff_entity_t) */
+    ecs_vector_t *moved;        /**< Moved entities (ecs_snapshot_diff_entity_t) */
+    ecs_vector_t *changed;      /**< Changed values (ecs_snapshot_diff_range_t) */
+    ecs_vector_t *range_entities; /**< Storage for entities of ranges */
+    ecs_vector_t *range_data;     /**< Storage for deltas of ranges */
+} ecs_snapshot_diff_t;
+
+/** Compute the difference between two snapshots.
+ * This operation computes which entities were deleted, created and moved to
+ * another table between the two snapshots, and which component values changed.
+ * If to is NULL, the difference between the snapshot and the current state of
+ * the world is computed. Neither snapshot can be filtered.
+ *
+ * Changed values are stored as ranges of entities in the same table. For each
+ * entity, the range stores the new value XOR'd with the previous value, so that
+ * the unchanged bytes of a value are zero. If the entity did not have the 
+ * component before, the delta is the new value.
+ *
+ * Values are compared bytewise. Entities in tables with builtin components are
+ * not included, as they are not stored in snapshots. Components that have a
+ * copy action are not included, as their values can't be compared bytewise.
+ *
+ * @param from The snapshot with the previous state.
+ * @param to The snapshot with the new state, or NULL for the world.
+ * @return The difference between the two states.
+ */
+FLECS_API
+ecs_snapshot_diff_t* ecs_snapshot_diff(
+    const ecs_snapshot_t *from,
+    const ecs_snapshot_t *to);
+
+/** Encode a diff.
+ * This operation serializes a diff into a compact buffer. Integers are stored
+ * as variable length integers, and deltas are run-length encoded, so that the
+ * size of the buffer is proportional to the number of bytes that changed.
+ *
+ * The returned buffer must be freed with ecs_os_free.
+ *
+ * @param diff The diff to encode.
+ * @param size_out Output parameter for the size of the buffer.
+ * @return The encoded diff.
+ */
+FLECS_API
+void* ecs_snapshot_diff_encode(
+    const ecs_snapshot_diff_t *diff,
+    ecs_size_t *size_out);
+
+/** Apply an encoded diff to a world.
+ * This operation deletes, creates and moves entities, and updates component 
+ * values, so that a world in the previous state of the diff ends up in the new
+ * state of the diff. Values are updated with ecs_get_mut and ecs_modified, so
+ * that OnSet systems and change detection work as usual.
+ *
+ * The world does not have to be the world in which the diff was computed, as 
+ * long as entity and component ids are the same in both worlds. The diff is 
+ * validated before it is applied. If the diff is malformed, the world is not
+ * modified.
+ *
+ * @param world The world to apply the diff to.
+ * @param data The encoded diff.
+ * @param size The size of the encoded diff.
+ * @return Zero if success, non-zero if the diff is malformed.
+ */
+FLECS_API
+int ecs_snapshot_diff_apply(
+    ecs_world_t *world,
+    const void *data,
+    ecs_size_t size);
+
+/** Free diff resources.
+ *
+ * @param diff The diff to free.
+ */
+FLECS_API
+void ecs_snapshot_diff_free(
+    ecs_snapshot_diff_t *diff);
     
 #ifdef __cplusplus
 }
@@ -47,6 +47,7 @@ typedef struct ecs_world_stats_t {
     ecs_gauge_t singleton_table_count;        /**< Number of singleton tables. Singleton tables are tables with just a single entity that contains itself */
     ecs_gauge_t matched_entity_count;         /**< Number of entities matched by queries */
     ecs_gauge_t matched_table_count;          /**< Number of tables matched by queries */
+    ecs_gauge_t table_edge_memory;            /**< Memory allocated for table graph edges, in bytes */
 
     /* Deferred operations */
     ecs_counter_t new_count;
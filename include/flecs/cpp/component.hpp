@@ -207,7 +207,7 @@ public:
         if (size(allow_tag) == 0) {
             return 0;
         } else {
-            return alignof(T);
+            return column_alignment<T>::value;
         }        
     }
 };
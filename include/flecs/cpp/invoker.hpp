@@ -22,50 +22,51 @@ public:
     using array = flecs::array<_::term_ptr, sizeof...(Components)>;
 
     void populate(const ecs_iter_t *iter) {
-        populate(iter, 0, static_cast<
-            remove_reference_t<
-                remove_pointer_t<Components>>
-                    *>(nullptr)...);
+        populate_ptrs(iter, false);
     }
 
     bool populate_w_refs(const ecs_iter_t *iter) {
-        if (iter->table->references) {
-            populate_w_refs(iter, 0, static_cast<
-                remove_reference_t<
-                    remove_pointer_t<Components>>
-                        *>(nullptr)...);
-            return true;
-        } else {
-            this->populate(iter);
-            return false;
-        }
+        return populate_ptrs(iter, true);
     }
 
     array m_terms;
 
 private:
-    /* Populate terms array without checking for references */
-    void populate(const ecs_iter_t*, size_t) { }
-
-    template <typename T, typename... Targs>
-    void populate(const ecs_iter_t *iter, size_t index, T, Targs... comps) {
-        int32_t term = static_cast<int32_t>(index + 1);
-        void *ptr = ecs_term_w_size(iter, sizeof(actual_type_t<remove_pointer_t<T>>), term);
-        m_terms[index].ptr = ptr;
-        populate(iter, index + 1, comps ...);
+    /* Obtain pointers for all terms with a single call. Returns whether one or
+     * more terms are references. If w_refs is true and the table has references,
+     * is_ref is set for each term. */
+    template <size_t Count = sizeof...(Components), if_t< Count != 0 > = 0>
+    bool populate_ptrs(const ecs_iter_t *iter, bool w_refs) {
+        flecs::array<size_t, Count> sizes ({
+            sizeof(actual_type_t< 
+                remove_reference_t< 
+                    remove_pointer_t<Components>>>)...
+        });
+
+        flecs::array<void*, Count> ptrs;
+        bool has_refs = ecs_terms_w_size(iter, 
+            static_cast<int32_t>(Count), sizes.ptr(), ptrs.ptr());
+
+        for (size_t i = 0; i < Count; i ++) {
+            m_terms[i].ptr = ptrs[i];
+            m_terms[i].is_ref = false;
+        }
+
+        if (has_refs && w_refs) {
+            for (size_t i = 0; i < Count; i ++) {
+                int32_t term = static_cast<int32_t>(i + 1);
+                m_terms[i].is_ref = !ecs_term_is_owned(iter, term) && 
+                    m_terms[i].ptr != nullptr;
+            }
+        }
+
+        return has_refs;
     }
 
-    /* Populate terms array, check for references */
-    void populate_w_refs(const ecs_iter_t*, size_t) { }
-
-    template <typename T, typename... Targs>
-    void populate_w_refs(const ecs_iter_t *iter, size_t index, T, Targs... comps) {
-        int32_t term = static_cast<int32_t>(index + 1);
-        void *ptr = ecs_term_w_size(iter, sizeof(actual_type_t<remove_pointer_t<T>>), term);
-        m_terms[index].ptr = ptr;
-        m_terms[index].is_ref = !ecs_term_is_owned(iter, term) && ptr != nullptr;
-        populate_w_refs(iter, index + 1, comps ...);
-    }   
+    template <size_t Count = sizeof...(Components), if_t< Count == 0 > = 0>
+    bool populate_ptrs(const ecs_iter_t*, bool) {
+        return false;
+    }
 };    
 
 class invoker { };
@@ -209,9 +210,14 @@ private:
         }
 #endif
 
-        flecs::iter it(iter);
-        for (auto row : it) {
-            func(it.entity(row),
+        // Entity handles only differ in their id, so resolve the world once
+        // instead of per row.
+        flecs::world_t *world = iter->world;
+        const flecs::entity_t *entities = iter->entities;
+        size_t count = static_cast<size_t>(iter->count);
+
+        for (size_t row = 0; row < count; row ++) {
+            func(flecs::entity(world, entities[row]),
                 (ColumnType< remove_reference_t<Components> >(comps, row)
                     .get_row())...);
         }
@@ -230,8 +236,8 @@ private:
     static void invoke_callback(
         ecs_iter_t *iter, const Func& func, size_t, Terms&, Args... comps) 
     {
-        flecs::iter it(iter);
-        for (auto row : it) {
+        size_t count = static_cast<size_t>(iter->count);
+        for (size_t row = 0; row < count; row ++) {
             func( (ColumnType< remove_reference_t<Components> >(comps, row)
                 .get_row())...);
         }
@@ -388,6 +394,173 @@ private:
     Func m_func;
 };
 
+
+////////////////////////////////////////////////////////////////////////////////
+//// Utility class to invoke a callback for fixed size batches of rows
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+struct is_span : std::false_type { };
+
+template <typename T>
+struct is_span< flecs::span<T> > : std::true_type { };
+
+template <bool ... Values>
+struct all_true : std::true_type { };
+
+template <bool ... Values>
+struct all_true<false, Values...> : std::false_type { };
+
+template <bool ... Values>
+struct all_true<true, Values...> : all_true<Values...> { };
+
+// Template that figures out from the argument type of the batch callback how
+// to pass the term to the callback. The argument type determines whether the
+// term is expected to be owned or shared.
+template <typename T, typename = int>
+struct batch_arg { };
+
+// If argument is a span, the term must be owned and is passed as a range of
+// the component array.
+template <typename T>
+struct batch_arg<T, if_t< is_span< decay_t<T> >::value > > {
+    using span_type = decay_t<T>;
+    using value_type = typename span_type::value_type;
+    static constexpr bool is_shared = false;
+
+    static span_type get(const _::term_ptr& term, size_t offset, size_t count) {
+        return span_type(static_cast<value_type*>(term.ptr) + offset, count);
+    }
+};
+
+// If argument is not a span, the term must be shared and is passed as a single
+// value that applies to all rows in the batch.
+template <typename T>
+struct batch_arg<T, if_t< !is_span< decay_t<T> >::value > > {
+    using value_type = remove_reference_t<T>;
+    static constexpr bool is_shared = true;
+
+    static value_type& get(const _::term_ptr& term, size_t, size_t) {
+        return *static_cast<value_type*>(term.ptr);
+    }
+};
+
+template <size_t N, typename Func, typename ArgList, typename ComponentList>
+class batch_invoker_impl;
+
+template <size_t N, typename Func, typename Count, typename ... Args,
+    typename ... Components>
+class batch_invoker_impl<N, Func,
+    arg_list<Count, Args...>, arg_list<Components...> >
+{
+    static_assert(sizeof...(Args) == sizeof...(Components),
+        "iter_batches() callback must have a count and one argument per term");
+
+    static_assert(all_true< std::is_same<
+        typename std::remove_const<
+            typename batch_arg<Args>::value_type >::type,
+        typename std::remove_const<
+            actual_type_t< remove_reference_t<Components> > >::type
+        >::value... >::value,
+        "iter_batches() argument types must match the query terms");
+
+    static_assert(all_true<
+        (!std::is_const< remove_reference_t<Components> >::value ||
+            std::is_const< typename batch_arg<Args>::value_type >::value)...
+        >::value,
+        "iter_batches() argument for a const term must be const");
+
+    using Terms = typename term_ptrs<Components ...>::array;
+
+public:
+    static void invoke(ecs_iter_t *iter, const Func& func) {
+        term_ptrs<Components...> terms;
+        terms.populate_w_refs(iter);
+
+#ifndef NDEBUG
+        const bool is_shared[] = { batch_arg<Args>::is_shared... };
+        for (size_t i = 0; i < sizeof...(Components); i ++) {
+            ecs_assert(terms.m_terms[i].ptr != nullptr,
+                ECS_INVALID_PARAMETER, "iter_batches() term has no data");
+            ecs_assert(terms.m_terms[i].is_ref == is_shared[i],
+                ECS_INVALID_PARAMETER, is_shared[i]
+                    ? "iter_batches() term is owned, expected span"
+                    : "iter_batches() term is shared, expected value");
+        }
+#endif
+
+        invoke_callback(iter, func, 0, terms.m_terms);
+    }
+
+private:
+    template <typename... Targs,
+        if_t< sizeof...(Targs) == sizeof...(Components) > = 0>
+    static void invoke_callback(
+        ecs_iter_t *iter, const Func& func, size_t, Terms&, Targs... comps)
+    {
+#ifndef NDEBUG
+        ecs_table_t *table = nullptr;
+        if (iter->table) {
+            table = iter->table->table;
+            if (table) {
+                ecs_table_lock(iter->world, table);
+            }
+        }
+#endif
+
+        size_t count = static_cast<size_t>(iter->count);
+        size_t offset = 0;
+
+        for (; count - offset >= N; offset += N) {
+            func(N, batch_arg<Args>::get(comps, offset, N)...);
+        }
+
+        // Remainder of the table. Elements beyond the remainder are not part
+        // of the batch, even if the storage of the column is padded.
+        if (offset != count) {
+            size_t remaining = count - offset;
+            func(remaining, batch_arg<Args>::get(comps, offset, remaining)...);
+        }
+
+#ifndef NDEBUG
+        if (table) {
+            ecs_table_unlock(iter->world, table);
+        }
+#endif
+    }
+
+    template <typename... Targs,
+        if_t< sizeof...(Targs) != sizeof...(Components) > = 0>
+    static void invoke_callback(ecs_iter_t *iter, const Func& func,
+        size_t index, Terms& columns, Targs... comps)
+    {
+        invoke_callback(iter, func, index + 1, columns, comps...,
+            columns[index]);
+    }
+};
+
+template <size_t N, typename Func, typename ... Components>
+class batch_invoker : public invoker {
+    static_assert(N != 0, "batch size must be larger than 0");
+
+    static_assert(sizeof...(Components) != 0,
+        "iter_batches() requires a query with at least one term");
+
+    using Impl = batch_invoker_impl<N, Func,
+        arg_list_t<Func>, arg_list<Components...> >;
+
+public:
+    explicit batch_invoker(const Func& func) noexcept
+        : m_func(func) { }
+
+    void invoke(ecs_iter_t *iter) const {
+        Impl::invoke(iter, m_func);
+    }
+
+private:
+    const Func& m_func;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Utility to invoke callback on entity if it has components in signature
 ////////////////////////////////////////////////////////////////////////////////
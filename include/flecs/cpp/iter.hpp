@@ -51,6 +51,30 @@ protected:
     bool m_is_shared;        
 };
 
+/** Alignment of the component arrays of a type.
+ * Component arrays start at a multiple of this alignment, and their storage is
+ * padded to a multiple of it. By default this is the alignment of the type.
+ * Specialize this template to use a larger alignment, for example to allow
+ * SIMD kernels to use aligned loads:
+ *
+ * namespace flecs {
+ *   template <>
+ *   struct column_alignment<Position> 
+ *       : std::integral_constant<size_t, 64> { };
+ * }
+ *
+ * The specialization must be visible wherever the component is registered.
+ *
+ * @tparam T component type.
+ */
+template <typename T>
+struct column_alignment : std::integral_constant<size_t, alignof(T)> { 
+    static_assert(!(column_alignment::value & (column_alignment::value - 1)),
+        "column alignment must be a power of two");
+    static_assert(column_alignment::value >= alignof(T),
+        "column alignment cannot be smaller than the alignment of the type");
+};
+
 /** Wrapper class around a column.
  * 
  * @tparam T component type of the column.
@@ -139,12 +163,132 @@ public:
         return !m_is_shared;
     }    
 
+    /** Return the alignment of the component array.
+     * 
+     * @return The column alignment of the component type.
+     */
+    static constexpr size_t alignment() {
+        return column_alignment< decay_t<T> >::value;
+    }
+
+    /** Return whether the component array is aligned.
+     * The component array is aligned when the iterated range starts at the
+     * beginning of a table. An iterator that skips rows, for example because
+     * of disabled components, can return arrays that are not aligned.
+     * 
+     * @return True if the array starts at a multiple of alignment().
+     */
+    bool is_aligned() const {
+        return !(reinterpret_cast<uintptr_t>(m_array) & (alignment() - 1));
+    }
+
+    /** Return the number of elements that can be accessed.
+     * The storage of an aligned component array is padded to a multiple of the
+     * alignment, which allows for processing the last elements of the array as
+     * a full block. Elements beyond count() are not initialized and must not 
+     * be interpreted as components. This function may only be used when the
+     * array is aligned.
+     * 
+     * @return The number of elements in the padded array.
+     */
+    size_t padded_count() const {
+        ecs_assert(is_aligned(), ECS_INVALID_OPERATION, NULL);
+        size_t size = m_count * sizeof(T);
+        size = (size + alignment() - 1) & ~(alignment() - 1);
+        return size / sizeof(T);
+    }
+
+    /** Return the number of elements in the component array.
+     * 
+     * @return The number of elements.
+     */
+    size_t count() const {
+        return m_count;
+    }
+
 protected:
     T* m_array;
     size_t m_count;
     bool m_is_shared;
 };
 
+/** Contiguous range of owned component values.
+ * Spans are passed to the callback of query::iter_batches, and only ever
+ * point to owned components. A batch starts at a multiple of alignment() when
+ * the table column is aligned and the batch size times the size of the type is
+ * a multiple of alignment().
+ *
+ * @tparam T component type of the span.
+ */
+template <typename T>
+class span {
+public:
+    using value_type = T;
+
+    /** Create span from component array.
+     *
+     * @param array Pointer to the first element.
+     * @param count Number of elements in the span.
+     */
+    span(T* array, size_t count)
+        : m_array(array)
+        , m_count(count) {}
+
+    /** Return element in span.
+     *
+     * @param index Index of element.
+     * @return Reference to element.
+     */
+    T& operator[](size_t index) const {
+        ecs_assert(index < m_count, ECS_COLUMN_INDEX_OUT_OF_RANGE, NULL);
+        return m_array[index];
+    }
+
+    /** Return pointer to the first element.
+     *
+     * @return Pointer to the first element.
+     */
+    T* data() const {
+        return m_array;
+    }
+
+    /** Return the number of elements in the span.
+     *
+     * @return The number of elements.
+     */
+    size_t size() const {
+        return m_count;
+    }
+
+    T* begin() const {
+        return m_array;
+    }
+
+    T* end() const {
+        return m_array + m_count;
+    }
+
+    /** Return the alignment of the component array.
+     *
+     * @return The column alignment of the component type.
+     */
+    static constexpr size_t alignment() {
+        return column_alignment< decay_t<T> >::value;
+    }
+
+    /** Return whether the span is aligned.
+     *
+     * @return True if the span starts at a multiple of alignment().
+     */
+    bool is_aligned() const {
+        return !(reinterpret_cast<uintptr_t>(m_array) & (alignment() - 1));
+    }
+
+private:
+    T* m_array;
+    size_t m_count;
+};
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
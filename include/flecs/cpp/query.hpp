@@ -237,6 +237,32 @@ public:
             ecs_query_next_worker, stage_current, stage_count);
     }
 
+    /** Iterate matched entities in batches of N rows.
+     * The callback is invoked for each full batch of N rows, and once for the
+     * remaining rows of each matched table. Its first argument is the number
+     * of rows in the batch, followed by an argument for each term:
+     *
+     *   q.iter_batches<8>([](size_t count, flecs::span<Position> p, 
+     *       const Velocity& v) { ... });
+     *
+     * Owned terms are passed as a flecs::span, shared terms are passed as a
+     * single value that applies to all rows. Whether a term is expected to be
+     * owned or shared is determined by the argument type. Iterating a table
+     * that does not match this expectation is an error, as is iterating a
+     * table with an optional term that is not set.
+     *
+     * @tparam N Number of rows in a full batch.
+     * @param func The callback to invoke for each batch.
+     */
+    template <size_t N, typename Func>
+    void iter_batches(Func&& func) const {
+        ecs_iter_t it = ecs_query_iter(m_query);
+        while (ecs_query_next(&it)) {
+            _::batch_invoker<N, decay_t<Func>, Components...>(func)
+                .invoke(&it);
+        }
+    }
+
     template <typename Func>
     ECS_DEPRECATED("use each or iter")
     void action(Func&& func) const {
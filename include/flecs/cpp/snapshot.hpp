@@ -58,6 +58,18 @@ public:
             &it, ecs_filter_next);
     }
 
+    void take_incremental(const snapshot& prev) {
+        ecs_assert(m_world.c_ptr() == prev.m_world.c_ptr(), ECS_INVALID_PARAMETER, NULL);
+        ecs_assert(this != &prev, ECS_INVALID_PARAMETER, NULL);
+
+        if (m_snapshot) {
+            ecs_snapshot_free(m_snapshot);
+        }
+
+        m_snapshot = ecs_snapshot_take_incremental(
+            m_world.c_ptr(), prev.m_snapshot);
+    }
+
     void restore() {
         if (m_snapshot) {
             ecs_snapshot_restore(m_world.c_ptr(), m_snapshot);
@@ -302,6 +302,16 @@ public:
         return ecs_is_deferred(m_world);
     }
 
+    /** Enable or disable batching of deferred operations.
+     * When enabled, deferred add and remove operations are grouped by entity
+     * and by table, so that entities are moved to their final table at once.
+     *
+     * @param enable Whether to enable batching.
+     */
+    void set_defer_batching(bool enable = true) const {
+        ecs_set_defer_batching(m_world, enable);
+    }
+
     /** Configure world to have N stages.
      * This initializes N stages, which allows applications to defer operations to
      * multiple isolated defer queues. This is typically used for applications with
@@ -450,6 +460,26 @@ public:
         return ecs_get_threads(m_world);
     }
 
+    /** Enable or disable work stealing.
+     * When enabled, matched tables are cut into jobs that idle threads can
+     * steal from busy threads.
+     *
+     * @param enable Whether to enable work stealing.
+     */
+    void set_work_stealing(bool enable = true) const {
+        ecs_set_work_stealing(m_world, enable);
+    }
+
+    /** Enable or disable parallel systems.
+     * When enabled, systems that don't conflict with each other run in 
+     * parallel on different threads.
+     *
+     * @param enable Whether to enable parallel systems.
+     */
+    void set_parallel_systems(bool enable = true) const {
+        ecs_set_parallel_systems(m_world, enable);
+    }
+
     /** Get index of current thread.
      *
      * @return Unique index for current thread.
@@ -564,6 +594,25 @@ public:
         ecs_enable_range_check(m_world, enabled);
     }
 
+    /** Enable automatic deletion of empty tables.
+     * Tables that have been empty for more than the specified number of frames
+     * are deleted at the end of a frame.
+     *
+     * @param empty_frames Number of frames, or 0 to disable table GC.
+     */
+    void set_table_gc(int32_t empty_frames) const {
+        ecs_set_table_gc(m_world, empty_frames);
+    }
+
+    /** Delete empty tables and shrink table storage.
+     *
+     * @param empty_frames Number of passes a table must be empty.
+     * @return The number of deleted tables.
+     */
+    int32_t delete_empty_tables(int32_t empty_frames = 0) const {
+        return ecs_delete_empty_tables(m_world, empty_frames);
+    }
+
     /** Disables inactive systems.
      *
      * This removes systems that are not matched with any entities from the main
@@ -156,6 +156,42 @@ void ecs_set_threads(
     ecs_world_t *world,
     int32_t threads);
 
+/** Enable or disable work stealing.
+ * By default each worker thread processes an equal slice of every table that
+ * is matched by a system. When work stealing is enabled, matched tables are
+ * cut into jobs small enough to fit in the cache, and workers that run out of
+ * jobs steal jobs from other workers. This reduces the time workers spend 
+ * waiting on each other when the entities are unevenly distributed across 
+ * tables. The operation may not be called while running a system / pipeline.
+ *
+ * @param world The world.
+ * @param enable Whether to enable work stealing.
+ */
+FLECS_API
+void ecs_set_work_stealing(
+    ecs_world_t *world,
+    bool enable);
+
+/** Enable or disable parallel systems.
+ * By default the entities matched by a system are distributed across all 
+ * worker threads, and workers run systems one after another. When parallel
+ * systems are enabled, each system runs on a single worker, and systems that
+ * don't write components that are accessed by other systems run concurrently
+ * on different workers. Which systems conflict is determined from the [in] and
+ * [out] annotations in the system signatures. This reduces overhead for 
+ * pipelines with many systems that each match few entities.
+ *
+ * When parallel systems are enabled, work stealing is not used. The operation
+ * may not be called while running a system / pipeline.
+ *
+ * @param world The world.
+ * @param enable Whether to enable parallel systems.
+ */
+FLECS_API
+void ecs_set_parallel_systems(
+    ecs_world_t *world,
+    bool enable);
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Module
 ////////////////////////////////////////////////////////////////////////////////
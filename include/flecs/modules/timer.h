@@ -232,6 +232,34 @@ void ecs_set_tick_source(
     ecs_entity_t system,
     ecs_entity_t tick_source);
 
+/** Use a timer wheel to progress timers.
+ * By default all timers are visited each frame. When the timer wheel is
+ * enabled, timers are stored in a hierarchical timer wheel, and only timers
+ * that expire in the current frame are visited. This reduces the cost of
+ * progressing timers for applications with large numbers of timers, of which
+ * only a few fire each frame.
+ *
+ * Timers are fired on the same frame as without the timer wheel. The resolution
+ * determines the duration of a tick of the wheel. A higher resolution reduces
+ * the number of ticks the wheel advances each frame, while a lower resolution
+ * reduces the number of timers visited that have not yet expired.
+ *
+ * When the timer wheel is enabled, the 'time' member of EcsTimer is only
+ * updated when the timer fires. Changes to the EcsTimer component must be
+ * signalled with ecs_modified (ecs_set, ecs_start_timer and ecs_stop_timer do
+ * this automatically).
+ *
+ * Existing timers are moved to the timer wheel. This operation cannot be called
+ * while the world is progressing, and the timer wheel cannot be disabled.
+ *
+ * @param world The world.
+ * @param resolution The duration of a tick (0 for the default of 1ms).
+ */
+FLECS_API
+void ecs_enable_timer_wheel(
+    ecs_world_t *world,
+    FLECS_FLOAT resolution);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Module
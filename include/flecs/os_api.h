@@ -52,6 +52,7 @@ extern int64_t ecs_os_api_free_count;
 typedef uintptr_t ecs_os_thread_t;
 typedef uintptr_t ecs_os_cond_t;
 typedef uintptr_t ecs_os_mutex_t;
+typedef uintptr_t ecs_os_barrier_t;
 typedef uintptr_t ecs_os_dl_t;
 
 /* Generic function pointer type */
@@ -147,6 +148,19 @@ void (*ecs_os_api_cond_wait_t)(
     ecs_os_cond_t cond,
     ecs_os_mutex_t mutex);
 
+/* Barrier */
+typedef
+ecs_os_barrier_t (*ecs_os_api_barrier_new_t)(
+    int32_t count);
+
+typedef
+void (*ecs_os_api_barrier_free_t)(
+    ecs_os_barrier_t barrier);
+
+typedef
+void (*ecs_os_api_barrier_wait_t)(
+    ecs_os_barrier_t barrier);
+
 typedef 
 void (*ecs_os_api_sleep_t)(
     int32_t sec,
@@ -223,6 +237,11 @@ typedef struct ecs_os_api_t {
     ecs_os_api_cond_broadcast_t cond_broadcast_;
     ecs_os_api_cond_wait_t cond_wait_;
 
+    /* Barrier */
+    ecs_os_api_barrier_new_t barrier_new_;
+    ecs_os_api_barrier_free_t barrier_free_;
+    ecs_os_api_barrier_wait_t barrier_wait_;
+
     /* Time */
     ecs_os_api_sleep_t sleep_;
     ecs_os_api_get_time_t get_time_;
@@ -351,6 +370,11 @@ void ecs_os_set_api_defaults(void);
 #define ecs_os_cond_broadcast(cond) ecs_os_api.cond_broadcast_(cond)
 #define ecs_os_cond_wait(cond, mutex) ecs_os_api.cond_wait_(cond, mutex)
 
+/* Barrier */
+#define ecs_os_barrier_new(count) ecs_os_api.barrier_new_(count)
+#define ecs_os_barrier_free(barrier) ecs_os_api.barrier_free_(barrier)
+#define ecs_os_barrier_wait(barrier) ecs_os_api.barrier_wait_(barrier)
+
 /* Time */
 #define ecs_os_sleep(sec, nanosec) ecs_os_api.sleep_(sec, nanosec)
 #define ecs_os_get_time(time_out) ecs_os_api.get_time_(time_out)
@@ -6,14 +6,16 @@
  * a 64-bit key. While it is not as fast as the sparse set, it is better at
  * handling randomly distributed values.
  *
- * Payload is stored in bucket arrays. A bucket is computed from an id by
- * using the (bucket_count - 1) as an AND-mask. The number of buckets is always
- * a power of 2. Multiple keys will be stored in the same bucket. As a result
- * the worst case retrieval performance of the map is O(n), though this is rare.
- * On average lookup performance should equal O(1).
+ * Keys and payload are stored in flat arrays. Each slot has a control byte
+ * that stores whether the slot is empty, deleted or used, and for used slots
+ * the upper bits of the key hash. Lookups compare the control bytes of a group
+ * of 16 slots at once (with SSE2 when available), and only compare keys for
+ * slots of which the control byte matches. The number of slots is always a
+ * power of 2, which means lookup performance should on average equal O(1).
  *
- * The datastructure will automatically grow the number of buckets when the
- * ratio between elements and buckets exceeds a certain threshold (LOAD_FACTOR).
+ * The datastructure will automatically grow the number of slots when the
+ * ratio between elements and slots exceeds a certain threshold (LOAD_FACTOR).
+ * Growing the map is the only operation that allocates.
  *
  * Note that while the implementation is a hashmap, it can only compute hashes
  * for the provided 64 bit keys. This means that the provided keys must always
@@ -38,7 +40,6 @@ typedef uint64_t ecs_map_key_t;
 
 typedef struct ecs_map_iter_t {
     const ecs_map_t *map;
-    struct ecs_bucket_t *bucket;
     int32_t bucket_index;
     int32_t element_index;
     void *payload;
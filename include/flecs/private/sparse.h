@@ -100,6 +100,14 @@ void ecs_sparse_remove(
     ecs_sparse_t *sparse,
     uint64_t index);
 
+/** Return an id obtained with ecs_sparse_new_id(s) that was never handed out
+ * to the unused elements. Unlike ecs_sparse_remove, this does not increase the
+ * generation, so the id is recycled as if it had never been issued. */
+FLECS_DBG_API
+void ecs_sparse_release_id(
+    ecs_sparse_t *sparse,
+    uint64_t index);
+
 /** Remove an element, return pointer to the value in the sparse array */
 FLECS_DBG_API
 void* _ecs_sparse_remove_get(
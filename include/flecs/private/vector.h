@@ -40,13 +40,19 @@ extern "C" {
 struct ecs_vector_t {
     int32_t count;
     int32_t size;
-    
-#ifndef NDEBUG
-    int64_t elem_size;
-#endif
+
+    /* Offset of the vector from the start of its allocation. Only nonzero for
+     * vectors that are aligned beyond the alignment of the allocator. */
+    int32_t alloc_offset;
+
+    /* Element size, only used for validation in debug builds */
+    int32_t elem_size;
 };
 
-/* Compute the header size of the vector from size & alignment */
+/* Compute the header size of the vector from size & alignment. The element 
+ * buffer of a vector is padded to a multiple of the header size. If the 
+ * alignment is larger than the header, the elements start at a multiple of the
+ * alignment. */
 #define ECS_VECTOR_U(size, alignment) size, ECS_CAST(int16_t, ECS_MAX(ECS_SIZEOF(ecs_vector_t), alignment))
 
 /* Compute the header size of the vector from a provided compile-time type */
@@ -276,6 +282,9 @@ void _ecs_vector_reclaim(
 #define ecs_vector_reclaim(vector, T)\
     _ecs_vector_reclaim(vector, ECS_VECTOR_T(T))
 
+#define ecs_vector_reclaim_t(vector, size, alignment)\
+    _ecs_vector_reclaim(vector, ECS_VECTOR_U(size, alignment))
+
 /** Grow size of vector with provided number of elements. */
 FLECS_API
 int32_t _ecs_vector_grow(
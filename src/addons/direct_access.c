@@ -86,6 +86,7 @@ ecs_record_t ecs_table_insert(
 {
     ecs_data_t *data = ecs_table_get_or_create_data(table);
     int32_t index = ecs_table_append(world, table, data, entity, record, true);
+    ecs_monitor_invalidate_bases(world);
     if (record) {
         record->table = table;
         record->row = index + 1;
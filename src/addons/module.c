@@ -213,11 +213,13 @@ ecs_entity_t ecs_new_module(
         e = ecs_new_from_fullpath(world, module_path);
 
         EcsName *name_ptr = ecs_get_mut(world, e, EcsName, NULL);
+        ecs_name_index_remove(world, e, name_ptr);
         ecs_os_free(name_ptr->symbol);
 
         /* Assign full path to symbol. This allows for modules to be redefined
          * in C++ without causing name conflicts */
         name_ptr->symbol = module_path;
+        ecs_name_index_add(world, e, name_ptr);
     }
 
     ecs_entity_t result = ecs_component_init(world, &(ecs_component_desc_t){
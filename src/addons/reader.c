@@ -388,4 +388,211 @@ ecs_reader_t ecs_reader_init_w_iter(
     return result;
 }
 
+/* -- Table-oriented blob -- */
+
+/* Collect the tables to serialize. As with the reader, component tables are
+ * stored first, as component data must be restored before other tables. */
+static
+ecs_vector_t* blob_tables(
+    ecs_world_t *world)
+{
+    ecs_vector_t *result = NULL;
+
+    ecs_iter_t it = ecs_filter_iter(world, &(ecs_filter_t){
+        .include = ecs_type(EcsComponent)
+    });
+
+    while (ecs_filter_next(&it)) {
+        if (it.count) {
+            ecs_table_t **elem = ecs_vector_add(&result, ecs_table_t*);
+            *elem = it.table->table;
+        }
+    }
+
+    it = ecs_filter_iter(world, NULL);
+    while (ecs_filter_next(&it)) {
+        ecs_table_t *table = it.table->table;
+        if (it.count && !(table->flags & EcsTableHasBuiltins)) {
+            ecs_table_t **elem = ecs_vector_add(&result, ecs_table_t*);
+            *elem = table;
+        }
+    }
+
+    return result;
+}
+
+/* Align offset. If buffer is not NULL, padding bytes are initialized to 0 */
+static
+uint64_t blob_align(
+    uint8_t *buffer,
+    uint64_t offset,
+    uint64_t alignment)
+{
+    uint64_t result = (offset + alignment - 1) & ~(alignment - 1);
+    if (buffer && result != offset) {
+        ecs_os_memset(&buffer[offset], 0, (ecs_size_t)(result - offset));
+    }
+    return result;
+}
+
+/* Add a string to a blob, return its offset or 0 if the string is NULL */
+static
+uint64_t blob_string(
+    uint8_t *buffer,
+    uint64_t *offset,
+    const char *str)
+{
+    if (!str) {
+        return 0;
+    }
+
+    ecs_size_t len = ecs_os_strlen(str) + 1;
+    uint64_t result = *offset;
+    if (buffer) {
+        ecs_os_memcpy(&buffer[result], str, len);
+    }
+
+    *offset += (uint64_t)len;
+    return result;
+}
+
+/* Compute the layout of a blob. If buffer is not NULL, also write the blob */
+static
+uint64_t blob_serialize(
+    ecs_vector_t *tables,
+    uint8_t *buffer)
+{
+    ecs_table_t **table_array = ecs_vector_first(tables, ecs_table_t*);
+    int32_t t, table_count = ecs_vector_count(tables);
+
+    uint64_t tables_offset = blob_align(buffer, sizeof(ecs_blob_header_t), 8);
+    uint64_t offset = tables_offset + sizeof(ecs_blob_table_t) * 
+        (uint64_t)table_count;
+
+    for (t = 0; t < table_count; t ++) {
+        ecs_table_t *table = table_array[t];
+        ecs_data_t *data = ecs_table_get_data(table);
+        ecs_entity_t *type_array = ecs_vector_first(table->type, ecs_entity_t);
+        int32_t row_count = ecs_vector_count(data->entities);
+        int32_t c, column_count = table->column_count + 1;
+        int32_t name_column = -1;
+
+        ecs_blob_table_t bt = {
+            .type_count = (uint32_t)ecs_vector_count(table->type),
+            .column_count = (uint32_t)column_count,
+            .row_count = (uint32_t)row_count
+        };
+
+        bt.type = blob_align(buffer, offset, 8);
+        offset = bt.type + sizeof(ecs_entity_t) * bt.type_count;
+        bt.columns = blob_align(buffer, offset, 8);
+        offset = bt.columns + sizeof(ecs_blob_column_t) * bt.column_count;
+
+        if (buffer) {
+            ecs_os_memcpy(&buffer[tables_offset + sizeof(bt) * (uint64_t)t],
+                &bt, ECS_SIZEOF(bt));
+            ecs_os_memcpy(&buffer[bt.type], type_array, 
+                ECS_SIZEOF(ecs_entity_t) * (ecs_size_t)bt.type_count);
+        }
+
+        for (c = 0; c < column_count; c ++) {
+            ecs_blob_column_t bc = {0};
+            const void *src;
+
+            if (!c) {
+                bc.size = ECS_SIZEOF(ecs_entity_t);
+                bc.alignment = ECS_ALIGNOF(ecs_entity_t);
+                src = ecs_vector_first(data->entities, ecs_entity_t);
+            } else if (type_array[c - 1] == ecs_id(EcsName)) {
+                /* Names are stored after the columns of the table, and the
+                 * column stores the offsets to the name and symbol. */
+                bc.size = 2 * ECS_SIZEOF(uint64_t);
+                bc.alignment = ECS_ALIGNOF(uint64_t);
+                bc.flags = ECS_BLOB_COLUMN_NAME;
+                src = NULL;
+                name_column = c;
+            } else {
+                ecs_column_t *column = &data->columns[c - 1];
+                bc.size = (uint32_t)column->size;
+                bc.alignment = (uint16_t)column->alignment;
+                src = ecs_vector_first_t(
+                    column->data, column->size, column->alignment);
+            }
+
+            if (bc.size) {
+                bc.data = blob_align(buffer, offset, bc.alignment);
+                offset = bc.data + (uint64_t)bc.size * (uint64_t)row_count;
+
+                if (buffer && src) {
+                    ecs_os_memcpy(&buffer[bc.data], src, 
+                        (ecs_size_t)bc.size * row_count);
+                }
+            }
+
+            if (buffer) {
+                ecs_os_memcpy(&buffer[bt.columns + sizeof(bc) * (uint64_t)c],
+                    &bc, ECS_SIZEOF(bc));
+            }
+        }
+
+        if (name_column != -1) {
+            ecs_blob_column_t bc = {0};
+            EcsName *names = ecs_vector_first(
+                data->columns[name_column - 1].data, EcsName);
+            int32_t r;
+
+            if (buffer) {
+                ecs_os_memcpy(&bc, 
+                    &buffer[bt.columns + sizeof(bc) * (uint64_t)name_column],
+                    ECS_SIZEOF(bc));
+            }
+
+            for (r = 0; r < row_count; r ++) {
+                uint64_t name_offsets[2] = {
+                    blob_string(buffer, &offset, names[r].value),
+                    blob_string(buffer, &offset, names[r].symbol)
+                };
+
+                if (buffer) {
+                    ecs_os_memcpy(&buffer[bc.data + sizeof(name_offsets) * 
+                        (uint64_t)r], name_offsets, ECS_SIZEOF(name_offsets));
+                }
+            }
+        }
+    }
+
+    if (buffer) {
+        ecs_blob_header_t hdr = {
+            .magic = ECS_BLOB_MAGIC,
+            .version = ECS_BLOB_VERSION,
+            .size = offset,
+            .tables = tables_offset,
+            .table_count = (uint32_t)table_count
+        };
+
+        ecs_os_memcpy(buffer, &hdr, ECS_SIZEOF(hdr));
+    }
+
+    return offset;
+}
+
+size_t ecs_world_to_blob(
+    ecs_world_t *world,
+    void *buffer,
+    size_t size)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_vector_t *tables = blob_tables(world);
+    uint64_t result = blob_serialize(tables, NULL);
+
+    if (buffer && size >= result) {
+        blob_serialize(tables, buffer);
+    }
+
+    ecs_vector_free(tables);
+
+    return (size_t)result;
+}
+
 #endif
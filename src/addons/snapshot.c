@@ -4,89 +4,342 @@
 
 #include "../private_api.h"
 
+/* Buffer that can be shared between snapshots. When a column did not change
+ * between two snapshots, the second snapshot shares the buffer of the first
+ * snapshot instead of copying it. */
+typedef struct snapshot_buffer_t {
+    ecs_vector_t *data;
+    int32_t refcount;
+} snapshot_buffer_t;
+
+/* Table state at the time the snapshot was taken. The dirty state is used to
+ * determine which columns changed since the snapshot was taken. */
+typedef struct snapshot_table_t {
+    int32_t *dirty_state;
+    snapshot_buffer_t *entities;
+    snapshot_buffer_t *record_ptrs;
+    snapshot_buffer_t **columns;
+} snapshot_table_t;
+
 /* World snapshot */
 struct ecs_snapshot_t {
     ecs_world_t *world;
     ecs_sparse_t *entity_index;
-    ecs_vector_t *tables;
+    ecs_vector_t *tables;       /* ecs_table_leaf_t */
+    ecs_vector_t *table_state;  /* snapshot_table_t, same order as tables */
     ecs_entity_t last_id;
     ecs_filter_t filter;
+    bool incremental;           /* Only restore tables that changed */
 };
 
+static
+snapshot_buffer_t* buffer_new(
+    ecs_vector_t *data)
+{
+    snapshot_buffer_t *result = ecs_os_malloc(ECS_SIZEOF(snapshot_buffer_t));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+    result->data = data;
+    result->refcount = 1;
+    return result;
+}
+
+static
+snapshot_buffer_t* buffer_share(
+    snapshot_buffer_t *buffer)
+{
+    buffer->refcount ++;
+    return buffer;
+}
+
+static
+bool column_is_stored(
+    ecs_table_t *table,
+    ecs_column_t *column,
+    int32_t index)
+{
+    ecs_entity_t component = ecs_vector_first(table->type, ecs_entity_t)[index];
+    return column->size && component <= ECS_HI_COMPONENT_ID;
+}
+
+static
+ecs_vector_t* copy_column(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t index,
+    const ecs_column_t *column,
+    ecs_vector_t *src,
+    ecs_entity_t *entities)
+{
+    ecs_entity_t component = ecs_vector_first(table->type, ecs_entity_t)[index];
+    const ecs_type_info_t *cdata = ecs_get_c_info(world, component);
+    int16_t size = column->size;
+    int16_t alignment = column->alignment;
+    ecs_copy_t copy;
+
+    if (cdata && (copy = cdata->lifecycle.copy)) {
+        int32_t count = ecs_vector_count(src);
+        ecs_vector_t *dst_vec = ecs_vector_new_t(size, alignment, count);
+        ecs_vector_set_count_t(&dst_vec, size, alignment, count);
+        void *dst_ptr = ecs_vector_first_t(dst_vec, size, alignment);
+        void *ctx = cdata->lifecycle.ctx;
+        
+        ecs_xtor_t ctor = cdata->lifecycle.ctor;
+        if (ctor) {
+            ctor(world, component, entities, dst_ptr, ecs_to_size_t(size), 
+                count, ctx);
+        }
+
+        void *src_ptr = ecs_vector_first_t(src, size, alignment);
+        copy(world, component, entities, entities, dst_ptr, src_ptr, 
+            ecs_to_size_t(size), count, ctx);
+
+        return dst_vec;
+    } else {
+        return ecs_vector_copy_t(src, size, alignment);
+    }
+}
+
+static
+void free_column(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t index,
+    const ecs_column_t *column,
+    ecs_vector_t *data,
+    ecs_entity_t *entities)
+{
+    ecs_entity_t component = ecs_vector_first(table->type, ecs_entity_t)[index];
+    const ecs_type_info_t *cdata = ecs_get_c_info(world, component);
+    ecs_xtor_t dtor;
+    int32_t count = ecs_vector_count(data);
+
+    if (count && cdata && (dtor = cdata->lifecycle.dtor)) {
+        int16_t size = column->size;
+        int16_t alignment = column->alignment;
+        void *ptr = ecs_vector_first_t(data, size, alignment);
+        dtor(world, component, entities, ptr, ecs_to_size_t(size), count, 
+            cdata->lifecycle.ctx);
+    }
+
+    ecs_vector_free(data);
+}
+
+/* Release the buffers of a table. Columns are released before the entities,
+ * as the entities are passed to the destructors of the components. */
+static
+void release_table(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    snapshot_table_t *state)
+{
+    int32_t i, column_count = table->column_count;
+    ecs_entity_t *entities = ecs_vector_first(
+        state->entities->data, ecs_entity_t);
+
+    for (i = 0; i < column_count; i ++) {
+        snapshot_buffer_t *buffer = state->columns[i];
+        if (buffer && !(-- buffer->refcount)) {
+            free_column(world, table, i, &data->columns[i], buffer->data, 
+                entities);
+            ecs_os_free(buffer);
+        }
+    }
+
+    if (!(-- state->record_ptrs->refcount)) {
+        ecs_vector_free(state->record_ptrs->data);
+        ecs_os_free(state->record_ptrs);
+    }
+
+    if (!(-- state->entities->refcount)) {
+        ecs_vector_free(state->entities->data);
+        ecs_os_free(state->entities);
+    }
+
+    ecs_os_free(state->columns);
+    ecs_os_free(state->dirty_state);
+}
+
+/* Obtain data that is owned by the caller from a table in the snapshot. If a
+ * buffer is not shared with other snapshots it is moved to the result, 
+ * otherwise it is copied. */
+static
+void own_table_data(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    snapshot_table_t *state)
+{
+    int32_t i, column_count = table->column_count;
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+
+    for (i = 0; i < column_count; i ++) {
+        snapshot_buffer_t *buffer = state->columns[i];
+        if (!buffer) {
+            continue;
+        }
+
+        if (buffer->refcount == 1) {
+            ecs_os_free(buffer);
+        } else {
+            data->columns[i].data = copy_column(
+                world, table, i, &data->columns[i], buffer->data, entities);
+            buffer->refcount --;
+        }
+    }
+
+    if (state->record_ptrs->refcount == 1) {
+        ecs_os_free(state->record_ptrs);
+    } else {
+        data->record_ptrs = ecs_vector_copy(data->record_ptrs, ecs_record_t*);
+        state->record_ptrs->refcount --;
+    }
+
+    if (state->entities->refcount == 1) {
+        ecs_os_free(state->entities);
+    } else {
+        data->entities = ecs_vector_copy(data->entities, ecs_entity_t);
+        state->entities->refcount --;
+    }
+
+    ecs_os_free(state->columns);
+    ecs_os_free(state->dirty_state);
+}
+
+/* Test if a table changed since the snapshot was taken */
+static
+bool table_changed(
+    ecs_table_t *table,
+    const int32_t *dirty_state)
+{
+    int32_t *cur_state = ecs_table_get_dirty_state(table);
+    int32_t i, column_count = table->column_count;
+    for (i = 0; i <= column_count; i ++) {
+        if (cur_state[i] != dirty_state[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Copy the data of a table. If the table is also stored in the previous 
+ * snapshot, buffers that did not change since the previous snapshot are 
+ * shared with the previous snapshot. */
 static
 ecs_data_t* duplicate_data(
     ecs_world_t *world,
     ecs_table_t *table,
-    ecs_data_t *main_data)
+    ecs_data_t *main_data,
+    snapshot_table_t *prev,
+    snapshot_table_t *state)
 {
     ecs_data_t *result = ecs_os_calloc(ECS_SIZEOF(ecs_data_t));
 
     int32_t i, column_count = table->column_count;
-    ecs_entity_t *components = ecs_vector_first(table->type, ecs_entity_t);
 
     result->columns = ecs_os_memdup(
         main_data->columns, ECS_SIZEOF(ecs_column_t) * column_count);
 
-    /* Copy entities */
-    result->entities = ecs_vector_copy(main_data->entities, ecs_entity_t);
-    ecs_entity_t *entities = ecs_vector_first(result->entities, ecs_entity_t);
+    state->dirty_state = ecs_table_get_monitor(table);
+    state->columns = ecs_os_calloc(
+        ECS_SIZEOF(snapshot_buffer_t*) * column_count);
+
+    /* If the table was not changed structurally, entities and record ptrs
+     * can be shared with the previous snapshot */
+    bool same_rows = prev && prev->dirty_state[0] == state->dirty_state[0];
+
+    if (same_rows) {
+        state->entities = buffer_share(prev->entities);
+        state->record_ptrs = buffer_share(prev->record_ptrs);
+    } else {
+        state->entities = buffer_new(
+            ecs_vector_copy(main_data->entities, ecs_entity_t));
+        state->record_ptrs = buffer_new(
+            ecs_vector_copy(main_data->record_ptrs, ecs_record_t*));
+    }
 
-    /* Copy record ptrs */
-    result->record_ptrs = ecs_vector_copy(main_data->record_ptrs, ecs_record_t*);
+    result->entities = state->entities->data;
+    result->record_ptrs = state->record_ptrs->data;
+    ecs_entity_t *entities = ecs_vector_first(result->entities, ecs_entity_t);
 
     /* Copy each column */
     for (i = 0; i < column_count; i ++) {
-        ecs_entity_t component = components[i];
         ecs_column_t *column = &result->columns[i];
 
-        if (component > ECS_HI_COMPONENT_ID) {
+        if (!column_is_stored(table, column, i)) {
             column->data = NULL;
             continue;
         }
 
-        const ecs_type_info_t *cdata = ecs_get_c_info(world, component);
-        int16_t size = column->size;
-        int16_t alignment = column->alignment;
-        ecs_copy_t copy;
-
-        if (cdata && (copy = cdata->lifecycle.copy)) {
-            int32_t count = ecs_vector_count(column->data);
-            ecs_vector_t *dst_vec = ecs_vector_new_t(size, alignment, count);
-            ecs_vector_set_count_t(&dst_vec, size, alignment, count);
-            void *dst_ptr = ecs_vector_first_t(dst_vec, size, alignment);
-            void *ctx = cdata->lifecycle.ctx;
-            
-            ecs_xtor_t ctor = cdata->lifecycle.ctor;
-            if (ctor) {
-                ctor(world, component, entities, dst_ptr, ecs_to_size_t(size), 
-                    count, ctx);
-            }
-
-            void *src_ptr = ecs_vector_first_t(column->data, size, alignment);
-            copy(world, component, entities, entities, dst_ptr, src_ptr, 
-                ecs_to_size_t(size), count, ctx);
-
-            column->data = dst_vec;
+        snapshot_buffer_t *buffer;
+        if (same_rows && prev->columns[i] && 
+            prev->dirty_state[i + 1] == state->dirty_state[i + 1]) 
+        {
+            buffer = buffer_share(prev->columns[i]);
         } else {
-            column->data = ecs_vector_copy_t(column->data, size, alignment);
+            buffer = buffer_new(
+                copy_column(world, table, i, column, column->data, entities));
         }
+
+        state->columns[i] = buffer;
+        column->data = buffer->data;
     }
 
     return result;
 }
 
+/* Find the state of a table in a snapshot. Tables are stored in the order in
+ * which they are iterated, so the search resumes at the last found table. */
+static
+snapshot_table_t* find_table_state(
+    const ecs_snapshot_t *snapshot,
+    ecs_table_t *table,
+    int32_t *index)
+{
+    if (!snapshot) {
+        return NULL;
+    }
+
+    ecs_table_leaf_t *leafs = ecs_vector_first(
+        snapshot->tables, ecs_table_leaf_t);
+    snapshot_table_t *states = ecs_vector_first(
+        snapshot->table_state, snapshot_table_t);
+    int32_t i, count = ecs_vector_count(snapshot->tables);
+
+    for (i = *index; i < count; i ++) {
+        if (leafs[i].table == table) {
+            *index = i + 1;
+            return &states[i];
+        }
+    }
+
+    for (i = 0; i < *index && i < count; i ++) {
+        if (leafs[i].table == table) {
+            *index = i + 1;
+            return &states[i];
+        }
+    }
+
+    return NULL;
+}
+
 static
 ecs_snapshot_t* snapshot_create(
     ecs_world_t *world,
     const ecs_sparse_t *entity_index,
     ecs_iter_t *iter,
-    ecs_iter_next_action_t next)
+    ecs_iter_next_action_t next,
+    const ecs_snapshot_t *prev)
 {
     ecs_snapshot_t *result = ecs_os_calloc(ECS_SIZEOF(ecs_snapshot_t));
     ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
 
     result->world = world;
 
+    /* Prevent tables referenced by the snapshot from being deleted */
+    world->snapshot_count ++;
+
     /* If no iterator is provided, the snapshot will be taken of the entire
      * world, and we can simply copy the entity index as it will be restored
      * entirely upon snapshote restore. */
@@ -110,6 +363,7 @@ ecs_snapshot_t* snapshot_create(
     }
 
     /* Iterate tables in iterator */
+    int32_t prev_index = 0;
     while (next(iter)) {
         ecs_table_t *t = iter->table->table;
 
@@ -123,10 +377,13 @@ ecs_snapshot_t* snapshot_create(
         }
 
         ecs_table_leaf_t *l = ecs_vector_add(&result->tables, ecs_table_leaf_t);
+        snapshot_table_t *state = ecs_vector_add(
+            &result->table_state, snapshot_table_t);
 
         l->table = t;
         l->type = t->type;
-        l->data = duplicate_data(world, t, data);
+        l->data = duplicate_data(world, t, data, 
+            find_table_state(prev, t, &prev_index), state);
     }
 
     return result;
@@ -140,6 +397,7 @@ ecs_snapshot_t* ecs_snapshot_take(
         world,
         world->store.entity_index,
         NULL,
+        NULL,
         NULL);
 
     result->last_id = world->stats.last_id;
@@ -147,6 +405,26 @@ ecs_snapshot_t* ecs_snapshot_take(
     return result;
 }
 
+/** Create an incremental snapshot */
+ecs_snapshot_t* ecs_snapshot_take_incremental(
+    ecs_world_t *world,
+    const ecs_snapshot_t *prev)
+{
+    ecs_assert(!prev || prev->world == world, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_snapshot_t *result = snapshot_create(
+        world,
+        world->store.entity_index,
+        NULL,
+        NULL,
+        prev);
+
+    result->last_id = world->stats.last_id;
+    result->incremental = true;
+
+    return result;
+}
+
 /** Create a filtered snapshot */
 ecs_snapshot_t* ecs_snapshot_take_w_iter(
     ecs_iter_t *iter,
@@ -159,7 +437,8 @@ ecs_snapshot_t* ecs_snapshot_take_w_iter(
         world,
         world->store.entity_index,
         iter,
-        next);
+        next,
+        NULL);
 
     result->last_id = world->stats.last_id;
 
@@ -184,9 +463,19 @@ void ecs_snapshot_restore(
     }
 
     ecs_table_leaf_t *leafs = ecs_vector_first(snapshot->tables, ecs_table_leaf_t);
+    snapshot_table_t *states = ecs_vector_first(
+        snapshot->table_state, snapshot_table_t);
     int32_t l = 0, count = ecs_vector_count(snapshot->tables);
     int32_t t, table_count = ecs_sparse_count(world->store.tables);
 
+    /* If the snapshot is incremental, tables that did not change since the
+     * snapshot was taken are not restored. Keep track of which tables are 
+     * restored, so that OnSet systems are only ran for the restored tables. */
+    bool *restored = NULL;
+    if (!is_filtered && table_count) {
+        restored = ecs_os_calloc(ECS_SIZEOF(bool) * table_count);
+    }
+
     for (t = 0; t < table_count; t ++) {
         ecs_table_t *table = ecs_sparse_get(world->store.tables, ecs_table_t, t);
 
@@ -200,6 +489,22 @@ void ecs_snapshot_restore(
         }
 
         if (leaf && leaf->table == table) {
+            snapshot_table_t *state = &states[l];
+
+            if (snapshot->incremental && 
+                !table_changed(table, state->dirty_state)) 
+            {
+                /* Table is in the same state as when the snapshot was taken,
+                 * nothing to restore. */
+                release_table(world, table, leaf->data, state);
+                ecs_os_free(leaf->data->columns);
+                ecs_os_free(leaf->data);
+                l ++;
+                continue;
+            }
+
+            own_table_data(world, table, leaf->data, state);
+
             /* If the snapshot is filtered, update the entity index for the
              * entities in the snapshot. If the snapshot was not filtered
              * the entity index would have been replaced entirely, and this
@@ -239,6 +544,7 @@ void ecs_snapshot_restore(
                 ecs_os_free(leaf->data->columns);
             } else {
                 ecs_table_replace_data(world, table, leaf->data);
+                restored[t] = true;
             }
             
             ecs_os_free(leaf->data);
@@ -265,11 +571,11 @@ void ecs_snapshot_restore(
      * restoring safe */
     if (!is_filtered) {
         for (t = 0; t < table_count; t ++) {
-            ecs_table_t *table = ecs_sparse_get(world->store.tables, ecs_table_t, t);
-            if (table->flags & EcsTableHasBuiltins) {
+            if (!restored[t]) {
                 continue;
             }
 
+            ecs_table_t *table = ecs_sparse_get(world->store.tables, ecs_table_t, t);
             ecs_ids_t components = ecs_type_to_entities(table->type);
             ecs_data_t *table_data = ecs_table_get_data(table);
             int32_t entity_count = ecs_table_data_count(table_data);
@@ -277,9 +583,14 @@ void ecs_snapshot_restore(
             ecs_run_set_systems(world, &components, table, 
                 table_data, 0, entity_count, true);            
         }
+
+        ecs_os_free(restored);
     }
 
-    ecs_vector_free(snapshot->tables);   
+    world->snapshot_count --;
+
+    ecs_vector_free(snapshot->tables);
+    ecs_vector_free(snapshot->table_state);
 
     ecs_os_free(snapshot);
 }
@@ -342,15 +653,792 @@ void ecs_snapshot_free(
     ecs_sparse_free(snapshot->entity_index);
 
     ecs_table_leaf_t *tables = ecs_vector_first(snapshot->tables, ecs_table_leaf_t);
+    snapshot_table_t *states = ecs_vector_first(
+        snapshot->table_state, snapshot_table_t);
     int32_t i, count = ecs_vector_count(snapshot->tables);
     for (i = 0; i < count; i ++) {
         ecs_table_leaf_t *leaf = &tables[i];
-        ecs_table_clear_data(snapshot->world, leaf->table, leaf->data);
+        release_table(snapshot->world, leaf->table, leaf->data, &states[i]);
+        ecs_os_free(leaf->data->columns);
         ecs_os_free(leaf->data);
     }    
 
+    snapshot->world->snapshot_count --;
+
     ecs_vector_free(snapshot->tables);
+    ecs_vector_free(snapshot->table_state);
     ecs_os_free(snapshot);
 }
 
+/* -- Snapshot diff -- */
+
+/* Identifies an encoded diff, so that other data is not mistaken for a diff */
+#define DIFF_MAGIC (0x46444946)
+
+/* State of a world that is compared by a diff. This is either a snapshot, or
+ * the world itself. */
+typedef struct diff_source_t {
+    const ecs_sparse_t *entity_index;
+    ecs_map_t *tables;          /* table id -> ecs_data_t*, NULL for world */
+} diff_source_t;
+
+/* Location of an entity in the previous state */
+typedef struct diff_row_t {
+    ecs_table_t *table;
+    ecs_data_t *data;
+    int32_t row;
+} diff_row_t;
+
+/* Buffer that an encoded diff is written to */
+typedef struct diff_blob_t {
+    uint8_t *data;
+    ecs_size_t size;
+    ecs_size_t capacity;
+} diff_blob_t;
+
+/* Buffer that an encoded diff is read from */
+typedef struct diff_reader_t {
+    const uint8_t *ptr;
+    const uint8_t *end;
+    bool error;
+} diff_reader_t;
+
+static
+void diff_source_init(
+    diff_source_t *src,
+    ecs_world_t *world,
+    const ecs_snapshot_t *snapshot)
+{
+    if (!snapshot) {
+        src->entity_index = world->store.entity_index;
+        src->tables = NULL;
+        return;
+    }
+
+    ecs_assert(snapshot->entity_index != NULL, ECS_INVALID_PARAMETER, 
+        "cannot diff filtered snapshot");
+
+    ecs_table_leaf_t *leafs = ecs_vector_first(
+        snapshot->tables, ecs_table_leaf_t);
+    int32_t i, count = ecs_vector_count(snapshot->tables);
+
+    src->entity_index = snapshot->entity_index;
+    src->tables = ecs_map_new(ecs_data_t*, count);
+
+    for (i = 0; i < count; i ++) {
+        ecs_map_set(src->tables, leafs[i].table->id, &leafs[i].data);
+    }
+}
+
+/* Get data of a table in a diff source. Tables with builtin components are not
+ * stored in snapshots, and are therefore also ignored for the world. */
+static
+ecs_data_t* diff_source_data(
+    const diff_source_t *src,
+    ecs_table_t *table)
+{
+    if (!table || table->flags & EcsTableHasBuiltins) {
+        return NULL;
+    }
+
+    if (!src->tables) {
+        return ecs_table_get_data(table);
+    }
+
+    ecs_data_t **ptr = ecs_map_get(src->tables, ecs_data_t*, table->id);
+    if (ptr) {
+        return *ptr;
+    }
+
+    return NULL;
+}
+
+static
+ecs_record_t* diff_source_record(
+    const diff_source_t *src,
+    ecs_entity_t entity)
+{
+    return ecs_sparse_get_sparse(src->entity_index, ecs_record_t, entity);
+}
+
+/* Component values are compared bytewise. Components that own resources can't
+ * be compared this way, so changes to those components are not tracked. */
+static
+bool column_is_diffable(
+    ecs_world_t *world,
+    ecs_entity_t component)
+{
+    const ecs_type_info_t *c_info = ecs_get_c_info(world, component);
+    return !c_info || !c_info->lifecycle.copy;
+}
+
+static
+const void* diff_prev_value(
+    const diff_row_t *row,
+    ecs_entity_t component)
+{
+    if (!row->data) {
+        return NULL;
+    }
+
+    ecs_table_t *table = row->table;
+    int32_t index = ecs_type_index_of(table->type, component);
+    if (index == -1 || index >= table->column_count) {
+        return NULL;
+    }
+
+    ecs_column_t *column = &row->data->columns[index];
+    if (!column->data) {
+        return NULL;
+    }
+
+    void *ptr = ecs_vector_first_t(column->data, column->size, 
+        column->alignment);
+    return ECS_OFFSET(ptr, column->size * row->row);
+}
+
+/* Find entities that were deleted, created or moved to another table */
+static
+void diff_entities(
+    ecs_snapshot_diff_t *diff,
+    const diff_source_t *from,
+    const diff_source_t *to)
+{
+    const uint64_t *ids = ecs_sparse_ids(from->entity_index);
+    int32_t i, count = ecs_sparse_count(from->entity_index);
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = ids[i];
+        ecs_record_t *r = diff_source_record(from, e);
+        if (r->table && r->table->flags & EcsTableHasBuiltins) {
+            continue;
+        }
+
+        if (!diff_source_record(to, e)) {
+            ecs_entity_t *elem = ecs_vector_add(&diff->deleted, ecs_entity_t);
+            *elem = e;
+        }
+    }
+
+    ids = ecs_sparse_ids(to->entity_index);
+    count = ecs_sparse_count(to->entity_index);
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = ids[i];
+        ecs_table_t *table = diff_source_record(to, e)->table;
+        if (table && table->flags & EcsTableHasBuiltins) {
+            continue;
+        }
+
+        ecs_snapshot_diff_entity_t *elem;
+        ecs_record_t *r = diff_source_record(from, e);
+        if (!r) {
+            elem = ecs_vector_add(&diff->created, ecs_snapshot_diff_entity_t);
+        } else if (r->table != table) {
+            elem = ecs_vector_add(&diff->moved, ecs_snapshot_diff_entity_t);
+        } else {
+            continue;
+        }
+
+        elem->entity = e;
+        elem->type = table ? table->type : NULL;
+    }
+}
+
+/* Find component values in a table that changed. Changed values are stored as
+ * ranges of consecutive rows. */
+static
+void diff_table(
+    ecs_world_t *world,
+    ecs_snapshot_diff_t *diff,
+    const diff_source_t *from,
+    ecs_table_t *table,
+    ecs_data_t *data)
+{
+    int32_t row, count = ecs_vector_count(data->entities);
+    if (!count) {
+        return;
+    }
+
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    ecs_entity_t *components = ecs_vector_first(table->type, ecs_entity_t);
+
+    /* If the table has the same rows as in the previous state, values can be
+     * compared column by column. */
+    ecs_data_t *prev = diff_source_data(from, table);
+    bool same_rows = prev && (prev->entities == data->entities || 
+        (ecs_vector_count(prev->entities) == count && !ecs_os_memcmp(
+            ecs_vector_first(prev->entities, ecs_entity_t), entities, 
+            ECS_SIZEOF(ecs_entity_t) * count)));
+
+    /* If not, find the previous location of each entity */
+    diff_row_t *rows = NULL;
+    if (!same_rows) {
+        rows = ecs_os_malloc(ECS_SIZEOF(diff_row_t) * count);
+        for (row = 0; row < count; row ++) {
+            ecs_record_t *r = diff_source_record(from, entities[row]);
+            diff_row_t *elem = &rows[row];
+            elem->table = r ? r->table : NULL;
+            elem->data = diff_source_data(from, elem->table);
+            if (elem->data) {
+                bool is_watched;
+                elem->row = ecs_record_to_row(r->row, &is_watched);
+            }
+        }
+    }
+
+    int32_t c, column_count = table->column_count;
+    for (c = 0; c < column_count; c ++) {
+        ecs_column_t *column = &data->columns[c];
+        ecs_entity_t component = components[c];
+
+        if (!column_is_stored(table, column, c) || 
+            !column_is_diffable(world, component)) 
+        {
+            continue;
+        }
+
+        ecs_size_t size = column->size;
+        void *ptr = ecs_vector_first_t(column->data, size, column->alignment);
+        void *prev_ptr = NULL;
+
+        if (same_rows) {
+            /* Columns shared between incremental snapshots didn't change */
+            ecs_vector_t *prev_column = prev->columns[c].data;
+            if (prev_column == column->data) {
+                continue;
+            }
+
+            prev_ptr = ecs_vector_first_t(prev_column, size, column->alignment);
+            if (!ecs_os_memcmp(ptr, prev_ptr, size * count)) {
+                continue;
+            }
+        }
+
+        ecs_snapshot_diff_range_t *range = NULL;
+
+        for (row = 0; row < count; row ++) {
+            const uint8_t *value = ECS_OFFSET(ptr, size * row);
+            const uint8_t *prev_value;
+            if (same_rows) {
+                prev_value = ECS_OFFSET(prev_ptr, size * row);
+            } else {
+                prev_value = diff_prev_value(&rows[row], component);
+            }
+
+            if (prev_value && !ecs_os_memcmp(value, prev_value, size)) {
+                range = NULL;
+                continue;
+            }
+
+            bool is_set = prev_value == NULL;
+            if (!range || range->is_set != is_set) {
+                range = ecs_vector_add(
+                    &diff->changed, ecs_snapshot_diff_range_t);
+                range->component = component;
+                range->size = size;
+                range->count = 0;
+                range->is_set = is_set;
+                range->entities = NULL;
+                range->delta = NULL;
+            }
+
+            ecs_entity_t *e = ecs_vector_add(
+                &diff->range_entities, ecs_entity_t);
+            *e = entities[row];
+
+            uint8_t *delta = ecs_vector_addn(
+                &diff->range_data, uint8_t, size);
+            if (is_set) {
+                ecs_os_memcpy(delta, value, size);
+            } else {
+                ecs_size_t i;
+                for (i = 0; i < size; i ++) {
+                    delta[i] = (uint8_t)(value[i] ^ prev_value[i]);
+                }
+            }
+
+            range->count ++;
+        }
+    }
+
+    ecs_os_free(rows);
+}
+
+/* Ranges store their entities and deltas in shared vectors. Now that the 
+ * vectors no longer grow, assign the pointers of the ranges. */
+static
+void diff_finalize_ranges(
+    ecs_snapshot_diff_t *diff)
+{
+    ecs_entity_t *entities = ecs_vector_first(
+        diff->range_entities, ecs_entity_t);
+    uint8_t *data = ecs_vector_first(diff->range_data, uint8_t);
+
+    ecs_vector_each(diff->changed, ecs_snapshot_diff_range_t, range, {
+        range->entities = entities;
+        range->delta = data;
+        entities += range->count;
+        data += range->count * range->size;
+    });
+}
+
+/** Compute difference between two snapshots */
+ecs_snapshot_diff_t* ecs_snapshot_diff(
+    const ecs_snapshot_t *from,
+    const ecs_snapshot_t *to)
+{
+    ecs_assert(from != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!to || to->world == from->world, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_world_t *world = from->world;
+    ecs_snapshot_diff_t *result = ecs_os_calloc(ECS_SIZEOF(ecs_snapshot_diff_t));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    diff_source_t src_from, src_to;
+    diff_source_init(&src_from, world, from);
+    diff_source_init(&src_to, world, to);
+
+    diff_entities(result, &src_from, &src_to);
+
+    if (to) {
+        ecs_vector_each(to->tables, ecs_table_leaf_t, leaf, {
+            diff_table(world, result, &src_from, leaf->table, leaf->data);
+        });
+    } else {
+        int32_t t, table_count = ecs_sparse_count(world->store.tables);
+        for (t = 0; t < table_count; t ++) {
+            ecs_table_t *table = ecs_sparse_get(
+                world->store.tables, ecs_table_t, t);
+            ecs_data_t *data = diff_source_data(&src_to, table);
+            if (data) {
+                diff_table(world, result, &src_from, table, data);
+            }
+        }
+    }
+
+    diff_finalize_ranges(result);
+
+    ecs_map_free(src_from.tables);
+    ecs_map_free(src_to.tables);
+
+    return result;
+}
+
+static
+uint8_t* diff_blob_reserve(
+    diff_blob_t *blob,
+    ecs_size_t size)
+{
+    if (blob->size + size > blob->capacity) {
+        ecs_size_t capacity = blob->capacity * 2;
+        if (capacity < blob->size + size) {
+            capacity = blob->size + size;
+        }
+        if (capacity < 64) {
+            capacity = 64;
+        }
+
+        blob->data = ecs_os_realloc(blob->data, capacity);
+        ecs_assert(blob->data != NULL, ECS_OUT_OF_MEMORY, NULL);
+        blob->capacity = capacity;
+    }
+
+    uint8_t *result = &blob->data[blob->size];
+    blob->size += size;
+    return result;
+}
+
+/* Integers are encoded as LEB128 varints, so that small values use one byte */
+static
+void diff_blob_varint(
+    diff_blob_t *blob,
+    uint64_t value)
+{
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        *diff_blob_reserve(blob, 1) = byte;
+    } while (value);
+}
+
+/* Encode bytes as a sequence of (zero count, literal count, literals). Since 
+ * deltas of unchanged bytes are zero, runs of zeros are common. A zero run is
+ * only split off when it is longer than the two bytes it costs to encode. */
+static
+void diff_blob_rle(
+    diff_blob_t *blob,
+    const uint8_t *data,
+    ecs_size_t size)
+{
+    ecs_size_t i = 0;
+    while (i < size) {
+        ecs_size_t zeros = 0;
+        while (i + zeros < size && !data[i + zeros]) {
+            zeros ++;
+        }
+        i += zeros;
+
+        ecs_size_t literals = 0;
+        while (i + literals < size) {
+            if (!data[i + literals] && (i + literals + 2 >= size || 
+                (!data[i + literals + 1] && !data[i + literals + 2]))) 
+            {
+                break;
+            }
+            literals ++;
+        }
+
+        diff_blob_varint(blob, (uint64_t)zeros);
+        diff_blob_varint(blob, (uint64_t)literals);
+        if (literals) {
+            ecs_os_memcpy(diff_blob_reserve(blob, literals), &data[i], 
+                literals);
+        }
+        i += literals;
+    }
+}
+
+static
+void diff_blob_entities(
+    diff_blob_t *blob,
+    ecs_vector_t *entities)
+{
+    diff_blob_varint(blob, (uint64_t)ecs_vector_count(entities));
+    ecs_vector_each(entities, ecs_snapshot_diff_entity_t, elem, {
+        diff_blob_varint(blob, elem->entity);
+
+        ecs_entity_t *ids = ecs_vector_first(elem->type, ecs_entity_t);
+        int32_t i, count = ecs_vector_count(elem->type);
+        diff_blob_varint(blob, (uint64_t)count);
+        for (i = 0; i < count; i ++) {
+            diff_blob_varint(blob, ids[i]);
+        }
+    });
+}
+
+/** Encode diff */
+void* ecs_snapshot_diff_encode(
+    const ecs_snapshot_diff_t *diff,
+    ecs_size_t *size_out)
+{
+    ecs_assert(diff != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(size_out != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    diff_blob_t blob = {0};
+    diff_blob_varint(&blob, DIFF_MAGIC);
+
+    diff_blob_varint(&blob, (uint64_t)ecs_vector_count(diff->deleted));
+    ecs_vector_each(diff->deleted, ecs_entity_t, e, {
+        diff_blob_varint(&blob, *e);
+    });
+
+    diff_blob_entities(&blob, diff->created);
+    diff_blob_entities(&blob, diff->moved);
+
+    /* Entities in a range are mostly consecutive, so store the difference
+     * with the previous entity, zigzag encoded. */
+    diff_blob_varint(&blob, (uint64_t)ecs_vector_count(diff->changed));
+    ecs_vector_each(diff->changed, ecs_snapshot_diff_range_t, range, {
+        diff_blob_varint(&blob, range->component);
+        diff_blob_varint(&blob, (uint64_t)range->size);
+        diff_blob_varint(&blob, range->is_set);
+        diff_blob_varint(&blob, (uint64_t)range->count);
+
+        ecs_entity_t prev = 0;
+        int32_t i;
+        for (i = 0; i < range->count; i ++) {
+            int64_t delta = (int64_t)(range->entities[i] - prev);
+            diff_blob_varint(&blob, 
+                ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+            prev = range->entities[i];
+        }
+
+        diff_blob_rle(&blob, range->delta, range->count * range->size);
+    });
+
+    *size_out = blob.size;
+    return blob.data;
+}
+
+static
+uint64_t diff_read_varint(
+    diff_reader_t *reader)
+{
+    uint64_t result = 0;
+    int32_t shift = 0;
+
+    while (reader->ptr < reader->end && shift < 64) {
+        uint8_t byte = *(reader->ptr ++);
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return result;
+        }
+        shift += 7;
+    }
+
+    reader->error = true;
+    return 0;
+}
+
+/* Read a count. Each element takes at least one byte, which is used to reject
+ * counts that can't be valid before allocating storage for them. */
+static
+int32_t diff_read_count(
+    diff_reader_t *reader)
+{
+    uint64_t count = diff_read_varint(reader);
+    if (count > (uint64_t)(reader->end - reader->ptr)) {
+        reader->error = true;
+        return 0;
+    }
+
+    return (int32_t)count;
+}
+
+static
+void diff_read_rle(
+    diff_reader_t *reader,
+    uint8_t *data,
+    ecs_size_t size)
+{
+    ecs_size_t i = 0;
+    while (i < size && !reader->error) {
+        uint64_t zeros = diff_read_varint(reader);
+        uint64_t literals = diff_read_varint(reader);
+
+        if ((!zeros && !literals) || zeros > (uint64_t)(size - i) ||
+            literals > (uint64_t)(size - i) - zeros ||
+            literals > (uint64_t)(reader->end - reader->ptr)) 
+        {
+            reader->error = true;
+            return;
+        }
+
+        ecs_os_memset(&data[i], 0, (ecs_size_t)zeros);
+        i += (ecs_size_t)zeros;
+        ecs_os_memcpy(&data[i], reader->ptr, (ecs_size_t)literals);
+        i += (ecs_size_t)literals;
+        reader->ptr += literals;
+    }
+}
+
+static
+bool diff_has_id(
+    const ecs_entity_t *ids,
+    int32_t count,
+    ecs_entity_t id)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        if (ids[i] == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Make an entity alive and give it the specified type */
+static
+void diff_set_type(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    const ecs_entity_t *ids,
+    int32_t count)
+{
+    ecs_ensure(world, entity);
+
+    ecs_entity_t id = entity & ECS_ENTITY_MASK;
+    if (id >= world->stats.last_id) {
+        world->stats.last_id = id + 1;
+    }
+
+    ecs_type_t type = ecs_get_type(world, entity);
+    ecs_entity_t *cur = ecs_vector_first(type, ecs_entity_t);
+    int32_t i, cur_count = ecs_vector_count(type);
+
+    if (cur_count) {
+        cur = ecs_os_memdup(cur, ECS_SIZEOF(ecs_entity_t) * cur_count);
+        for (i = 0; i < cur_count; i ++) {
+            if (!diff_has_id(ids, count, cur[i])) {
+                ecs_remove_id(world, entity, cur[i]);
+            }
+        }
+        ecs_os_free(cur);
+    }
+
+    for (i = 0; i < count; i ++) {
+        ecs_add_id(world, entity, ids[i]);
+    }
+}
+
+static
+void diff_read_entities(
+    ecs_world_t *world,
+    diff_reader_t *reader,
+    bool apply)
+{
+    int32_t i, count = diff_read_count(reader);
+    for (i = 0; i < count && !reader->error; i ++) {
+        ecs_entity_t e = diff_read_varint(reader);
+        int32_t t, type_count = diff_read_count(reader);
+        if (!e || reader->error) {
+            reader->error = true;
+            return;
+        }
+
+        ecs_entity_t *ids = ecs_os_malloc(
+            ECS_SIZEOF(ecs_entity_t) * type_count);
+        for (t = 0; t < type_count; t ++) {
+            ids[t] = diff_read_varint(reader);
+            if (!ids[t] || !ecs_is_valid(world, ids[t])) {
+                reader->error = true;
+            }
+        }
+
+        if (apply && !reader->error) {
+            diff_set_type(world, e, ids, type_count);
+        }
+
+        ecs_os_free(ids);
+    }
+}
+
+static
+void diff_read_ranges(
+    ecs_world_t *world,
+    diff_reader_t *reader,
+    bool apply)
+{
+    int32_t i, count = diff_read_count(reader);
+    for (i = 0; i < count && !reader->error; i ++) {
+        ecs_entity_t component = diff_read_varint(reader);
+        uint64_t size = diff_read_varint(reader);
+        bool is_set = diff_read_varint(reader) != 0;
+        int32_t e, entity_count = diff_read_count(reader);
+        if (reader->error) {
+            return;
+        }
+
+        /* The size of the component must match the size in the diff */
+        const EcsComponent *cptr = NULL;
+        if (component && ecs_is_alive(world, component)) {
+            cptr = ecs_get(world, component, EcsComponent);
+        }
+        if (!cptr || (uint64_t)cptr->size != size) {
+            reader->error = true;
+            return;
+        }
+
+        ecs_size_t elem_size = cptr->size;
+        ecs_entity_t *entities = ecs_os_malloc(
+            ECS_SIZEOF(ecs_entity_t) * entity_count);
+        ecs_entity_t prev = 0;
+        for (e = 0; e < entity_count; e ++) {
+            uint64_t delta = diff_read_varint(reader);
+            prev += (delta >> 1) ^ (~(delta & 1) + 1);
+            entities[e] = prev;
+        }
+
+        uint8_t *data = ecs_os_malloc(elem_size * entity_count);
+        diff_read_rle(reader, data, elem_size * entity_count);
+
+        if (apply && !reader->error) {
+            for (e = 0; e < entity_count; e ++) {
+                if (!ecs_is_alive(world, entities[e])) {
+                    continue;
+                }
+
+                uint8_t *ptr = ecs_get_mut_id(
+                    world, entities[e], component, NULL);
+                uint8_t *delta = &data[e * elem_size];
+                ecs_size_t b;
+
+                if (is_set) {
+                    ecs_os_memcpy(ptr, delta, elem_size);
+                } else {
+                    for (b = 0; b < elem_size; b ++) {
+                        ptr[b] ^= delta[b];
+                    }
+                }
+
+                ecs_modified_id(world, entities[e], component);
+            }
+        }
+
+        ecs_os_free(data);
+        ecs_os_free(entities);
+    }
+}
+
+/* Read an encoded diff. When apply is false the diff is only validated. */
+static
+int diff_read(
+    ecs_world_t *world,
+    const void *data,
+    ecs_size_t size,
+    bool apply)
+{
+    diff_reader_t reader = {
+        .ptr = data,
+        .end = ECS_OFFSET(data, size)
+    };
+
+    if (diff_read_varint(&reader) != DIFF_MAGIC) {
+        return -1;
+    }
+
+    int32_t i, count = diff_read_count(&reader);
+    for (i = 0; i < count && !reader.error; i ++) {
+        ecs_entity_t e = diff_read_varint(&reader);
+        if (apply && ecs_is_alive(world, e)) {
+            ecs_delete(world, e);
+        }
+    }
+
+    diff_read_entities(world, &reader, apply);
+    diff_read_entities(world, &reader, apply);
+    diff_read_ranges(world, &reader, apply);
+
+    if (reader.error || reader.ptr != reader.end) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/** Apply encoded diff */
+int ecs_snapshot_diff_apply(
+    ecs_world_t *world,
+    const void *data,
+    ecs_size_t size)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(data != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    /* Validate the diff before applying it, so that a malformed diff does not
+     * leave the world partially modified. */
+    if (diff_read(world, data, size, false)) {
+        return -1;
+    }
+
+    return diff_read(world, data, size, true);
+}
+
+/** Free diff */
+void ecs_snapshot_diff_free(
+    ecs_snapshot_diff_t *diff)
+{
+    ecs_vector_free(diff->deleted);
+    ecs_vector_free(diff->created);
+    ecs_vector_free(diff->moved);
+    ecs_vector_free(diff->changed);
+    ecs_vector_free(diff->range_entities);
+    ecs_vector_free(diff->range_data);
+    ecs_os_free(diff);
+}
+
 #endif
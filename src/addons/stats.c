@@ -158,6 +158,7 @@ void ecs_get_world_stats(
     int32_t empty_table_count = 0;
     int32_t singleton_table_count = 0;
     int32_t matched_table_count = 0, matched_entity_count = 0;
+    int32_t table_edge_memory = 0;
 
     int32_t i, count = ecs_sparse_count(world->store.tables);
     for (i = 0; i < count; i ++) {
@@ -186,6 +187,8 @@ void ecs_get_world_stats(
             matched_table_count ++;
             matched_entity_count += entity_count;
         }
+
+        table_edge_memory += ecs_table_edges_memory(table);
     }
 
     record_gauge(&s->matched_table_count, t, matched_table_count);
@@ -194,6 +197,7 @@ void ecs_get_world_stats(
     record_gauge(&s->table_count, t, count);
     record_gauge(&s->empty_table_count, t, empty_table_count);
     record_gauge(&s->singleton_table_count, t, singleton_table_count);
+    record_gauge(&s->table_edge_memory, t, table_edge_memory);
 }
 
 void ecs_get_query_stats(
@@ -370,6 +374,7 @@ void ecs_dump_world_stats(
     print_gauge("table count", t, &s->table_count);
     print_gauge("singleton table count", t, &s->singleton_table_count);
     print_gauge("empty table count", t, &s->empty_table_count);
+    print_gauge("table edge memory", t, &s->table_edge_memory);
     printf("\n");
     print_counter("deferred new operations", t, &s->new_count);
     print_counter("deferred bulk_new operations", t, &s->bulk_new_count);
@@ -50,21 +50,27 @@ void ecs_name_writer_reset(
 }
 
 static
-void ecs_table_writer_register_table(
-    ecs_writer_t *stream)
+ecs_table_t* writer_find_table(
+    ecs_world_t *world,
+    ecs_entity_t *type_array,
+    int32_t type_count)
 {
-    ecs_world_t *world = stream->world;
-    ecs_table_writer_t *writer = &stream->table;
-    ecs_type_t type = ecs_type_find(world, writer->type_array, writer->type_count);
+    ecs_type_t type = ecs_type_find(world, type_array, type_count);
     ecs_assert(type != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    writer->table = ecs_table_from_type(world, type);
-    ecs_assert(writer->table != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_table_t *table = ecs_table_from_type(world, type);
+    ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    ecs_os_free(writer->type_array);
-    writer->type_array = NULL;
+    return table;
+}
 
-    ecs_data_t *data = ecs_table_get_or_create_data(writer->table);
+/* Prepare a table for receiving data */
+static
+void writer_register_table(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_data_t *data = ecs_table_get_or_create_data(table);
     if (data->entities) {
         /* Remove any existing entities from entity index */
         ecs_vector_each(data->entities, ecs_entity_t, e_ptr, {
@@ -73,25 +79,19 @@ void ecs_table_writer_register_table(
              * matches the data in the blob */
             ecs_eis_set_generation(world, *e_ptr);
         });
-      
-        return;
     } else {
         /* Set size of table to 0. This will initialize columns */
-        ecs_table_set_size(world, writer->table, data, 0);
+        ecs_table_set_size(world, table, data, 0);
     }
-
-    ecs_assert(writer->table != NULL, ECS_INTERNAL_ERROR, NULL);
 }
 
+/* Register the entities of a table that received data in the entity index */
 static
-void ecs_table_writer_finalize_table(
-    ecs_writer_t *stream)
+void writer_finalize_table(
+    ecs_world_t *world,
+    ecs_table_t *table)
 {
-    ecs_world_t *world = stream->world;
-    ecs_table_writer_t *writer = &stream->table;
-
-    /* Register entities in table in entity index */
-    ecs_data_t *data = ecs_table_get_data(writer->table);
+    ecs_data_t *data = ecs_table_get_data(table);
     ecs_vector_t *entity_vector = data->entities;
     ecs_entity_t *entities = ecs_vector_first(entity_vector, ecs_entity_t);
     ecs_record_t **record_ptrs = ecs_vector_first(data->record_ptrs, ecs_record_t*);
@@ -101,20 +101,22 @@ void ecs_table_writer_finalize_table(
         ecs_record_t *record_ptr = ecs_eis_get_any(world, entities[i]);
 
         if (record_ptr) {
-            if (record_ptr->table != writer->table) {
-                ecs_table_t *table = record_ptr->table;      
-                ecs_data_t *table_data = ecs_table_get_data(table);
+            if (record_ptr->table != table) {
+                ecs_table_t *cur_table = record_ptr->table;      
+                ecs_data_t *table_data = ecs_table_get_data(cur_table);
 
-                ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+                ecs_assert(cur_table != NULL, ECS_INTERNAL_ERROR, NULL);
+                ecs_name_index_move(world, NULL, 
+                    cur_table, table_data, record_ptr->row - 1, 1);
                 ecs_table_delete(world, 
-                    table, table_data, record_ptr->row - 1, false);
+                    cur_table, table_data, record_ptr->row - 1, false);
             }
         } else {
             record_ptr = ecs_eis_ensure(world, entities[i]);
         }
 
         record_ptr->row = i + 1;
-        record_ptr->table = writer->table;
+        record_ptr->table = table;
 
         record_ptrs[i] = record_ptr;
 
@@ -129,6 +131,29 @@ void ecs_table_writer_finalize_table(
             }
         }
     }
+
+    ecs_name_index_table(world, table, data, 0, count);
+}
+
+static
+void ecs_table_writer_register_table(
+    ecs_writer_t *stream)
+{
+    ecs_table_writer_t *writer = &stream->table;
+
+    writer->table = writer_find_table(
+        stream->world, writer->type_array, writer->type_count);
+    writer_register_table(stream->world, writer->table);
+
+    ecs_os_free(writer->type_array);
+    writer->type_array = NULL;
+}
+
+static
+void ecs_table_writer_finalize_table(
+    ecs_writer_t *stream)
+{
+    writer_finalize_table(stream->world, stream->table.table);
 }
 
 static
@@ -431,4 +456,310 @@ ecs_writer_t ecs_writer_init(
     };
 }
 
+/* -- Table-oriented blob -- */
+
+/* Test if count elements of elem_size at offset are inside the blob */
+static
+bool blob_range_valid(
+    uint64_t offset,
+    uint64_t count,
+    uint64_t elem_size,
+    uint64_t size)
+{
+    if (offset > size) {
+        return false;
+    }
+
+    return !elem_size || count <= (size - offset) / elem_size;
+}
+
+static
+uint64_t blob_read_u64(
+    const uint8_t *buffer,
+    uint64_t offset)
+{
+    uint64_t result;
+    ecs_os_memcpy(&result, &buffer[offset], ECS_SIZEOF(uint64_t));
+    return result;
+}
+
+/* Test if a string offset points to a string that is terminated in the blob */
+static
+bool blob_string_valid(
+    const uint8_t *buffer,
+    size_t size,
+    uint64_t offset)
+{
+    return !offset || (offset < size && 
+        memchr(&buffer[offset], 0, size - offset) != NULL);
+}
+
+static
+int blob_validate_column(
+    const uint8_t *buffer,
+    size_t size,
+    const ecs_blob_table_t *bt,
+    const ecs_blob_column_t *bc,
+    uint32_t index)
+{
+    if (bc->flags & ~ECS_BLOB_COLUMN_NAME) {
+        return -1;
+    }
+
+    if (!index && (bc->size != ECS_SIZEOF(ecs_entity_t) || bc->flags)) {
+        return -1;
+    }
+
+    if (bc->flags && bc->size != 2 * ECS_SIZEOF(uint64_t)) {
+        return -1;
+    }
+
+    if (!bc->size) {
+        return 0;
+    }
+
+    if (bc->size > INT16_MAX || 
+        !blob_range_valid(bc->data, bt->row_count, bc->size, size)) 
+    {
+        return -1;
+    }
+
+    uint32_t r;
+    if (!index) {
+        /* Entity ids can't be 0 */
+        for (r = 0; r < bt->row_count; r ++) {
+            if (!blob_read_u64(buffer, bc->data + sizeof(uint64_t) * r)) {
+                return -1;
+            }
+        }
+    } else if (bc->flags) {
+        for (r = 0; r < bt->row_count; r ++) {
+            uint64_t offset = bc->data + bc->size * r;
+            if (!blob_string_valid(buffer, size, 
+                    blob_read_u64(buffer, offset)) ||
+                !blob_string_valid(buffer, size, 
+                    blob_read_u64(buffer, offset + sizeof(uint64_t))))
+            {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Validate the layout of a blob, before anything is written to the world */
+static
+int blob_validate(
+    const uint8_t *buffer,
+    size_t size)
+{
+    ecs_blob_header_t hdr;
+    if (size < sizeof(hdr)) {
+        return -1;
+    }
+
+    ecs_os_memcpy(&hdr, buffer, ECS_SIZEOF(hdr));
+    if (hdr.magic != ECS_BLOB_MAGIC || hdr.version != ECS_BLOB_VERSION ||
+        hdr.size != size)
+    {
+        return -1;
+    }
+
+    if (!blob_range_valid(hdr.tables, hdr.table_count, 
+        sizeof(ecs_blob_table_t), size)) 
+    {
+        return -1;
+    }
+
+    uint32_t t;
+    for (t = 0; t < hdr.table_count; t ++) {
+        ecs_blob_table_t bt;
+        ecs_os_memcpy(&bt, &buffer[hdr.tables + sizeof(bt) * t], 
+            ECS_SIZEOF(bt));
+
+        if (!bt.type_count || !blob_range_valid(
+            bt.type, bt.type_count, sizeof(ecs_entity_t), size)) 
+        {
+            return -1;
+        }
+
+        if (!bt.column_count || bt.column_count > bt.type_count + 1 || 
+            !blob_range_valid(bt.columns, bt.column_count, 
+                sizeof(ecs_blob_column_t), size))
+        {
+            return -1;
+        }
+
+        if (bt.row_count > INT32_MAX) {
+            return -1;
+        }
+
+        uint32_t i;
+        for (i = 0; i < bt.type_count; i ++) {
+            if (!blob_read_u64(buffer, bt.type + sizeof(ecs_entity_t) * i)) {
+                return -1;
+            }
+        }
+
+        for (i = 0; i < bt.column_count; i ++) {
+            ecs_blob_column_t bc;
+            ecs_os_memcpy(&bc, &buffer[bt.columns + sizeof(bc) * i], 
+                ECS_SIZEOF(bc));
+            if (blob_validate_column(buffer, size, &bt, &bc, i)) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static
+char* blob_load_string(
+    const uint8_t *buffer,
+    uint64_t offset)
+{
+    if (!offset) {
+        return NULL;
+    }
+
+    return ecs_os_strdup((const char*)&buffer[offset]);
+}
+
+static
+void blob_load_names(
+    const uint8_t *buffer,
+    const ecs_blob_column_t *bc,
+    ecs_column_t *column,
+    int32_t row_count)
+{
+    int32_t r, old_count = ecs_vector_count(column->data);
+    EcsName *names = ecs_vector_first(column->data, EcsName);
+
+    /* Free names of rows that are overwritten or removed */
+    for (r = 0; r < old_count; r ++) {
+        ecs_os_free(names[r].alloc_value);
+        ecs_os_free(names[r].symbol);
+    }
+
+    ecs_vector_set_count(&column->data, EcsName, row_count);
+    names = ecs_vector_first(column->data, EcsName);
+
+    for (r = 0; r < row_count; r ++) {
+        uint64_t offset = bc->data + bc->size * (uint64_t)r;
+        EcsName *name = &names[r];
+        name->alloc_value = blob_load_string(
+            buffer, blob_read_u64(buffer, offset));
+        name->symbol = blob_load_string(
+            buffer, blob_read_u64(buffer, offset + sizeof(uint64_t)));
+        name->value = name->alloc_value;
+    }
+}
+
+static
+int blob_load_table(
+    ecs_world_t *world,
+    const uint8_t *buffer,
+    const ecs_blob_table_t *bt)
+{
+    ecs_size_t type_size = ECS_SIZEOF(ecs_entity_t) * (ecs_size_t)bt->type_count;
+    ecs_entity_t *type_array = ecs_os_malloc(type_size);
+    ecs_os_memcpy(type_array, &buffer[bt->type], type_size);
+    ecs_table_t *table = writer_find_table(
+        world, type_array, (int32_t)bt->type_count);
+    ecs_os_free(type_array);
+
+    const uint8_t *columns = &buffer[bt->columns];
+    int32_t c, column_count = (int32_t)bt->column_count;
+    int32_t row_count = (int32_t)bt->row_count;
+
+    if (column_count != table->column_count + 1) {
+        return -1;
+    }
+
+    /* Serialized columns must match the columns of the table */
+    for (c = 1; c < column_count; c ++) {
+        ecs_blob_column_t bc;
+        ecs_os_memcpy(&bc, &columns[sizeof(bc) * (size_t)c], ECS_SIZEOF(bc));
+        ecs_entity_t component = ecs_vector_first(
+            table->type, ecs_entity_t)[c - 1];
+        bool is_name = component == ecs_id(EcsName);
+
+        if (is_name != ((bc.flags & ECS_BLOB_COLUMN_NAME) != 0)) {
+            return -1;
+        }
+
+        const EcsComponent *cptr = ecs_component_from_id(world, component);
+        uint32_t size = cptr ? (uint32_t)cptr->size : 0;
+        if (!is_name && bc.size != size) {
+            return -1;
+        }
+    }
+
+    writer_register_table(world, table);
+    ecs_data_t *data = ecs_table_get_data(table);
+
+    ecs_blob_column_t bc;
+    ecs_os_memcpy(&bc, columns, ECS_SIZEOF(bc));
+    ecs_vector_set_count(&data->entities, ecs_entity_t, row_count);
+    ecs_vector_set_count(&data->record_ptrs, ecs_record_t*, row_count);
+    ecs_os_memcpy(ecs_vector_first(data->entities, ecs_entity_t), 
+        &buffer[bc.data], ECS_SIZEOF(ecs_entity_t) * row_count);
+
+    for (c = 1; c < column_count; c ++) {
+        ecs_column_t *column = &data->columns[c - 1];
+        ecs_os_memcpy(&bc, &columns[sizeof(bc) * (size_t)c], ECS_SIZEOF(bc));
+
+        if (!bc.size) {
+            continue;
+        }
+
+        if (bc.flags & ECS_BLOB_COLUMN_NAME) {
+            blob_load_names(buffer, &bc, column, row_count);
+            continue;
+        }
+
+        /* Copy the column in one go */
+        ecs_vector_set_count_t(&column->data, column->size, column->alignment,
+            row_count);
+        ecs_os_memcpy(ecs_vector_first_t(
+            column->data, column->size, column->alignment), 
+            &buffer[bc.data], column->size * row_count);
+    }
+
+    writer_finalize_table(world, table);
+
+    return 0;
+}
+
+int ecs_world_from_blob(
+    ecs_world_t *world,
+    const void *buffer,
+    size_t size)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(buffer != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    const uint8_t *bytes = buffer;
+    if (blob_validate(bytes, size)) {
+        return -1;
+    }
+
+    ecs_blob_header_t hdr;
+    ecs_os_memcpy(&hdr, bytes, ECS_SIZEOF(hdr));
+
+    uint32_t t;
+    for (t = 0; t < hdr.table_count; t ++) {
+        ecs_blob_table_t bt;
+        ecs_os_memcpy(&bt, &bytes[hdr.tables + sizeof(bt) * t], 
+            ECS_SIZEOF(bt));
+        if (blob_load_table(world, bytes, &bt)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 #endif
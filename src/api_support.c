@@ -187,6 +187,7 @@ void ecs_set_symbol(
     const char *e_name = ecs_name_from_symbol(world, name);
 
     EcsName *name_ptr = ecs_get_mut(world, e, EcsName, NULL);
+    ecs_name_index_remove(world, e, name_ptr);
     name_ptr->value = e_name;
 
     if (name_ptr->symbol) {
@@ -194,6 +195,7 @@ void ecs_set_symbol(
     }
 
     name_ptr->symbol = ecs_os_strdup(name);
+    ecs_name_index_add(world, e, name_ptr);
 }
 
 ecs_entity_t ecs_lookup_w_id(
@@ -254,6 +256,8 @@ ecs_type_t ecs_type_from_str(
     ecs_table_t *table = table_from_ids(world, normalized_ids);
     ecs_vector_free(normalized_ids);
 
+    table->flags |= EcsTableIsPinned;
+
     return table->type;
 }
 
@@ -271,5 +275,9 @@ ecs_table_t* ecs_table_from_str(
     ecs_table_t *result = table_from_ids(world, ids);
     ecs_vector_free(ids);
 
+    if (result) {
+        result->flags |= EcsTableIsPinned;
+    }
+
     return result;
 }
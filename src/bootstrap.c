@@ -71,7 +71,9 @@ static ECS_CTOR(EcsTrigger, ptr, {
 })
 
 static ECS_DTOR(EcsTrigger, ptr, {
-    ecs_trigger_fini(world, (ecs_trigger_t*)ptr->trigger);
+    if (ptr->trigger) {
+        ecs_trigger_fini(world, (ecs_trigger_t*)ptr->trigger);
+    }
 })
 
 static ECS_COPY(EcsTrigger, dst, src, {
@@ -92,7 +94,9 @@ static ECS_CTOR(EcsObserver, ptr, {
 })
 
 static ECS_DTOR(EcsObserver, ptr, {
-    ecs_observer_fini(world, (ecs_observer_t*)ptr->observer);
+    if (ptr->observer) {
+        ecs_observer_fini(world, (ecs_observer_t*)ptr->observer);
+    }
 })
 
 static ECS_COPY(EcsObserver, dst, src, {
@@ -179,6 +183,8 @@ void _bootstrap_component(
     id_data[index].value = &id[ecs_os_strlen("Ecs")]; /* Skip prefix */
     id_data[index].symbol = ecs_os_strdup(id);
     id_data[index].alloc_value = NULL;
+
+    ecs_name_index_add(world, entity, &id_data[index]);
 }
 
 /** Create type for component */
@@ -194,6 +200,8 @@ ecs_type_t ecs_bootstrap_type(
     ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(table->type != NULL, ECS_INTERNAL_ERROR, NULL);
 
+    table->flags |= EcsTableIsPinned;
+
     return table->type;
 }
 
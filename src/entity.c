@@ -30,6 +30,20 @@ void* get_component_w_index(
     return ECS_OFFSET(ptr, size * row);  
 }
 
+/* Find index of low id in table type. Returns -1 if not found. */
+static
+int32_t get_lo_column(
+    const ecs_table_t *table,
+    ecs_id_t id)
+{
+    ecs_assert(id < ECS_HI_COMPONENT_ID, ECS_INTERNAL_ERROR, NULL);
+    if (id >= (ecs_id_t)table->lo_column_count) {
+        return -1;
+    }
+
+    return table->lo_column_map[id] - 1;
+}
+
 static
 void* get_component(
     const ecs_world_t *world,
@@ -37,6 +51,15 @@ void* get_component(
     int32_t row,
     ecs_id_t id)
 {
+    if (id < ECS_HI_COMPONENT_ID) {
+        int32_t column = get_lo_column(table, id);
+        if (column == -1) {
+            return NULL;
+        }
+
+        return get_component_w_index(table, column, row);
+    }
+
     ecs_id_record_t *idr = ecs_get_id_record(world, id);
     if (!idr) {
         return NULL;
@@ -51,6 +74,8 @@ void* get_component(
     return get_component_w_index(table, tr->column, row);
 }
 
+/* Find base that has the component. If found, the base, its table and the
+ * column of the component are stored in elem. */
 static
 void* get_base_component(
     const ecs_world_t *world,
@@ -58,6 +83,7 @@ void* get_base_component(
     ecs_id_t id,
     ecs_map_t *table_index,
     ecs_map_t *table_index_isa,
+    ecs_base_elem_t *elem,
     int32_t recur_depth)
 {
     /* Cycle detected in IsA relation */
@@ -89,10 +115,10 @@ void* get_base_component(
 
     ecs_type_t type = table->type;
     ecs_id_t *ids = ecs_vector_first(type, ecs_id_t);
-    int32_t i = tr_isa->column, count = tr_isa->count;
+    int32_t i = tr_isa->column, end = i + tr_isa->count;
     void *ptr = NULL;
 
-    do {
+    for (; !ptr && (i < end); i ++) {
         ecs_id_t pair = ids[i];
 
         ecs_entity_t base = ecs_pair_object(world, pair);
@@ -106,18 +132,82 @@ void* get_base_component(
             continue;
         }
 
-        ecs_table_record_t *tr = ecs_map_get(table_index, 
-            ecs_table_record_t, table->id);
-        if (!tr) {
+        int32_t column = -1;
+        if (id < ECS_HI_COMPONENT_ID) {
+            column = get_lo_column(table, id);
+        } else {
+            ecs_table_record_t *tr = ecs_map_get(table_index, 
+                ecs_table_record_t, table->id);
+            if (tr) {
+                column = tr->column;
+            }
+        }
+
+        if (column == -1) {
             ptr = get_base_component(world, table, id, table_index, 
-                table_index_isa, recur_depth + 1);
+                table_index_isa, elem, recur_depth + 1);
         } else {
             bool is_monitored;
             int32_t row = ecs_record_to_row(r->row, &is_monitored);
-            ptr = get_component_w_index(table, tr->column, row);
+            ptr = get_component_w_index(table, column, row);
+            elem->base = base;
+            elem->table = table;
+            elem->column = column;
+        }
+    }
+
+    return ptr;
+}
+
+/* Get inherited component using the base cache of the table. Bases are
+ * resolved once per table and id, after which a lookup only needs to check
+ * whether the base is still stored in the same table. */
+static
+void* get_base_component_cached(
+    const ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_id_t id,
+    ecs_map_t *table_index)
+{
+    if (!(table->flags & EcsTableHasBase)) {
+        return NULL;
+    }
+
+    int32_t generation = world->monitors.generation;
+    ecs_base_elem_t *elem = NULL;
+
+    if (table->base_cache) {
+        elem = ecs_map_get(table->base_cache, ecs_base_elem_t, id);
+    }
+
+    if (elem && elem->generation == generation) {
+        if (!elem->base) {
+            return NULL;
+        }
+
+        ecs_record_t *r = ecs_eis_get(world, elem->base);
+        if (r && r->table == elem->table) {
+            bool is_monitored;
+            int32_t row = ecs_record_to_row(r->row, &is_monitored);
+            return get_component_w_index(elem->table, elem->column, row);
         }
-        i ++;
-    } while (!ptr && (i < count));
+    }
+
+    ecs_base_elem_t result = { .generation = generation };
+    void *ptr = get_base_component(
+        world, table, id, table_index, NULL, &result, 0);
+
+    /* Worker threads may get components concurrently, so only update the
+     * cache when the world is accessed from a single thread. */
+    if (!world->is_readonly || ecs_get_stage_count(world) <= 1) {
+        if (!elem) {
+            if (!table->base_cache) {
+                table->base_cache = ecs_map_new(ecs_base_elem_t, 1);
+            }
+            elem = ecs_map_ensure(table->base_cache, ecs_base_elem_t, id);
+        }
+        *elem = result;
+    }
 
     return ptr;
 }
@@ -620,6 +710,15 @@ bool override_from_base(
             }                    
         }
 
+        if (component == ecs_id(EcsName)) {
+            ecs_entity_t *entities = ecs_vector_first(
+                data->entities, ecs_entity_t);
+            EcsName *names = ecs_vector_first(column->data, EcsName);
+            for (index = row; index < row + count; index ++) {
+                ecs_name_index_add(world, entities[index], &names[index]);
+            }
+        }
+
         return true;
     } else {
         /* If component not found on base, check if base itself inherits */
@@ -1056,6 +1155,10 @@ void update_component_monitors(
     ecs_ids_t * added,
     ecs_ids_t * removed)
 {
+    /* Bases are watched, so a change to a watched entity can change the base
+     * that an inherited component is resolved to. */
+    ecs_monitor_invalidate_bases(world);
+
     update_component_monitor_w_array(world, entity, 0, added);
     update_component_monitor_w_array(world, entity, 0, removed);
 }
@@ -1222,6 +1325,10 @@ const ecs_entity_t* new_w_data(
             } else {
                 ecs_os_memcpy(ptr, src_ptr, size * count);
             }
+
+            if (c == ecs_id(EcsName)) {
+                ecs_name_index_table(world, table, data, row, count);
+            }
         };
 
         ecs_run_set_systems(world, &added, table, data, row, count, true);        
@@ -1522,24 +1629,25 @@ ecs_entity_t ecs_new_id(
 {
     ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    const ecs_stage_t *stage = ecs_stage_from_readonly_world(world);
+    /* Cast away const since this is one of the few functions that may modify
+     * the stage and world while in readonly mode, since it is thread safe (the
+     * stage is only accessed by its own thread) */
+    ecs_stage_t *stage = (ecs_stage_t*)ecs_stage_from_readonly_world(world);
 
     /* It is possible that the world passed to this function is a stage, so
-     * make sure we have the actual world. Cast away const since this is one of
-     * the few functions that may modify the world while it is in readonly mode,
-     * since it is thread safe (uses atomic inc when in threading mode) */
+     * make sure we have the actual world. */
     ecs_world_t *unsafe_world = (ecs_world_t*)ecs_get_world(world);
 
     ecs_entity_t entity;
 
+    /* Only use the thread safe path while worker threads are running. In
+     * between frames the main thread has exclusive access to the entity index
+     * and can recycle ids directly. */
     int32_t stage_count = ecs_get_stage_count(unsafe_world);
-    if (stage->asynchronous || (ecs_os_has_threading() && stage_count > 1)) {
-        /* Can't atomically increase number above max int */
-        ecs_assert(
-            unsafe_world->stats.last_id < UINT_MAX, ECS_INTERNAL_ERROR, NULL);
-
-        entity = (ecs_entity_t)ecs_os_ainc(
-            (int32_t*)&unsafe_world->stats.last_id);
+    if (stage->asynchronous || (ecs_os_has_threading() && stage_count > 1 && 
+        unsafe_world->is_readonly)) 
+    {
+        entity = ecs_stage_new_id(unsafe_world, stage);
     } else {
         entity = ecs_eis_recycle(unsafe_world);
     }
@@ -1966,6 +2074,7 @@ void traverse_add_remove(
                 ECS_INCONSISTENT_NAME, desc->symbol);
         } else {
             name_ptr->symbol = ecs_os_strdup(desc->symbol);
+            ecs_name_index_add(world, result, name_ptr);
         }
     }
 
@@ -2151,7 +2260,7 @@ ecs_entity_t ecs_component_init(
     bool is_readonly = world->is_readonly;
     bool is_deferred = ecs_is_deferred(world);
     int32_t defer_count = 0;
-    ecs_vector_t *defer_queue = NULL;
+    ecs_defer_queue_t defer_queue = { 0 };
     ecs_stage_t *stage = NULL;
 
     /* If world is readonly or deferring is enabled, component registration can
@@ -2170,7 +2279,7 @@ ecs_entity_t ecs_component_init(
         defer_count = stage->defer;
         defer_queue = stage->defer_queue;
         stage->defer = 0;
-        stage->defer_queue = NULL;
+        stage->defer_queue = (ecs_defer_queue_t){ 0 };
     }
 
     ecs_entity_desc_t entity_desc = desc->entity;
@@ -2189,6 +2298,10 @@ ecs_entity_t ecs_component_init(
     EcsComponent *ptr = ecs_get_mut(world, result, EcsComponent, &added);
 
     if (added) {
+        /* Alignment may be larger than the size of the component, in which
+         * case the component arrays are aligned to it. */
+        ecs_assert(!(desc->alignment & (desc->alignment - 1)), 
+            ECS_INVALID_COMPONENT_ALIGNMENT, desc->entity.name);
         ptr->size = ecs_from_size_t(desc->size);
         ptr->alignment = ecs_from_size_t(desc->alignment);
     } else {
@@ -2213,6 +2326,7 @@ ecs_entity_t ecs_component_init(
         /* Restore readonly state / defer count */
         world->is_readonly = is_readonly;
         stage->defer = defer_count;
+        ecs_defer_fini(&stage->defer_queue);
         stage->defer_queue = defer_queue;
     }
 
@@ -2271,10 +2385,14 @@ ecs_entity_t ecs_type_init(
     ecs_type_t type = NULL;
     ecs_type_t normalized_type = NULL;
     
+    /* Type entities hand out the table type, so the tables must outlive
+     * empty table cleanup */
     if (table) {
+        table->flags |= EcsTableIsPinned;
         type = table->type;
     }
     if (normalized) {
+        normalized->flags |= EcsTableIsPinned;
         normalized_type = normalized->type;
     }
 
@@ -2826,6 +2944,19 @@ const void* ecs_get_id(
         return NULL;
     }
 
+    bool is_monitored;
+    int32_t row = ecs_record_to_row(r->row, &is_monitored);
+
+    /* Fast path for components, which don't need the id index */
+    if (id < ECS_HI_COMPONENT_ID) {
+        int32_t column = get_lo_column(table, id);
+        if (column != -1) {
+            return get_component_w_index(table, column, row);
+        }
+
+        return get_base_component_cached(world, table, id, NULL);
+    }
+
     ecs_id_record_t *idr = ecs_get_id_record(world, id);
     if (!idr) {
         return NULL;
@@ -2834,12 +2965,9 @@ const void* ecs_get_id(
     ecs_table_record_t *tr = ecs_map_get(idr->table_index, 
         ecs_table_record_t, table->id);
     if (!tr) {
-       return get_base_component(world, table, id, idr->table_index, NULL, 0);
+        return get_base_component_cached(world, table, id, idr->table_index);
     }
 
-    bool is_monitored;
-    int32_t row = ecs_record_to_row(r->row, &is_monitored);
-
     return get_component_w_index(table, tr->column, row);
 }
 
@@ -3065,6 +3193,12 @@ ecs_entity_t assign_ptr_w_id(
     /* This can no longer happen since we defer operations */
     ecs_assert(dst != NULL, ECS_INTERNAL_ERROR, NULL);
 
+    /* Remove the previous name of the entity from the name index */
+    bool is_name = id == ecs_id(EcsName);
+    if (is_name) {
+        ecs_name_index_remove(world, entity, dst);
+    }
+
     if (ptr) {
         ecs_entity_t real_id = ecs_get_typeid(world, id);
         const ecs_type_info_t *cdata = get_c_info(world, real_id);
@@ -3093,6 +3227,10 @@ ecs_entity_t assign_ptr_w_id(
         memset(dst, 0, size);
     }
 
+    if (is_name) {
+        ecs_name_index_add(world, entity, dst);
+    }
+
     ecs_table_mark_dirty(info.table, id);
 
     if (notify) {
@@ -3765,38 +3903,13 @@ void flush_bulk_new(
                 assign_ptr_w_id(world, ids[i], component, size, ptr, 
                     true, true);
             }
-            ecs_os_free(data);
         }
-        ecs_os_free(bulk_data);
     } else {
         int i, count = op->is._n.count;
         for (i = 0; i < count; i ++) {
             add_ids(world, ids[i], &op->components);
         }
     }
-
-    if (op->components.count > 1) {
-        ecs_os_free(op->components.array);
-    }
-
-    ecs_os_free(ids);
-}
-
-static
-void discard_op(
-    ecs_op_t * op)
-{
-    ecs_assert(op->kind != EcsOpBulkNew, ECS_INTERNAL_ERROR, NULL);
-
-    void *value = op->is._1.value;
-    if (value) {
-        ecs_os_free(value);
-    }
-
-    ecs_entity_t *components = op->components.array;
-    if (components) {
-        ecs_os_free(components);
-    }
 }
 
 static
@@ -3818,120 +3931,451 @@ bool valid_components(
     return true;
 }
 
-/* Leave safe section. Run all deferred commands. */
-bool ecs_defer_flush(
+static
+void flush_op(
     ecs_world_t *world,
-    ecs_stage_t *stage)
+    ecs_op_t *op)
 {
-    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
-    ecs_assert(stage != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_entity_t e = op->is._1.entity;
+    if (op->kind == EcsOpBulkNew) {
+        e = 0;
+    }
+
+    /* If entity is no longer alive, this could be because the queue
+    * contained both a delete and a subsequent add/remove/set which
+    * should be ignored. */
+    if (e && !ecs_is_alive(world, e) && ecs_eis_exists(world, e)) {
+        ecs_assert(op->kind != EcsOpNew && op->kind != EcsOpClone, 
+            ECS_INTERNAL_ERROR, NULL);
+        world->discard_count ++;
+        return;
+    }
 
-    if (!--stage->defer) {
-        /* Set to NULL. Processing deferred commands can cause additional
-         * commands to get enqueued (as result of reactive systems). Make sure
-         * that the original array is not reallocated, as this would complicate
-         * processing the queue. */
-        ecs_vector_t *defer_queue = stage->defer_queue;
-        stage->defer_queue = NULL;
-
-        if (defer_queue) {
-            ecs_op_t *ops = ecs_vector_first(defer_queue, ecs_op_t);
-            int32_t i, count = ecs_vector_count(defer_queue);
-            
-            for (i = 0; i < count; i ++) {
-                ecs_op_t *op = &ops[i];
-                ecs_entity_t e = op->is._1.entity;
-                if (op->kind == EcsOpBulkNew) {
-                    e = 0;
-                }
+    switch(op->kind) {
+    case EcsOpNew:
+    case EcsOpAdd:
+        if (valid_components(world, &op->components)) {
+            world->add_count ++;
+            add_ids(world, e, &op->components);
+        } else {
+            ecs_delete(world, e);
+        }
+        break;
+    case EcsOpRemove:
+        remove_ids(world, e, &op->components);
+        break;
+    case EcsOpClone:
+        ecs_clone(world, e, op->component, op->is._1.clone_value);
+        break;
+    case EcsOpSet:
+        assign_ptr_w_id(world, e, 
+            op->component, ecs_to_size_t(op->is._1.size), 
+            op->is._1.value, true, true);
+        break;
+    case EcsOpMut:
+        assign_ptr_w_id(world, e, 
+            op->component, ecs_to_size_t(op->is._1.size), 
+            op->is._1.value, true, false);
+        break;
+    case EcsOpModified:
+        ecs_modified_id(world, e, op->component);
+        break;
+    case EcsOpDelete: {
+        ecs_delete(world, e);
+        break;
+    }
+    case EcsOpEnable:
+        ecs_enable_component_w_id(
+            world, e, op->component, true);
+        break;
+    case EcsOpDisable:
+        ecs_enable_component_w_id(
+            world, e, op->component, false);
+        break;
+    case EcsOpClear:
+        ecs_clear(world, e);
+        break;
+    case EcsOpBulkNew:
+        flush_bulk_new(world, op);
+        break;
+    }
+}
 
-                /* If entity is no longer alive, this could be because the queue
-                * contained both a delete and a subsequent add/remove/set which
-                * should be ignored. */
-                if (e && !ecs_is_alive(world, e) && ecs_eis_exists(world, e)) {
-                    ecs_assert(op->kind != EcsOpNew && op->kind != EcsOpClone, 
-                        ECS_INTERNAL_ERROR, NULL);
-                    world->discard_count ++;
-                    discard_op(op);
-                    continue;
-                }
+/* Entity in a batch of deferred add/remove operations */
+typedef struct flush_batch_elem_t {
+    ecs_entity_t entity;
+    ecs_table_t *src_table;     /* Table of entity before batch */
+    ecs_table_t *dst_table;     /* Table of entity after batch */
+    int32_t id_count;           /* Number of ids added/removed for entity */
+    int32_t order;              /* Order in which entity was added to batch */
+} flush_batch_elem_t;
+
+typedef struct flush_batch_t {
+    ecs_vector_t *elems;        /* vector<flush_batch_elem_t> */
+    ecs_map_t *index;           /* map<entity, elem index> */
+} flush_batch_t;
+
+/* Only add/remove operations that don't need to be evaluated individually can
+ * be batched. */
+static
+bool op_is_batchable(
+    ecs_world_t *world,
+    ecs_op_t *op)
+{
+    if (op->kind != EcsOpNew && op->kind != EcsOpAdd && 
+        op->kind != EcsOpRemove) 
+    {
+        return false;
+    }
 
-                if (op->components.count == 1) {
-                    op->components.array = &op->component;
-                }
+    ecs_entity_t e = op->is._1.entity;
+    if (!ecs_is_alive(world, e) && ecs_eis_exists(world, e)) {
+        return false; /* Discarded */
+    }
 
-                switch(op->kind) {
-                case EcsOpNew:
-                case EcsOpAdd:
-                    if (valid_components(world, &op->components)) {
-                        world->add_count ++;
-                        add_ids(world, e, &op->components);
-                    } else {
-                        ecs_delete(world, e);
-                    }
-                    break;
-                case EcsOpRemove:
-                    remove_ids(world, e, &op->components);
-                    break;
-                case EcsOpClone:
-                    ecs_clone(world, e, op->component, op->is._1.clone_value);
-                    break;
-                case EcsOpSet:
-                    assign_ptr_w_id(world, e, 
-                        op->component, ecs_to_size_t(op->is._1.size), 
-                        op->is._1.value, true, true);
-                    break;
-                case EcsOpMut:
-                    assign_ptr_w_id(world, e, 
-                        op->component, ecs_to_size_t(op->is._1.size), 
-                        op->is._1.value, true, false);
-                    break;
-                case EcsOpModified:
-                    ecs_modified_id(world, e, op->component);
-                    break;
-                case EcsOpDelete: {
-                    ecs_delete(world, e);
-                    break;
-                }
-                case EcsOpEnable:
-                    ecs_enable_component_w_id(
-                        world, e, op->component, true);
-                    break;
-                case EcsOpDisable:
-                    ecs_enable_component_w_id(
-                        world, e, op->component, false);
-                    break;
-                case EcsOpClear:
-                    ecs_clear(world, e);
-                    break;
-                case EcsOpBulkNew:
-                    flush_bulk_new(world, op);
+    int32_t i, count = op->components.count;
+    ecs_entity_t *ids = op->components.array;
+    for (i = 0; i < count; i ++) {
+        /* Adding a case doesn't change the table of an entity */
+        if (ECS_HAS_ROLE(ids[i], CASE)) {
+            return false;
+        }
+    }
 
-                    /* Continue since flush_bulk_new is repsonsible for cleaning
-                    * up resources. */
-                    continue;
-                }
+    if (op->kind != EcsOpRemove && !valid_components(world, &op->components)) {
+        return false; /* Entity will be deleted */
+    }
 
-                if (op->components.count > 1) {
-                    ecs_os_free(op->components.array);
-                }
+    return true;
+}
+
+/* Add operation to batch. Returns false if the operation can't be added, in
+ * which case the batch should be flushed first. */
+static
+bool batch_op(
+    ecs_world_t *world,
+    flush_batch_t *batch,
+    ecs_op_t *op)
+{
+    ecs_entity_t e = op->is._1.entity;
+    flush_batch_elem_t *elem;
+
+    int32_t *index = ecs_map_get(batch->index, int32_t, e);
+    if (index) {
+        elem = ecs_vector_get(batch->elems, flush_batch_elem_t, *index);
+        if ((elem->id_count + op->components.count) >= ECS_MAX_ADD_REMOVE) {
+            return false;
+        }
+    } else {
+        int32_t count = ecs_vector_count(batch->elems);
+        ecs_record_t *r = ecs_eis_get(world, e);
+        elem = ecs_vector_add(&batch->elems, flush_batch_elem_t);
+        elem->entity = e;
+        elem->src_table = elem->dst_table = r ? r->table : NULL;
+        elem->id_count = 0;
+        elem->order = count;
+        ecs_map_set(batch->index, e, &count);
+    }
+
+    ecs_table_t *dst_table;
+    if (op->kind == EcsOpRemove) {
+        dst_table = ecs_table_traverse_remove(
+            world, elem->dst_table, &op->components, NULL);
+    } else {
+        world->add_count ++;
+        dst_table = ecs_table_traverse_add(
+            world, elem->dst_table, &op->components, NULL);
+    }
+
+    if (!dst_table) {
+        return false;
+    }
+
+    elem->dst_table = dst_table;
+    elem->id_count += op->components.count;
+
+    return true;
+}
+
+static
+int compare_batch_elem(
+    const void *ptr1,
+    const void *ptr2)
+{
+    const flush_batch_elem_t *e1 = ptr1, *e2 = ptr2;
+    uint64_t src_1 = e1->src_table ? e1->src_table->id : 0;
+    uint64_t src_2 = e2->src_table ? e2->src_table->id : 0;
+    if (src_1 != src_2) {
+        return (src_1 > src_2) - (src_1 < src_2);
+    }
+
+    uint64_t dst_1 = e1->dst_table->id, dst_2 = e2->dst_table->id;
+    if (dst_1 != dst_2) {
+        return (dst_1 > dst_2) - (dst_1 < dst_2);
+    }
+
+    return (e1->order > e2->order) - (e1->order < e2->order);
+}
+
+/* Get ids that are in one table but not in the other */
+static
+void table_diff(
+    ecs_table_t *src_table,
+    ecs_table_t *dst_table,
+    ecs_ids_t *added,
+    ecs_ids_t *removed)
+{
+    ecs_type_t src_type = src_table ? src_table->type : NULL;
+    ecs_type_t dst_type = dst_table->type;
+    ecs_entity_t *src_ids = ecs_vector_first(src_type, ecs_entity_t);
+    ecs_entity_t *dst_ids = ecs_vector_first(dst_type, ecs_entity_t);
+    int32_t i_src = 0, src_count = ecs_vector_count(src_type);
+    int32_t i_dst = 0, dst_count = ecs_vector_count(dst_type);
+
+    while (i_src < src_count || i_dst < dst_count) {
+        ecs_entity_t src_id = i_src < src_count ? src_ids[i_src] : 0;
+        ecs_entity_t dst_id = i_dst < dst_count ? dst_ids[i_dst] : 0;
+
+        if (src_id == dst_id) {
+            i_src ++;
+            i_dst ++;
+        } else if (!dst_id || (src_id && src_id < dst_id)) {
+            ecs_assert(removed->count < ECS_MAX_ADD_REMOVE, 
+                ECS_INVALID_PARAMETER, NULL);
+            removed->array[removed->count ++] = src_id;
+            i_src ++;
+        } else {
+            ecs_assert(added->count < ECS_MAX_ADD_REMOVE, 
+                ECS_INVALID_PARAMETER, NULL);
+            added->array[added->count ++] = dst_id;
+            i_dst ++;
+        }
+    }
+}
+
+/* Move entities that have the same source and destination table. Entities are
+ * appended to the destination table one after another, which allows running
+ * the add actions and monitors once for all moved entities. */
+static
+void bulk_move(
+    ecs_world_t *world,
+    flush_batch_elem_t *elems,
+    int32_t count)
+{
+    ecs_table_t *src_table = elems[0].src_table;
+    ecs_table_t *dst_table = elems[0].dst_table;
+
+    ecs_entity_t add_buffer[ECS_MAX_ADD_REMOVE];
+    ecs_entity_t remove_buffer[ECS_MAX_ADD_REMOVE];
+    ecs_ids_t added = { .array = add_buffer };
+    ecs_ids_t removed = { .array = remove_buffer };
+    table_diff(src_table, dst_table, &added, &removed);
+
+    int32_t i;
+    if (count == 1 || !dst_table->type) {
+        for (i = 0; i < count; i ++) {
+            ecs_entity_info_t info;
+            ecs_get_info(world, elems[i].entity, &info);
+            commit(world, elems[i].entity, &info, dst_table, &added, &removed, 
+                true);
+        }
+        return;
+    }
+
+    ecs_data_t *src_data = src_table ? ecs_table_get_data(src_table) : NULL;
+    ecs_data_t *dst_data = ecs_table_get_or_create_data(dst_table);
+    int32_t dst_start = ecs_table_data_count(dst_data);
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = elems[i].entity;
+        ecs_entity_info_t info;
+        ecs_get_info(world, e, &info);
+        ecs_assert(info.table == src_table, ECS_INTERNAL_ERROR, NULL);
+
+        ecs_record_t *record = info.record;
+        if (!record) {
+            record = ecs_eis_ensure(world, e);
+        }
+
+        if (src_table && removed.count && 
+            (src_table->flags & EcsTableHasRemoveActions)) 
+        {
+            ecs_run_monitors(world, dst_table, src_table->un_set_all, 
+                info.row, 1, dst_table->un_set_all);
+            ecs_run_remove_actions(
+                world, src_table, src_data, info.row, 1, &removed);
+        }
+
+        int32_t dst_row = ecs_table_append(
+            world, dst_table, dst_data, e, record, src_table == NULL);
+        ecs_assert(dst_row == dst_start + i, ECS_INTERNAL_ERROR, NULL);
+
+        record->table = dst_table;
+        record->row = ecs_row_to_record(dst_row, info.is_watched);
+
+        if (src_table) {
+            if (src_table->type) {
+                ecs_table_move(world, e, e, dst_table, dst_data, dst_row, 
+                    src_table, src_data, info.row, true);
+            }
+            ecs_table_delete(world, src_table, src_data, info.row, false);
+        }
 
-                if (op->is._1.value) {
-                    ecs_os_free(op->is._1.value);
-                }                  
+        if (info.is_watched) {
+            update_component_monitors(world, e, &added, &removed);
+        }
+    }
+
+    if (added.count && (dst_table->flags & EcsTableHasAddActions)) {
+        ecs_run_add_actions(world, dst_table, dst_data, dst_start, count, 
+            &added, src_table == NULL, true);
+    }
+
+    if (dst_table->flags & EcsTableHasMonitors) {
+        ecs_run_monitors(world, dst_table, dst_table->monitors, dst_start, 
+            count, src_table ? src_table->monitors : NULL);
+    }
+
+    if (src_table && removed.count && dst_table->flags & EcsTableHasBase) {
+        ecs_run_monitors(world, dst_table, src_table->on_set_override, 
+            dst_start, count, dst_table->on_set_override);
+    }
+}
+
+/* Move all entities in the batch to their destination tables. Entities that
+ * have the same source and destination table are moved together. */
+static
+void flush_batch(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    flush_batch_t *batch)
+{
+    int32_t i, start = 0, count = ecs_vector_count(batch->elems);
+    if (!count) {
+        return;
+    }
+
+    flush_batch_elem_t *elems = ecs_vector_first(
+        batch->elems, flush_batch_elem_t);
+    if (count > 1) {
+        qsort(elems, (size_t)count, sizeof(flush_batch_elem_t), 
+            compare_batch_elem);
+    }
+
+    /* Operations done by actions are deferred until all entities are moved, so
+     * that they can't move entities that are being processed */
+    ecs_defer_none(world, stage);
+
+    for (i = 1; i <= count; i ++) {
+        if (i == count || elems[i].src_table != elems[start].src_table ||
+            elems[i].dst_table != elems[start].dst_table) 
+        {
+            if (elems[start].src_table != elems[start].dst_table) {
+                bulk_move(world, &elems[start], i - start);
             }
+            start = i;
+        }
+    }
+
+    ecs_vector_clear(batch->elems);
+    ecs_map_clear(batch->index);
+
+    ecs_defer_flush(world, stage);
+}
+
+static
+void flush_batched(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_defer_queue_t *defer_queue)
+{
+    flush_batch_t batch = {
+        .index = ecs_map_new(int32_t, 0)
+    };
+
+    ecs_defer_chunk_t *chunk = NULL;
+    ecs_op_t *op = ecs_defer_next(defer_queue, &chunk, NULL);
+    if (op && op->components.count == 1) {
+        op->components.array = &op->component;
+    }
+    
+    while (op) {
+        ecs_op_t *next = ecs_defer_next(defer_queue, &chunk, op);
+        if (next && next->components.count == 1) {
+            next->components.array = &next->component;
+        }
 
-            if (stage->defer_queue) {
-                ecs_vector_free(stage->defer_queue);
+        /* Don't create a batch for a single operation */
+        if (op_is_batchable(world, op) && (ecs_vector_count(batch.elems) || 
+            (next && op_is_batchable(world, next)))) 
+        {
+            if (!batch_op(world, &batch, op)) {
+                flush_batch(world, stage, &batch);
+                flush_op(world, op);
             }
+        } else {
+            flush_batch(world, stage, &batch);
+            flush_op(world, op);
+        }
+
+        op = next;
+    }
+
+    flush_batch(world, stage, &batch);
 
-            /* Restore defer queue */
-            ecs_vector_clear(defer_queue);
-            stage->defer_queue = defer_queue;
+    ecs_vector_free(batch.elems);
+    ecs_map_free(batch.index);
+}
+
+/* Leave safe section. Run all deferred commands. */
+bool ecs_defer_flush(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(stage != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    if (!--stage->defer) {
+        /* Take the queue from the stage. Processing deferred commands can
+         * cause additional commands to get enqueued (as result of reactive
+         * systems). Make sure that these don't get added to the queue that is
+         * being processed. */
+        ecs_defer_queue_t defer_queue = stage->defer_queue;
+        stage->defer_queue = (ecs_defer_queue_t){ 0 };
+
+        if (defer_queue.count) {
+            if (world->defer_batching && defer_queue.count > 1) {
+                flush_batched(world, stage, &defer_queue);
+            } else {
+                ecs_defer_chunk_t *chunk = NULL;
+                ecs_op_t *op = NULL;
+                while ((op = ecs_defer_next(&defer_queue, &chunk, op))) {
+                    if (op->components.count == 1) {
+                        op->components.array = &op->component;
+                    }
+                    flush_op(world, op);
+                }
+            }
         }
 
+        /* Restore defer queue. Operations enqueued while flushing have been
+         * flushed by the ecs_defer_end that matched their ecs_defer_begin. */
+        ecs_assert(stage->defer_queue.count == 0, ECS_INTERNAL_ERROR, NULL);
+        ecs_defer_fini(&stage->defer_queue);
+        ecs_defer_reset(&defer_queue);
+        stage->defer_queue = defer_queue;
+
         return true;
     }
 
     return false;
 }
+
+void ecs_set_defer_batching(
+    ecs_world_t *world,
+    bool enable)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_PARAMETER, NULL);
+    world->defer_batching = enable;
+}
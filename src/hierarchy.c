@@ -92,71 +92,365 @@ ecs_entity_t name_to_id(
     return (ecs_entity_t)result;
 }
 
+/* Names are hashed byte by byte (FNV-1a), as ecs_hash reads whole words which
+ * can extend past the end of a string. */
 static
-ecs_entity_t find_child_in_table(
-    const ecs_table_t *table,
-    const char *name,
-    const char *symbol)
+uint64_t name_hash(
+    const char *name)
 {
-    /* If table doesn't have EcsName, then don't bother */
-    int32_t name_index = ecs_type_index_of(table->type, ecs_id(EcsName));
-    if (name_index == -1) {
-        return 0;
+    uint64_t hash = 14695981039346656037ull;
+    const unsigned char *ptr = (const unsigned char*)name;
+    unsigned char ch;
+    while ((ch = *ptr++)) {
+        hash ^= ch;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/* Get the name of an entity from its table. Returns NULL if the entity has no
+ * name or is not stored in a table. */
+static
+const EcsName* name_from_record(
+    const ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    ecs_record_t *r = ecs_eis_get(world, entity);
+    if (!r || !r->table) {
+        return NULL;
     }
 
+    ecs_table_t *table = r->table;
+    if (!(table->flags & EcsTableHasName)) {
+        return NULL;
+    }
+
+    int32_t column = ecs_type_index_of(table->type, ecs_id(EcsName));
+
     ecs_data_t *data = ecs_table_get_data(table);
     if (!data || !data->columns) {
-        return 0;
+        return NULL;
     }
 
-    int32_t i, count = ecs_vector_count(data->entities);
-    if (!count) {
-        return 0;
+    bool is_watched;
+    int32_t row = ecs_record_to_row(r->row, &is_watched);
+    ecs_vector_t *names = data->columns[column].data;
+    if (row < 0 || row >= ecs_vector_count(names)) {
+        return NULL;
+    }
+
+    return ecs_vector_get(names, EcsName, row);
+}
+
+static
+void name_index_add(
+    ecs_map_t **index_ptr,
+    uint64_t hash,
+    ecs_entity_t entity)
+{
+    if (!*index_ptr) {
+        *index_ptr = ecs_map_new(ecs_name_index_elem_t, 1);
+    }
+
+    ecs_name_index_elem_t *elem = ecs_map_ensure(
+        *index_ptr, ecs_name_index_elem_t, hash);
+
+    if (!elem->entity) {
+        elem->entity = entity;
+        return;
     }
 
-    ecs_column_t *column = &data->columns[name_index];
-    EcsName *names = ecs_vector_first(column->data, EcsName);
+    if (elem->entity == entity) {
+        return;
+    }
 
-    if (name) {
-        if (is_number(name)) {
-            return name_to_id(name);
+    int32_t i, count = ecs_vector_count(elem->collisions);
+    ecs_entity_t *collisions = ecs_vector_first(
+        elem->collisions, ecs_entity_t);
+    for (i = 0; i < count; i ++) {
+        if (collisions[i] == entity) {
+            return;
         }
- 
-        for (i = 0; i < count; i ++) {
-            const char *cur_name = names[i].value;
-            if (cur_name && !strcmp(cur_name, name)) {
-                return *ecs_vector_get(data->entities, ecs_entity_t, i);
-            }
-        }        
-    } else if (symbol) {
-        for (i = 0; i < count; i ++) {
-            const char *cur_name = names[i].symbol;
-            if (cur_name && !strcmp(cur_name, symbol)) {
-                return *ecs_vector_get(data->entities, ecs_entity_t, i);
-            }
-        }         
     }
 
-    return 0;
+    ecs_entity_t *e = ecs_vector_add(&elem->collisions, ecs_entity_t);
+    *e = entity;
+}
+
+static
+void name_index_remove(
+    ecs_map_t *index,
+    uint64_t hash,
+    ecs_entity_t entity)
+{
+    ecs_name_index_elem_t *elem = ecs_map_get(
+        index, ecs_name_index_elem_t, hash);
+    if (!elem) {
+        return;
+    }
+
+    if (elem->entity == entity) {
+        if (!ecs_vector_pop(elem->collisions, ecs_entity_t, &elem->entity)) {
+            ecs_vector_free(elem->collisions);
+            ecs_map_remove(index, hash);
+        }
+        return;
+    }
+
+    int32_t i, count = ecs_vector_count(elem->collisions);
+    ecs_entity_t *collisions = ecs_vector_first(
+        elem->collisions, ecs_entity_t);
+    for (i = 0; i < count; i ++) {
+        if (collisions[i] == entity) {
+            ecs_vector_remove(elem->collisions, ecs_entity_t, i);
+            break;
+        }
+    }
+}
+
+/* Add or remove a name from the name indices of the parents of a table. Tables
+ * without a ChildOf pair are indexed by the root, which uses (ChildOf, 0). */
+static
+void index_table_parents(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_entity_t entity,
+    uint64_t hash,
+    bool remove)
+{
+    int32_t i, count = ecs_vector_count(table->type);
+    ecs_id_t *ids = ecs_vector_first(table->type, ecs_id_t);
+    bool has_childof = false;
+
+    /* Pairs are stored at the end of the type, so only look at the ids at the
+     * end of the type that have a role. */
+    for (i = count - 1; i >= 0 && (ids[i] & ECS_ROLE_MASK); i --) {
+        ecs_id_t id = ids[i];
+        if (!ECS_HAS_RELATION(id, EcsChildOf)) {
+            continue;
+        }
+
+        has_childof = true;
+
+        ecs_id_record_t *r = ecs_get_id_record(world, 
+            ecs_pair(EcsChildOf, ECS_PAIR_OBJECT(id)));
+        if (!r) {
+            continue;
+        }
+
+        if (remove) {
+            name_index_remove(r->name_index, hash, entity);
+        } else {
+            name_index_add(&r->name_index, hash, entity);
+        }
+    }
+
+    if (!has_childof) {
+        ecs_id_record_t *r = ecs_get_id_record(world, 
+            ecs_pair(EcsChildOf, 0));
+        if (!r) {
+            return;
+        }
+
+        if (remove) {
+            name_index_remove(r->name_index, hash, entity);
+        } else {
+            name_index_add(&r->name_index, hash, entity);
+        }
+    }
 }
 
+/* Returns whether two tables have the same ChildOf pairs */
 static
-ecs_entity_t find_child(
+bool same_parents(
+    ecs_table_t *table_1,
+    ecs_table_t *table_2)
+{
+    int32_t i_1 = ecs_vector_count(table_1->type) - 1;
+    int32_t i_2 = ecs_vector_count(table_2->type) - 1;
+    ecs_id_t *ids_1 = ecs_vector_first(table_1->type, ecs_id_t);
+    ecs_id_t *ids_2 = ecs_vector_first(table_2->type, ecs_id_t);
+
+    do {
+        while (i_1 >= 0 && (ids_1[i_1] & ECS_ROLE_MASK) && 
+            !ECS_HAS_RELATION(ids_1[i_1], EcsChildOf)) 
+        {
+            i_1 --;
+        }
+        while (i_2 >= 0 && (ids_2[i_2] & ECS_ROLE_MASK) && 
+            !ECS_HAS_RELATION(ids_2[i_2], EcsChildOf)) 
+        {
+            i_2 --;
+        }
+
+        bool has_1 = i_1 >= 0 && (ids_1[i_1] & ECS_ROLE_MASK);
+        bool has_2 = i_2 >= 0 && (ids_2[i_2] & ECS_ROLE_MASK);
+        if (!has_1 || !has_2) {
+            return has_1 == has_2;
+        }
+
+        if (ECS_PAIR_OBJECT(ids_1[i_1]) != ECS_PAIR_OBJECT(ids_2[i_2])) {
+            return false;
+        }
+
+        i_1 --;
+        i_2 --;
+    } while (true);
+}
+
+static
+void index_name(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_entity_t entity,
+    const EcsName *name,
+    bool remove)
+{
+    if (name->value) {
+        index_table_parents(world, table, entity, name_hash(name->value), 
+            remove);
+    }
+
+    if (name->symbol) {
+        uint64_t hash = name_hash(name->symbol);
+        if (remove) {
+            name_index_remove(world->symbol_index, hash, entity);
+        } else {
+            name_index_add(&world->symbol_index, hash, entity);
+        }
+    }
+}
+
+void ecs_name_index_add(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    const EcsName *name)
+{
+    ecs_record_t *r = ecs_eis_get(world, entity);
+    ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(r->table != NULL, ECS_INTERNAL_ERROR, NULL);
+    index_name(world, r->table, entity, name, false);
+}
+
+void ecs_name_index_remove(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    const EcsName *name)
+{
+    ecs_record_t *r = ecs_eis_get(world, entity);
+    ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(r->table != NULL, ECS_INTERNAL_ERROR, NULL);
+    index_name(world, r->table, entity, name, true);
+}
+
+void ecs_name_index_table(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    int32_t row,
+    int32_t count)
+{
+    if (!(table->flags & EcsTableHasName) || !count) {
+        return;
+    }
+
+    int32_t column = ecs_type_index_of(table->type, ecs_id(EcsName));
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    EcsName *names = ecs_vector_first(data->columns[column].data, EcsName);
+
+    int32_t i;
+    for (i = row; i < row + count; i ++) {
+        index_name(world, table, entities[i], &names[i], false);
+    }
+}
+
+void ecs_name_index_move(
+    ecs_world_t *world,
+    ecs_table_t *dst_table,
+    ecs_table_t *src_table,
+    ecs_data_t *src_data,
+    int32_t row,
+    int32_t count)
+{
+    if (!(src_table->flags & EcsTableHasName) || !count || world->is_fini) {
+        return;
+    }
+
+    bool dst_has_name = dst_table && (dst_table->flags & EcsTableHasName);
+    if (dst_has_name && same_parents(dst_table, src_table)) {
+        return;
+    }
+
+    int32_t column = ecs_type_index_of(src_table->type, ecs_id(EcsName));
+    ecs_entity_t *entities = ecs_vector_first(src_data->entities, ecs_entity_t);
+    EcsName *names = ecs_vector_first(src_data->columns[column].data, EcsName);
+
+    int32_t i;
+    for (i = row; i < row + count; i ++) {
+        if (!dst_has_name) {
+            index_name(world, src_table, entities[i], &names[i], true);
+        } else if (names[i].value) {
+            /* Symbols don't depend on the parent, so only move the name */
+            uint64_t hash = name_hash(names[i].value);
+            index_table_parents(world, src_table, entities[i], hash, true);
+            index_table_parents(world, dst_table, entities[i], hash, false);
+        }
+    }
+}
+
+void ecs_name_index_free(
+    ecs_map_t *index)
+{
+    ecs_map_iter_t it = ecs_map_iter(index);
+    ecs_name_index_elem_t *elem;
+    while ((elem = ecs_map_next(&it, ecs_name_index_elem_t, NULL))) {
+        ecs_vector_free(elem->collisions);
+    }
+    ecs_map_free(index);
+}
+
+/* Find entity with name in index. Entities in the index are checked against
+ * their current name and parent, as the index may contain entities that have
+ * been renamed, moved or deleted since they were added. */
+static
+ecs_entity_t find_in_index(
     const ecs_world_t *world,
-    ecs_entity_t parent,
-    const char *symbol)
-{        
-    ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INTERNAL_ERROR, NULL);
+    const ecs_map_t *index,
+    const ecs_map_t *table_index,
+    const char *name,
+    bool symbol)
+{
+    ecs_name_index_elem_t *elem = ecs_map_get(
+        index, ecs_name_index_elem_t, name_hash(name));
+    if (!elem) {
+        return 0;
+    }
 
-    (void)parent;
-    
-    ecs_sparse_each(world->store.tables, ecs_table_t, table, {
-        ecs_entity_t result = find_child_in_table(table, NULL, symbol);
-        if (result) {
-            return result;
+    ecs_entity_t *collisions = ecs_vector_first(
+        elem->collisions, ecs_entity_t);
+    int32_t i, count = ecs_vector_count(elem->collisions);
+
+    for (i = -1; i < count; i ++) {
+        ecs_entity_t e = i == -1 ? elem->entity : collisions[i];
+        const EcsName *cur = name_from_record(world, e);
+        if (!cur) {
+            continue;
         }
-    });    
+
+        const char *cur_name = symbol ? cur->symbol : cur->value;
+        if (!cur_name || strcmp(cur_name, name)) {
+            continue;
+        }
+
+        if (table_index) {
+            ecs_table_t *table = ecs_eis_get(world, e)->table;
+            if (!ecs_map_get(table_index, ecs_table_record_t, table->id)) {
+                continue;
+            }
+        }
+
+        return e;
+    }
 
     return 0;
 }
@@ -278,21 +572,17 @@ ecs_entity_t ecs_lookup_child(
 {
     ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
     world = ecs_get_world(world);
-    ecs_entity_t result = 0;
 
     ecs_id_record_t *r = ecs_get_id_record(world, ecs_pair(EcsChildOf, parent));
-    if (r && r->table_index) {        
-        ecs_map_iter_t it = ecs_map_iter(r->table_index);
-        ecs_table_record_t *tr;
-        while ((tr = ecs_map_next(&it, ecs_table_record_t, NULL))) {
-            result = find_child_in_table(tr->table, name, NULL);
-            if (result) {
-                return result;
-            }            
-        }
+    if (!r || !r->name_index) {
+        return 0;
+    }
+
+    if (is_number(name)) {
+        return name_to_id(name);
     }
 
-    return result;
+    return find_in_index(world, r->name_index, r->table_index, name, false);
 }
 
 ecs_entity_t ecs_lookup(
@@ -333,7 +623,7 @@ ecs_entity_t ecs_lookup_symbol(
         return name_to_id(name);
     }   
     
-    return find_child(world, 0, name);
+    return find_in_index(world, world->symbol_index, NULL, name, true);
 }
 
 ecs_entity_t ecs_lookup_path_w_sep(
@@ -110,6 +110,37 @@ void* ecs_term_w_size(
     return get_term(it, ecs_from_size_t(size), term, 0);
 }
 
+bool ecs_terms_w_size(
+    const ecs_iter_t *it,
+    int32_t count,
+    const size_t *sizes,
+    void **ptrs_out)
+{
+    ecs_assert(count <= it->column_count, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!count || ptrs_out != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!count || it->table->columns != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    int32_t *columns = it->table->columns;
+    bool is_shared = false;
+    int32_t i;
+
+    for (i = 0; i < count; i ++) {
+        ecs_size_t size = sizes ? ecs_from_size_t(sizes[i]) : 0;
+        int32_t table_column = columns[i];
+
+        if (table_column > 0) {
+            ptrs_out[i] = get_owned_column_ptr(it, size, table_column, 0);
+        } else if (table_column < 0) {
+            ptrs_out[i] = (void*)get_shared_column(it, size, table_column);
+            is_shared = true;
+        } else {
+            ptrs_out[i] = NULL;
+        }
+    }
+
+    return is_shared;
+}
+
 bool ecs_term_is_owned(
     const ecs_iter_t *it,
     int32_t term)
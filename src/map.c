@@ -1,5 +1,10 @@
 #include "private_api.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ECS_MAP_SSE2
+#endif
+
 /* The ratio used to determine whether the map should rehash. If
  * (element_count * LOAD_FACTOR) > bucket_count, bucket count is increased. */
 #define LOAD_FACTOR (1.5f)
@@ -7,17 +12,26 @@
 #define GET_ELEM(array, elem_size, index) \
     ECS_OFFSET(array, (elem_size) * (index))
 
-typedef struct ecs_bucket_t {
-    ecs_map_key_t *keys;    /* Array with keys */
-    void *payload;          /* Payload array */
-    int32_t count;          /* Number of elements in bucket */
-} ecs_bucket_t;
+/* Number of control bytes that are matched at the same time */
+#define GROUP_WIDTH (16)
+
+/* Control byte values. Occupied slots store the lower 7 bits of the hash, so
+ * that most mismatches are filtered out before a key is compared. */
+#define CTRL_EMPTY ((int8_t)-128)   /* Slot is free, stops probing */
+#define CTRL_DELETED ((int8_t)-2)   /* Slot is free, but doesn't stop probing */
+#define CTRL_SENTINEL ((int8_t)-1)  /* Padding for maps smaller than a group */
+
+/* Bitmask with one bit per control byte in a group */
+typedef uint32_t ecs_group_mask_t;
 
 struct ecs_map_t {
-    ecs_bucket_t *buckets;
+    int8_t *ctrl;           /* Control bytes, one per slot */
+    ecs_map_key_t *keys;    /* Array with keys */
+    void *payload;          /* Payload array */
     int32_t elem_size;
-    int32_t bucket_count;
-    int32_t count;
+    int32_t bucket_count;   /* Number of slots, always a power of 2 */
+    int32_t count;          /* Number of elements in map */
+    int32_t deleted;        /* Number of slots marked as deleted */
 };
 
 /* Get bucket count for number of elements */
@@ -28,218 +42,309 @@ int32_t get_bucket_count(
     return ecs_next_pow_of_2((int32_t)((float)element_count * LOAD_FACTOR));
 }
 
-/* Get bucket index for provided map key */
+/* Hash that selects the slot where probing starts. Keys are often small and
+ * sequential (table ids, component ids) so the lower bits are used as is,
+ * which keeps sequential keys in sequential slots. The upper bits are folded
+ * in so that pairs with the same object don't start in the same slot. */
 static
-int32_t get_bucket_id(
-    int32_t bucket_count,
-    ecs_map_key_t key) 
+uint32_t hash_slot(
+    ecs_map_key_t key)
 {
-    ecs_assert(bucket_count > 0, ECS_INTERNAL_ERROR, NULL);
-    int32_t result = (int32_t)(key & ((uint64_t)bucket_count - 1));
-    ecs_assert(result < INT32_MAX, ECS_INTERNAL_ERROR, NULL);
-    return result;
+    return (uint32_t)(key ^ (key >> 32));
 }
 
-/* Get bucket for key */
+/* Hash stored in the control byte. This uses the upper bits of a
+ * multiplicative hash, which are independent from the slot hash. */
 static
-ecs_bucket_t* get_bucket(
-    const ecs_map_t *map,
+int8_t hash_ctrl(
     ecs_map_key_t key)
 {
-    int32_t bucket_count = map->bucket_count;
-    if (!bucket_count) {
-        return NULL;
+    return (int8_t)((key * 0x9E3779B97F4A7C15ull) >> 57);
+}
+
+/* Maps that fit in a single group are probed with one group load. Larger maps
+ * store a copy of the first group after the last slot, so that a group can
+ * always be loaded from any slot without wrapping. */
+static
+bool is_single_group(
+    int32_t bucket_count)
+{
+    return bucket_count <= GROUP_WIDTH;
+}
+
+static
+int32_t ctrl_size(
+    int32_t bucket_count)
+{
+    if (is_single_group(bucket_count)) {
+        return GROUP_WIDTH;
+    } else {
+        return bucket_count + GROUP_WIDTH;
     }
+}
 
-    int32_t bucket_id = get_bucket_id(bucket_count, key);
-    ecs_assert(bucket_id < bucket_count, ECS_INTERNAL_ERROR, NULL);
+static
+ecs_size_t keys_offset(
+    int32_t bucket_count)
+{
+    return ECS_ALIGN(ctrl_size(bucket_count), 16);
+}
 
-    return &map->buckets[bucket_id];
+static
+ecs_size_t payload_offset(
+    int32_t bucket_count)
+{
+    return ECS_ALIGN(keys_offset(bucket_count) + KEY_SIZE * bucket_count, 16);
 }
 
-/* Ensure that map has at least new_count buckets */
 static
-void ensure_buckets(
-    ecs_map_t *map,
-    int32_t new_count)
+ecs_size_t alloc_size(
+    int32_t bucket_count,
+    ecs_size_t elem_size)
 {
-    int32_t bucket_count = map->bucket_count;
-    new_count = ecs_next_pow_of_2(new_count);
-    if (new_count && new_count > bucket_count) {
-        map->buckets = ecs_os_realloc(map->buckets, new_count * ECS_SIZEOF(ecs_bucket_t));
-        map->bucket_count = new_count;
+    return payload_offset(bucket_count) + elem_size * bucket_count;
+}
 
-        ecs_os_memset(
-            ECS_OFFSET(map->buckets, bucket_count * ECS_SIZEOF(ecs_bucket_t)), 
-            0, (new_count - bucket_count) * ECS_SIZEOF(ecs_bucket_t));
+/* Get index of the first set bit in the mask */
+static
+int32_t mask_first(
+    ecs_group_mask_t mask)
+{
+    ecs_assert(mask != 0, ECS_INTERNAL_ERROR, NULL);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int32_t result = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        result ++;
     }
+    return result;
+#endif
 }
 
-/* Free contents of bucket */
+/* Return bits for control bytes in group that are equal to value */
 static
-void clear_bucket(
-    ecs_bucket_t *bucket)
+ecs_group_mask_t group_match(
+    const int8_t *group,
+    int8_t value)
 {
-    ecs_os_free(bucket->keys);
-    ecs_os_free(bucket->payload);
-    bucket->keys = NULL;
-    bucket->payload = NULL;
-    bucket->count = 0;
+#ifdef ECS_MAP_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    __m128i match = _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value));
+    return (ecs_group_mask_t)_mm_movemask_epi8(match);
+#else
+    ecs_group_mask_t result = 0;
+    int32_t i;
+    for (i = 0; i < GROUP_WIDTH; i ++) {
+        result |= (ecs_group_mask_t)(group[i] == value) << i;
+    }
+    return result;
+#endif
 }
 
-/* Clear all buckets */
+/* Return bits for control bytes in group that are empty or deleted */
 static
-void clear_buckets(
-    ecs_map_t *map)
+ecs_group_mask_t group_match_free(
+    const int8_t *group)
 {
-    ecs_bucket_t *buckets = map->buckets;
-    int32_t i, count = map->bucket_count;
-    for (i = 0; i < count; i ++) {
-        clear_bucket(&buckets[i]);
+#ifdef ECS_MAP_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    __m128i match = _mm_cmpgt_epi8(_mm_set1_epi8(CTRL_SENTINEL), ctrl);
+    return (ecs_group_mask_t)_mm_movemask_epi8(match);
+#else
+    ecs_group_mask_t result = 0;
+    int32_t i;
+    for (i = 0; i < GROUP_WIDTH; i ++) {
+        result |= (ecs_group_mask_t)(group[i] < CTRL_SENTINEL) << i;
     }
-    ecs_os_free(buckets);
-    map->buckets = NULL;
-    map->bucket_count = 0;
+    return result;
+#endif
 }
 
-/* Find or create bucket for specified key */
+/* Set control byte, and its copy if the slot is in the first group */
 static
-ecs_bucket_t* ensure_bucket(
+void set_ctrl(
     ecs_map_t *map,
-    ecs_map_key_t key)
+    int32_t index,
+    int8_t value)
 {
-    if (!map->bucket_count) {
-        ensure_buckets(map, 2);
+    int32_t bucket_count = map->bucket_count;
+    map->ctrl[index] = value;
+    if (!is_single_group(bucket_count) && index < GROUP_WIDTH) {
+        map->ctrl[bucket_count + index] = value;
     }
-
-    int32_t bucket_id = get_bucket_id(map->bucket_count, key);
-    ecs_assert(bucket_id >= 0, ECS_INTERNAL_ERROR, NULL);
-    return &map->buckets[bucket_id];
 }
 
-/* Add element to bucket */
+/* Find slot for key, return -1 if key is not in map */
 static
-int32_t add_to_bucket(
-    ecs_bucket_t *bucket,
-    ecs_size_t elem_size,
-    ecs_map_key_t key,
-    const void *payload)
+int32_t find_slot(
+    const ecs_map_t *map,
+    ecs_map_key_t key)
 {
-    int32_t index = bucket->count ++;
-    int32_t bucket_count = index + 1;
+    int32_t bucket_count = map->bucket_count;
+    if (!bucket_count) {
+        return -1;
+    }
 
-    bucket->keys = ecs_os_realloc(bucket->keys, KEY_SIZE * bucket_count);
-    bucket->payload = ecs_os_realloc(bucket->payload, elem_size * bucket_count);
-    bucket->keys[index] = key;
+    const int8_t *ctrl = map->ctrl;
+    const ecs_map_key_t *keys = map->keys;
+    int8_t h = hash_ctrl(key);
+    int32_t mask = bucket_count - 1;
+    int32_t pos = (int32_t)(hash_slot(key) & (uint32_t)mask), step = 0;
+    bool single_group = is_single_group(bucket_count);
+
+    /* Keys are usually stored in their home slot, which can be tested without
+     * loading the group */
+    if (ctrl[pos] == h && keys[pos] == key) {
+        return pos;
+    }
 
-    if (payload) {
-        void *elem = GET_ELEM(bucket->payload, elem_size, index);
-        ecs_os_memcpy(elem, payload, elem_size);
+    if (single_group) {
+        pos = 0;
+    } else if (ctrl[pos] == CTRL_EMPTY) {
+        /* Probing stops at the first group with an empty slot, which would be
+         * the group that starts at the home slot */
+        return -1;
     }
 
-    return index;
+    do {
+        const int8_t *group = &ctrl[pos];
+        ecs_group_mask_t match = group_match(group, h);
+        while (match) {
+            int32_t index = (pos + mask_first(match)) & mask;
+            if (keys[index] == key) {
+                return index;
+            }
+            match &= match - 1;
+        }
+
+        if (single_group || group_match(group, CTRL_EMPTY)) {
+            return -1;
+        }
+
+        step += GROUP_WIDTH;
+        pos = (pos + step) & mask;
+    } while (true);
 }
 
-/*  Remove element from bucket */
+/* Find empty or deleted slot where key can be inserted */
 static
-void remove_from_bucket(
-    ecs_bucket_t *bucket,
-    ecs_size_t elem_size,
-    ecs_map_key_t key,
-    int32_t index)
+int32_t find_free_slot(
+    const ecs_map_t *map,
+    ecs_map_key_t key)
 {
-    (void)key;
-
-    ecs_assert(bucket->count != 0, ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(index < bucket->count, ECS_INTERNAL_ERROR, NULL);
-    
-    int32_t bucket_count = -- bucket->count;
-
-    if (index != bucket->count) {
-        ecs_assert(key == bucket->keys[index], ECS_INTERNAL_ERROR, NULL);
-        bucket->keys[index] = bucket->keys[bucket_count];
+    int32_t bucket_count = map->bucket_count;
+    ecs_assert(bucket_count != 0, ECS_INTERNAL_ERROR, NULL);
 
-        ecs_map_key_t *elem = GET_ELEM(bucket->payload, elem_size, index);
-        ecs_map_key_t *last_elem = GET_ELEM(bucket->payload, elem_size, bucket->count);
+    const int8_t *ctrl = map->ctrl;
+    int32_t mask = bucket_count - 1;
+    int32_t pos = (int32_t)(hash_slot(key) & (uint32_t)mask), step = 0;
 
-        ecs_os_memcpy(elem, last_elem, elem_size);
+    /* Prefer the home slot, so that a lookup can find the key there */
+    if (ctrl[pos] < CTRL_SENTINEL) {
+        return pos;
     }
-}
 
-/* Get payload pointer for key from bucket */
-static
-void* get_from_bucket(
-    ecs_bucket_t *bucket,
-    ecs_map_key_t key,
-    ecs_size_t elem_size)
-{
-    ecs_map_key_t *keys = bucket->keys;
-    int32_t i, count = bucket->count;
+    if (is_single_group(bucket_count)) {
+        pos = 0;
+    }
 
-    for (i = 0; i < count; i ++) {
-        if (keys[i] == key) {
-            return GET_ELEM(bucket->payload, elem_size, i);
+    do {
+        ecs_group_mask_t match = group_match_free(&ctrl[pos]);
+        if (match) {
+            return (pos + mask_first(match)) & mask;
         }
-    }
-    return NULL;
+
+        /* Load factor guarantees that a free slot exists */
+        ecs_assert(!is_single_group(bucket_count), ECS_INTERNAL_ERROR, NULL);
+
+        step += GROUP_WIDTH;
+        pos = (pos + step) & mask;
+    } while (true);
 }
 
-/* Grow number of buckets */
+/* Reallocate slots and reinsert elements. This also drops deleted slots. */
 static
 void rehash(
     ecs_map_t *map,
     int32_t bucket_count)
 {
     ecs_assert(bucket_count != 0, ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(bucket_count > map->bucket_count, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(bucket_count >= map->bucket_count, ECS_INTERNAL_ERROR, NULL);
 
     ecs_size_t elem_size = map->elem_size;
+    int8_t *old_ctrl = map->ctrl;
+    ecs_map_key_t *old_keys = map->keys;
+    void *old_payload = map->payload;
+    int32_t i, old_bucket_count = map->bucket_count;
+
+    int8_t *ctrl = ecs_os_malloc(alloc_size(bucket_count, elem_size));
+    ecs_assert(ctrl != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    ecs_os_memset(ctrl, CTRL_EMPTY, ctrl_size(bucket_count));
+    if (is_single_group(bucket_count)) {
+        ecs_os_memset(&ctrl[bucket_count], CTRL_SENTINEL,
+            GROUP_WIDTH - bucket_count);
+    }
 
-    ensure_buckets(map, bucket_count);
+    map->ctrl = ctrl;
+    map->keys = ECS_OFFSET(ctrl, keys_offset(bucket_count));
+    map->payload = ECS_OFFSET(ctrl, payload_offset(bucket_count));
+    map->bucket_count = bucket_count;
+    map->deleted = 0;
 
-    ecs_bucket_t *buckets = map->buckets;
-    ecs_assert(buckets != NULL, ECS_INTERNAL_ERROR, NULL);
-    
-    int32_t bucket_id;
+    for (i = 0; i < old_bucket_count; i ++) {
+        if (old_ctrl[i] < 0) {
+            continue;
+        }
 
-    /* Iterate backwards as elements could otherwise be moved to existing
-        * buckets which could temporarily cause the number of elements in a
-        * bucket to exceed BUCKET_COUNT. */
-    for (bucket_id = bucket_count - 1; bucket_id >= 0; bucket_id --) {
-        ecs_bucket_t *bucket = &buckets[bucket_id];
+        ecs_map_key_t key = old_keys[i];
+        int32_t index = find_free_slot(map, key);
+        set_ctrl(map, index, old_ctrl[i]);
+        map->keys[index] = key;
+        ecs_os_memcpy(GET_ELEM(map->payload, elem_size, index),
+            GET_ELEM(old_payload, elem_size, i), elem_size);
+    }
 
-        int i, count = bucket->count;
-        ecs_map_key_t *key_array = bucket->keys;
-        void *payload_array = bucket->payload;
+    ecs_os_free(old_ctrl);
+}
 
-        for (i = 0; i < count; i ++) {
-            ecs_map_key_t key = key_array[i];
-            void *elem = GET_ELEM(payload_array, elem_size, i);
-            int32_t new_bucket_id = get_bucket_id(bucket_count, key);
+/* Insert key that is not yet in the map, return pointer to its payload */
+static
+void* insert_key(
+    ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    int32_t count = map->count;
+    int32_t bucket_count = map->bucket_count;
 
-            if (new_bucket_id != bucket_id) {
-                ecs_bucket_t *new_bucket = &buckets[new_bucket_id];
+    /* Deleted slots count towards the load, as they don't end a probe */
+    if (!bucket_count) {
+        rehash(map, ECS_MAX(2, get_bucket_count(count + 1)));
+    } else if (get_bucket_count(count + map->deleted + 1) > bucket_count) {
+        rehash(map, ECS_MAX(bucket_count, get_bucket_count(count + 1)));
+    }
 
-                add_to_bucket(new_bucket, elem_size, key, elem);
-                remove_from_bucket(bucket, elem_size, key, i);
+    int32_t index = find_free_slot(map, key);
+    if (map->ctrl[index] == CTRL_DELETED) {
+        map->deleted --;
+    }
 
-                count --;
-                i --;
-            }
-        }
+    set_ctrl(map, index, hash_ctrl(key));
+    map->keys[index] = key;
+    map->count ++;
 
-        if (!bucket->count) {
-            clear_bucket(bucket);
-        }
-    }
+    return GET_ELEM(map->payload, map->elem_size, index);
 }
 
 ecs_map_t* _ecs_map_new(
     ecs_size_t elem_size,
-    ecs_size_t alignment, 
+    ecs_size_t alignment,
     int32_t element_count)
 {
     (void)alignment;
+    ecs_assert(alignment <= 16, ECS_INVALID_PARAMETER, NULL);
 
     ecs_map_t *result = ecs_os_calloc(ECS_SIZEOF(ecs_map_t) * 1);
     ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
@@ -249,7 +354,9 @@ ecs_map_t* _ecs_map_new(
     result->count = 0;
     result->elem_size = elem_size;
 
-    ensure_buckets(result, bucket_count);
+    if (bucket_count) {
+        rehash(result, bucket_count);
+    }
 
     return result;
 }
@@ -258,7 +365,7 @@ void ecs_map_free(
     ecs_map_t *map)
 {
     if (map) {
-        clear_buckets(map);
+        ecs_os_free(map->ctrl);
         ecs_os_free(map);
     }
 }
@@ -276,12 +383,12 @@ void* _ecs_map_get(
 
     ecs_assert(elem_size == map->elem_size, ECS_INVALID_PARAMETER, NULL);
 
-    ecs_bucket_t * bucket = get_bucket(map, key);
-    if (!bucket) {
+    int32_t index = find_slot(map, key);
+    if (index == -1) {
         return NULL;
     }
 
-    return get_from_bucket(bucket, key, elem_size);
+    return GET_ELEM(map->payload, elem_size, index);
 }
 
 void* _ecs_map_get_ptr(
@@ -321,30 +428,19 @@ void* _ecs_map_set(
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
     ecs_assert(elem_size == map->elem_size, ECS_INVALID_PARAMETER, NULL);
 
-    ecs_bucket_t *bucket = ensure_bucket(map, key);
-    ecs_assert(bucket != NULL, ECS_INTERNAL_ERROR, NULL);
-
-    void *elem = get_from_bucket(bucket, key, elem_size);
-    if (!elem) {
-        int32_t index = add_to_bucket(bucket, elem_size, key, payload);
-        
-        int32_t map_count = ++map->count;
-        int32_t target_bucket_count = get_bucket_count(map_count);
-        int32_t map_bucket_count = map->bucket_count;
-
-        if (target_bucket_count > map_bucket_count) {
-            rehash(map, target_bucket_count);
-            bucket = ensure_bucket(map, key);
-            return get_from_bucket(bucket, key, elem_size);
-        } else {
-            return GET_ELEM(bucket->payload, elem_size, index);
-        }       
+    void *elem;
+    int32_t index = find_slot(map, key);
+    if (index == -1) {
+        elem = insert_key(map, key);
     } else {
-        if (payload) {
-            ecs_os_memcpy(elem, payload, elem_size);
-        }
-        return elem;
+        elem = GET_ELEM(map->payload, elem_size, index);
+    }
+
+    if (payload) {
+        ecs_os_memcpy(elem, payload, elem_size);
     }
+
+    return elem;
 }
 
 void ecs_map_remove(
@@ -353,18 +449,23 @@ void ecs_map_remove(
 {
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
 
-    ecs_bucket_t * bucket = get_bucket(map, key);
-    if (!bucket) {
+    int32_t index = find_slot(map, key);
+    if (index == -1) {
         return;
     }
 
-    int32_t i, bucket_count = bucket->count;
-    for (i = 0; i < bucket_count; i ++) {
-        if (bucket->keys[i] == key) {
-            remove_from_bucket(bucket, map->elem_size, key, i);
-            map->count --;
-        }
-    } 
+    /* A single group map is always probed with one load, so a slot can be
+     * emptied. In larger maps the slot can be in the middle of a probe for
+     * another key, so it has to be marked as deleted. Elements are never
+     * moved, which makes it safe to remove elements while iterating. */
+    if (is_single_group(map->bucket_count)) {
+        set_ctrl(map, index, CTRL_EMPTY);
+    } else {
+        set_ctrl(map, index, CTRL_DELETED);
+        map->deleted ++;
+    }
+
+    map->count --;
 }
 
 int32_t ecs_map_count(
@@ -383,8 +484,13 @@ void ecs_map_clear(
     ecs_map_t *map)
 {
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
-    clear_buckets(map);
+    ecs_os_free(map->ctrl);
+    map->ctrl = NULL;
+    map->keys = NULL;
+    map->payload = NULL;
+    map->bucket_count = 0;
     map->count = 0;
+    map->deleted = 0;
 }
 
 ecs_map_iter_t ecs_map_iter(
@@ -392,7 +498,6 @@ ecs_map_iter_t ecs_map_iter(
 {
     return (ecs_map_iter_t){
         .map = map,
-        .bucket = NULL,
         .bucket_index = 0,
         .element_index = 0
     };
@@ -407,42 +512,28 @@ void* _ecs_map_next(
     if (!map) {
         return NULL;
     }
-    
+
     ecs_assert(!elem_size || elem_size == map->elem_size, ECS_INVALID_PARAMETER, NULL);
- 
-    ecs_bucket_t *bucket = iter->bucket;
-    int32_t element_index = iter->element_index;
-    elem_size = map->elem_size;
 
-    do {
-        if (!bucket) {
-            int32_t bucket_index = iter->bucket_index;
-            ecs_bucket_t *buckets = map->buckets;
-            if (bucket_index < map->bucket_count) {
-                bucket = &buckets[bucket_index];
-                iter->bucket = bucket;
-
-                element_index = 0;
-                iter->element_index = 0;
-            } else {
-                return NULL;
-            }
-        }
+    /* The iterator uses bucket_index as slot index */
+    const int8_t *ctrl = map->ctrl;
+    int32_t index = iter->bucket_index, bucket_count = map->bucket_count;
+    while (index < bucket_count && ctrl[index] < 0) {
+        index ++;
+    }
+
+    if (index >= bucket_count) {
+        iter->bucket_index = bucket_count;
+        return NULL;
+    }
+
+    iter->bucket_index = index + 1;
 
-        if (element_index < bucket->count) {
-            iter->element_index = element_index + 1;
-            break;
-        } else {
-            bucket = NULL;
-            iter->bucket_index ++;
-        }
-    } while (true);
-    
     if (key_out) {
-        *key_out = bucket->keys[element_index];
+        *key_out = map->keys[index];
     }
 
-    return GET_ELEM(bucket->payload, elem_size, element_index);
+    return GET_ELEM(map->payload, map->elem_size, index);
 }
 
 void* _ecs_map_next_ptr(
@@ -458,7 +549,7 @@ void* _ecs_map_next_ptr(
 }
 
 void ecs_map_grow(
-    ecs_map_t *map, 
+    ecs_map_t *map,
     int32_t element_count)
 {
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
@@ -471,19 +562,19 @@ void ecs_map_grow(
 }
 
 void ecs_map_set_size(
-    ecs_map_t *map, 
+    ecs_map_t *map,
     int32_t element_count)
-{    
+{
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
     int32_t bucket_count = get_bucket_count(element_count);
 
-    if (bucket_count) {
+    if (bucket_count > map->bucket_count) {
         rehash(map, bucket_count);
     }
 }
 
 void ecs_map_memory(
-    ecs_map_t *map, 
+    ecs_map_t *map,
     int32_t *allocd,
     int32_t *used)
 {
@@ -496,13 +587,8 @@ void ecs_map_memory(
     if (allocd) {
         *allocd += ECS_SIZEOF(ecs_map_t);
 
-        int i, bucket_count = map->bucket_count;
-        for (i = 0; i < bucket_count; i ++) {
-            ecs_bucket_t *bucket = &map->buckets[i];
-            *allocd += KEY_SIZE * bucket->count;
-            *allocd += map->elem_size * bucket->count;
+        if (map->bucket_count) {
+            *allocd += alloc_size(map->bucket_count, map->elem_size);
         }
-
-        *allocd += ECS_SIZEOF(ecs_bucket_t) * bucket_count;
     }
 }
@@ -12,6 +12,9 @@ static ECS_CTOR(EcsPipelineQuery, ptr, {
 
 static ECS_DTOR(EcsPipelineQuery, ptr, {
     ecs_vector_free(ptr->ops);
+    ecs_vector_free(ptr->systems);
+    ecs_vector_free(ptr->levels);
+    ecs_vector_free(ptr->schedule);
 })
 
 static
@@ -213,6 +216,145 @@ bool check_term(
     return false;
 }
 
+/* Active system in the operation that is being built */
+typedef struct op_system_t {
+    int32_t index;              /* Index in systems vector */
+    int32_t level;              /* Level in operation */
+    ecs_filter_t *filter;       /* System filter */
+} op_system_t;
+
+static
+bool term_reads(
+    ecs_term_t *term)
+{
+    return term->oper != EcsNot && term->inout != EcsOut;
+}
+
+static
+bool term_writes(
+    ecs_term_t *term)
+{
+    if (term->oper == EcsNot) {
+        return false;
+    }
+
+    switch(term->inout) {
+    case EcsInOutDefault: {
+        /* Default access is only readwrite for components owned by the 
+         * matched entities. */
+        ecs_term_id_t *subj = &term->args[0];
+        return subj->entity == EcsThis && (subj->set.mask & EcsSelf);
+    }
+    case EcsInOut:
+    case EcsOut:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static
+bool ids_overlap(
+    ecs_id_t id1,
+    ecs_id_t id2)
+{
+    return ecs_id_match(id1, id2) || ecs_id_match(id2, id1);
+}
+
+/* Test if a system writes to a component that the other system accesses */
+static
+bool filter_writes_to(
+    ecs_filter_t *writer,
+    ecs_filter_t *reader)
+{
+    int32_t w, r;
+    for (w = 0; w < writer->term_count; w ++) {
+        ecs_term_t *wterm = &writer->terms[w];
+        if (!term_writes(wterm)) {
+            continue;
+        }
+
+        for (r = 0; r < reader->term_count; r ++) {
+            ecs_term_t *rterm = &reader->terms[r];
+            if (!term_reads(rterm) && !term_writes(rterm)) {
+                continue;
+            }
+
+            if (ids_overlap(wterm->id, rterm->id)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static
+bool systems_conflict(
+    ecs_filter_t *filter1,
+    ecs_filter_t *filter2)
+{
+    /* Systems without terms (tasks) could access anything */
+    if (!filter1->term_count || !filter2->term_count) {
+        return true;
+    }
+
+    return filter_writes_to(filter1, filter2) || 
+        filter_writes_to(filter2, filter1);
+}
+
+/* Assign systems of an operation to levels. A system is added to the level
+ * after the last system it conflicts with, so that systems in the same level
+ * can run in parallel while preserving the order of conflicting systems. */
+static
+void build_levels(
+    ecs_pipeline_op_t *op,
+    ecs_vector_t *op_systems,
+    ecs_vector_t **levels,
+    ecs_vector_t **schedule)
+{
+    op_system_t *systems = ecs_vector_first(op_systems, op_system_t);
+    int32_t i, j, count = ecs_vector_count(op_systems);
+    int32_t level_count = 0;
+
+    for (i = 0; i < count; i ++) {
+        int32_t level = 0;
+        for (j = 0; j < i; j ++) {
+            if (systems[j].level >= level && 
+                systems_conflict(systems[j].filter, systems[i].filter)) 
+            {
+                level = systems[j].level + 1;
+            }
+        }
+
+        systems[i].level = level;
+        if (level >= level_count) {
+            level_count = level + 1;
+        }
+    }
+
+    op->first_level = ecs_vector_count(*levels);
+    op->level_count = level_count;
+
+    for (i = 0; i < level_count; i ++) {
+        ecs_pipeline_level_t *level = ecs_vector_add(
+            levels, ecs_pipeline_level_t);
+        level->first = ecs_vector_count(*schedule);
+        level->count = 0;
+        level->claimed = 0;
+
+        for (j = 0; j < count; j ++) {
+            if (systems[j].level == i) {
+                int32_t *elem = ecs_vector_add(schedule, int32_t);
+                *elem = systems[j].index;
+                level->count ++;
+            }
+        }
+    }
+
+    ecs_vector_clear(op_systems);
+}
+
 static
 bool build_pipeline(
     ecs_world_t *world,
@@ -240,11 +382,18 @@ bool build_pipeline(
 
     ecs_pipeline_op_t *op = NULL;
     ecs_vector_t *ops = NULL;
+    ecs_vector_t *systems = NULL;
+    ecs_vector_t *levels = NULL;
+    ecs_vector_t *schedule = NULL;
+    ecs_vector_t *op_systems = NULL;
     ecs_query_t *query = pq->build_query;
 
     if (pq->ops) {
         ecs_vector_free(pq->ops);
     }
+    ecs_vector_free(pq->systems);
+    ecs_vector_free(pq->levels);
+    ecs_vector_free(pq->schedule);
 
     /* Iterate systems in pipeline, add ops for running / merging */
     ecs_iter_t it = ecs_query_iter(query);
@@ -271,6 +420,7 @@ bool build_pipeline(
             if (needs_merge) {
                 /* After merge all components will be merged, so reset state */
                 reset_write_state(&ws);
+                build_levels(op, op_systems, &levels, &schedule);
                 op = NULL;
 
                 /* Re-evaluate columns to set write flags if system is active.
@@ -291,21 +441,40 @@ bool build_pipeline(
             if (!op) {
                 op = ecs_vector_add(&ops, ecs_pipeline_op_t);
                 op->count = 0;
+                op->first_system = ecs_vector_count(systems);
+                op->system_count = 0;
             }
 
             /* Don't increase count for inactive systems, as they are ignored by
              * the query used to run the pipeline. */
             if (is_active) {
                 op->count ++;
+
+                op_system_t *op_sys = ecs_vector_add(&op_systems, op_system_t);
+                op_sys->index = ecs_vector_count(systems);
+                op_sys->level = 0;
+                op_sys->filter = &q->filter;
             }
+
+            op->system_count ++;
+            ecs_entity_t *sys_elem = ecs_vector_add(&systems, ecs_entity_t);
+            *sys_elem = it.entities[i];
         }
     }
 
+    if (op) {
+        build_levels(op, op_systems, &levels, &schedule);
+    }
+
     ecs_map_free(ws.components);
+    ecs_vector_free(op_systems);
 
     /* Force sort of query as this could increase the match_count */
     pq->match_count = pq->query->match_count;
     pq->ops = ops;
+    pq->systems = systems;
+    pq->levels = levels;
+    pq->schedule = schedule;
 
     return true;
 }
@@ -370,9 +539,130 @@ int32_t ecs_pipeline_update(
 
     build_pipeline(world, pipeline, pq);
 
+    /* Reset levels, so that workers can claim systems for the next op */
+    ecs_vector_each(pq->levels, ecs_pipeline_level_t, level, {
+        level->claimed = 0;
+    });
+
     return ecs_vector_count(pq->ops);
 }
 
+/* Find operation to continue with after the pipeline has been rebuilt */
+static
+int32_t op_reset(
+    const EcsPipelineQuery *pq,
+    ecs_entity_t last,
+    int32_t *skip_out)
+{
+    ecs_entity_t *systems = ecs_vector_first(pq->systems, ecs_entity_t);
+    int32_t i, count = ecs_vector_count(pq->systems);
+    for (i = 0; i < count; i ++) {
+        if (systems[i] == last) {
+            break;
+        }
+    }
+
+    ecs_assert(i != count, ECS_UNSUPPORTED, NULL);
+    *skip_out = i;
+
+    ecs_pipeline_op_t *ops = ecs_vector_first(pq->ops, ecs_pipeline_op_t);
+    int32_t o, op_count = ecs_vector_count(pq->ops);
+    for (o = 0; o < op_count; o ++) {
+        if ((i + 1) < (ops[o].first_system + ops[o].system_count)) {
+            break;
+        }
+    }
+
+    return o;
+}
+
+/* Run systems of an operation level by level. Workers claim systems from the
+ * current level, and each claimed system runs on a single worker. */
+static
+void run_op_parallel(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    const EcsPipelineQuery *pq,
+    ecs_pipeline_op_t *op,
+    int32_t skip,
+    FLECS_FLOAT delta_time)
+{
+    ecs_pipeline_level_t *levels = ecs_vector_first(
+        pq->levels, ecs_pipeline_level_t);
+    int32_t *schedule = ecs_vector_first(pq->schedule, int32_t);
+    ecs_entity_t *systems = ecs_vector_first(pq->systems, ecs_entity_t);
+    int32_t l, last_level = op->first_level + op->level_count - 1;
+
+    for (l = op->first_level; l <= last_level; l ++) {
+        ecs_pipeline_level_t *level = &levels[l];
+        int32_t claimed;
+
+        while ((claimed = ecs_os_ainc(&level->claimed)) <= level->count) {
+            int32_t index = schedule[level->first + claimed - 1];
+            if (index <= skip) {
+                /* System already ran before pipeline was rebuilt */
+                continue;
+            }
+
+            ecs_entity_t e = systems[index];
+            EcsSystem *sys = (EcsSystem*)ecs_get(world, e, EcsSystem);
+            ecs_assert(sys != NULL, ECS_INTERNAL_ERROR, NULL);
+
+            ecs_run_intern(world, stage, e, sys, 0, 1, delta_time, 0, 0, 
+                NULL, NULL);
+
+            world->stats.systems_ran_frame ++;
+        }
+
+        /* Systems in the next level may depend on systems in this level */
+        if (l != last_level) {
+            ecs_worker_wait_level(world);
+        }
+    }
+}
+
+static
+void run_parallel(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t pipeline,
+    const EcsPipelineQuery *pq,
+    FLECS_FLOAT delta_time)
+{
+    int32_t op_index = 0, skip = -1;
+
+    ecs_worker_begin(stage->thread_ctx);
+
+    do {
+        ecs_pipeline_op_t *ops = ecs_vector_first(pq->ops, ecs_pipeline_op_t);
+        int32_t op_count = ecs_vector_count(pq->ops);
+        if (op_index >= op_count) {
+            break;
+        }
+
+        ecs_pipeline_op_t *op = &ops[op_index];
+        run_op_parallel(world, stage, pq, op, skip, delta_time);
+
+        if (op_index == (op_count - 1)) {
+            break;
+        }
+
+        /* If the set of matched systems changed as a result of the merge, 
+         * find the position of the last system in the rebuilt pipeline */
+        ecs_entity_t last = *ecs_vector_get(pq->systems, ecs_entity_t, 
+            op->first_system + op->system_count - 1);
+
+        if (ecs_worker_sync(stage->thread_ctx)) {
+            pq = ecs_get(world, pipeline, EcsPipelineQuery);
+            op_index = op_reset(pq, last, &skip);
+        } else {
+            op_index ++;
+        }
+    } while (true);
+
+    ecs_worker_end(stage->thread_ctx);
+}
+
 void ecs_pipeline_run(
     ecs_world_t *world,
     ecs_entity_t pipeline,
@@ -407,14 +697,20 @@ void ecs_pipeline_run(
     ecs_assert(pq != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(pq->query != NULL, ECS_INTERNAL_ERROR, NULL);
 
+    int32_t stage_index = ecs_get_stage_id(stage->thread_ctx);
+    int32_t stage_count = ecs_get_stage_count(world);
+
+    /* Run non-conflicting systems in parallel on different workers */
+    if (world->parallel_systems && stage_count > 1) {
+        run_parallel(world, stage, pipeline, pq, delta_time);
+        return;
+    }
+
     ecs_vector_t *ops = pq->ops;
     ecs_pipeline_op_t *op = ecs_vector_first(ops, ecs_pipeline_op_t);
     ecs_pipeline_op_t *op_last = ecs_vector_last(ops, ecs_pipeline_op_t);
     int32_t ran_since_merge = 0;
 
-    int32_t stage_index = ecs_get_stage_id(stage->thread_ctx);
-    int32_t stage_count = ecs_get_stage_count(world);
-
     ecs_worker_begin(stage->thread_ctx);
     
     ecs_iter_t it = ecs_query_iter(pq->query);
@@ -602,6 +898,9 @@ void EcsOnUpdatePipeline(
         pq->build_query = build_query;
         pq->match_count = -1;
         pq->ops = NULL;
+        pq->systems = NULL;
+        pq->levels = NULL;
+        pq->schedule = NULL;
 
         ecs_log_pop();
     }
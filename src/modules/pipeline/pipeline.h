@@ -10,13 +10,29 @@
  * information about the set of systems that need to be ran before a merge. */
 typedef struct ecs_pipeline_op_t {
     int32_t count;              /**< Number of systems to run before merge */
+    int32_t first_system;       /**< First system (index in systems) */
+    int32_t system_count;       /**< Number of systems, including inactive */
+    int32_t first_level;        /**< First level (index in levels) */
+    int32_t level_count;        /**< Number of levels */
 } ecs_pipeline_op_t;
 
+/** Systems in a level of an operation don't read components that are written
+ * by other systems in the same level, and can run in parallel. Levels are only
+ * used when parallel systems are enabled. */
+typedef struct ecs_pipeline_level_t {
+    int32_t first;              /**< First system (index in schedule) */
+    int32_t count;              /**< Number of systems in level */
+    int32_t claimed;            /**< Number of systems claimed by workers */
+} ecs_pipeline_level_t;
+
 typedef struct EcsPipelineQuery {
     ecs_query_t *query;
     ecs_query_t *build_query;
     int32_t match_count;
     ecs_vector_t *ops;
+    ecs_vector_t *systems;      /* vector<ecs_entity_t> */
+    ecs_vector_t *levels;       /* vector<ecs_pipeline_level_t> */
+    ecs_vector_t *schedule;     /* vector<int32_t>, systems ordered by level */
 } EcsPipelineQuery;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -64,4 +80,19 @@ void ecs_workers_progress(
     ecs_entity_t pipeline,
     FLECS_FLOAT delta_time);
 
+/** Wait until all workers have finished the current level of systems. */
+void ecs_worker_wait_level(
+    ecs_world_t *world);
+
+/** Run a system with the work stealing scheduler.
+ * Matched tables are cut into jobs which are distributed across the job queues
+ * of the workers. When a worker runs out of jobs, it steals jobs from the
+ * queues of other workers. */
+void ecs_worker_run_jobs(
+    ecs_world_t *world,
+    ecs_iter_t *it,
+    ecs_iter_action_t action,
+    int32_t stage_current,
+    int32_t stage_count);
+
 #endif
@@ -4,6 +4,21 @@
 
 #include "pipeline.h"
 
+/* Target size in bytes of the component data processed by a single job. Jobs
+ * should be small enough to fit in the cache of a core, while large enough to
+ * not spend too much time on scheduling. */
+#define ECS_WORKER_JOB_SIZE (16 * 1024)
+
+/* Wait until main thread signals that workers can start/resume work. Returns
+ * false if workers should quit. */
+static
+bool wait_for_start(
+    ecs_world_t *world)
+{
+    ecs_os_barrier_wait(world->start_barrier);
+    return !world->quit_workers;
+}
+
 /* Worker thread */
 static
 void* worker(void *arg) {
@@ -11,17 +26,12 @@ void* worker(void *arg) {
     ecs_world_t *world = stage->world;
 
     /* Start worker thread, increase counter so main thread knows how many
-     * workers are ready */
-    ecs_os_mutex_lock(world->sync_mutex);
-    world->workers_running ++;
+     * workers are running */
+    ecs_os_ainc(&world->workers_running);
 
-    if (!world->quit_workers) {
-        ecs_os_cond_wait(world->worker_cond, world->sync_mutex);
-    }
-
-    ecs_os_mutex_unlock(world->sync_mutex);
-
-    while (!world->quit_workers) {
+    /* Wait until main thread signals that workers can start running the 
+     * pipeline, or that workers should quit */
+    while (wait_for_start(world)) {
         ecs_entity_t old_scope = ecs_set_scope((ecs_world_t*)stage, 0);
 
         ecs_pipeline_run(
@@ -32,9 +42,7 @@ void* worker(void *arg) {
         ecs_set_scope((ecs_world_t*)stage, old_scope);
     }
 
-    ecs_os_mutex_lock(world->sync_mutex);
-    world->workers_running --;
-    ecs_os_mutex_unlock(world->sync_mutex);
+    ecs_os_adec(&world->workers_running);
 
     return NULL;
 }
@@ -56,45 +64,20 @@ void start_workers(
         ecs_assert(stage->magic == ECS_STAGE_MAGIC, ECS_INTERNAL_ERROR, NULL);
 
         ecs_vector_get(world->worker_stages, ecs_stage_t, i);
+        stage->job_queue.lock = ecs_os_mutex_new();
         stage->thread = ecs_os_thread_new(worker, stage);
         ecs_assert(stage->thread != 0, ECS_THREAD_ERROR, NULL);
     }
 }
 
-/* Wait until all workers are running */
-static
-void wait_for_workers(
-    ecs_world_t *world)
-{
-    int32_t stage_count = ecs_get_stage_count(world);
-    bool wait = true;
-
-    do {
-        ecs_os_mutex_lock(world->sync_mutex);
-        if (world->workers_running == stage_count) {
-            wait = false;
-        }
-        ecs_os_mutex_unlock(world->sync_mutex);
-    } while (wait);
-}
-
 /* Synchronize worker threads */
 static
 void sync_worker(
     ecs_world_t *world)
 {
-    int32_t stage_count = ecs_get_stage_count(world);
-
-    /* Signal that thread is waiting */
-    ecs_os_mutex_lock(world->sync_mutex);
-    if (++ world->workers_waiting == stage_count) {
-        /* Only signal main thread when all threads are waiting */
-        ecs_os_cond_signal(world->sync_cond);
-    }
-
-    /* Wait until main thread signals that thread can continue */
-    ecs_os_cond_wait(world->worker_cond, world->sync_mutex);
-    ecs_os_mutex_unlock(world->sync_mutex);
+    /* Signal that thread is done. The main thread performs the merge when all
+     * threads have arrived at the sync barrier. */
+    ecs_os_barrier_wait(world->sync_barrier);
 }
 
 /* Wait until all threads are waiting on sync point */
@@ -102,18 +85,7 @@ static
 void wait_for_sync(
     ecs_world_t *world)
 {
-    int32_t stage_count = ecs_get_stage_count(world);
-
-    ecs_os_mutex_lock(world->sync_mutex);
-    if (world->workers_waiting != stage_count) {
-        ecs_os_cond_wait(world->sync_cond, world->sync_mutex);
-    }
-    
-    /* We should have been signalled unless all workers are waiting on sync */
-    ecs_assert(world->workers_waiting == stage_count, 
-        ECS_INTERNAL_ERROR, NULL);
-
-    ecs_os_mutex_unlock(world->sync_mutex);
+    ecs_os_barrier_wait(world->sync_barrier);
 }
 
 /* Signal workers that they can start/resume work */
@@ -121,9 +93,7 @@ static
 void signal_workers(
     ecs_world_t *world)
 {
-    ecs_os_mutex_lock(world->sync_mutex);
-    ecs_os_cond_broadcast(world->worker_cond);
-    ecs_os_mutex_unlock(world->sync_mutex);
+    ecs_os_barrier_wait(world->start_barrier);
 }
 
 /** Stop worker threads */
@@ -148,10 +118,8 @@ bool ecs_stop_threads(
         return false;
     }
 
-    /* Make sure all threads are running, to ensure they catch the signal */
-    wait_for_workers(world);
-
-    /* Signal threads should quit */
+    /* Signal threads should quit. This waits until all threads are running,
+     * so that they are guaranteed to see the signal. */
     world->quit_workers = true;
     signal_workers(world);
 
@@ -159,6 +127,10 @@ bool ecs_stop_threads(
     ecs_vector_each(world->worker_stages, ecs_stage_t, stage, {
         ecs_os_thread_join(stage->thread);
         stage->thread = 0;
+
+        ecs_os_mutex_free(stage->job_queue.lock);
+        ecs_vector_free(stage->job_queue.jobs);
+        stage->job_queue = (ecs_job_queue_t){ 0 };
     });
 
     world->quit_workers = false;
@@ -170,8 +142,172 @@ bool ecs_stop_threads(
     return true;
 }
 
+/* Compute number of rows per job for the current table */
+static
+int32_t job_row_count(
+    const ecs_iter_t *it)
+{
+    const ecs_table_t *table = it->table ? it->table->table : NULL;
+    if (!table) {
+        return it->count;
+    }
+
+    int32_t i, row_size = ECS_SIZEOF(ecs_entity_t);
+    int32_t *columns = it->table->columns;
+    for (i = 0; i < it->column_count; i ++) {
+        int32_t column = columns[i];
+        if (column > 0) {
+            row_size += ecs_from_size_t(ecs_iter_column_size(it, column - 1));
+        }
+    }
+
+    int32_t result = ECS_WORKER_JOB_SIZE / row_size;
+    if (!result) {
+        result = 1;
+    }
+
+    return result;
+}
+
+/* Add a job for a chunk of the current table to the queue */
+static
+void push_job(
+    ecs_job_queue_t *queue,
+    const ecs_iter_t *it,
+    ecs_iter_action_t action,
+    int32_t first,
+    int32_t count)
+{
+    ecs_worker_job_t *job = ecs_vector_add(&queue->jobs, ecs_worker_job_t);
+    job->it = *it;
+    job->it.offset += first;
+    job->it.frame_offset += first;
+    job->it.count = count;
+    if (count) {
+        job->it.entities = &it->entities[first];
+    }
+    job->action = action;
+}
+
+/* Take the most recently added job. Called by the worker that owns the queue */
+static
+bool pop_job(
+    ecs_job_queue_t *queue,
+    ecs_worker_job_t *job_out)
+{
+    bool result = false;
+
+    ecs_os_mutex_lock(queue->lock);
+    int32_t count = ecs_vector_count(queue->jobs);
+    if (count > queue->head) {
+        *job_out = *ecs_vector_last(queue->jobs, ecs_worker_job_t);
+        ecs_vector_remove_last(queue->jobs);
+        result = true;
+    }
+    ecs_os_mutex_unlock(queue->lock);
+
+    return result;
+}
+
+/* Take the oldest job. Called by idle workers that steal from other queues */
+static
+bool steal_job(
+    ecs_job_queue_t *queue,
+    ecs_worker_job_t *job_out)
+{
+    bool result = false;
+
+    ecs_os_mutex_lock(queue->lock);
+    int32_t count = ecs_vector_count(queue->jobs);
+    if (count > queue->head) {
+        *job_out = *ecs_vector_get(
+            queue->jobs, ecs_worker_job_t, queue->head);
+        queue->head ++;
+        result = true;
+    }
+    ecs_os_mutex_unlock(queue->lock);
+
+    return result;
+}
+
+static
+void run_job(
+    ecs_world_t *thread_ctx,
+    ecs_worker_job_t *job)
+{
+    /* The job may have been stolen, make sure that deferred operations are
+     * added to the stage of the worker that runs it */
+    job->it.world = thread_ctx;
+    job->action(&job->it);
+}
+
 /* -- Private functions -- */
 
+void ecs_worker_wait_level(
+    ecs_world_t *world)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INTERNAL_ERROR, NULL);
+    ecs_os_barrier_wait(world->level_barrier);
+}
+
+void ecs_worker_run_jobs(
+    ecs_world_t *world,
+    ecs_iter_t *it,
+    ecs_iter_action_t action,
+    int32_t stage_current,
+    int32_t stage_count)
+{
+    ecs_stage_t *stage = ecs_stage_from_world(&world);
+    ecs_job_queue_t *queue = &stage->job_queue;
+    ecs_worker_job_t job;
+    int32_t i, job_index = 0;
+
+    /* Cut matched tables in jobs. Each worker iterates the same tables in the
+     * same order, so jobs can be distributed without coordination between
+     * workers by only adding jobs for which index % stage_count matches. */
+    ecs_os_mutex_lock(queue->lock);
+    ecs_vector_clear(queue->jobs);
+    queue->head = 0;
+
+    while (ecs_query_next(it)) {
+        int32_t count = it->count;
+        if (!count) {
+            /* Query isn't matched with tables, only run it once */
+            if (!(it->query->flags & EcsQueryNeedsTables) && !stage_current) {
+                push_job(queue, it, action, 0, 0);
+            }
+            continue;
+        }
+
+        int32_t first, rows = job_row_count(it);
+        for (first = 0; first < count; first += rows) {
+            if ((job_index ++ % stage_count) == stage_current) {
+                int32_t job_count = count - first;
+                if (job_count > rows) {
+                    job_count = rows;
+                }
+                push_job(queue, it, action, first, job_count);
+            }
+        }
+    }
+    ecs_os_mutex_unlock(queue->lock);
+
+    /* Run own jobs */
+    while (pop_job(queue, &job)) {
+        run_job(stage->thread_ctx, &job);
+    }
+
+    /* Steal jobs from workers that haven't finished yet */
+    for (i = 1; i < stage_count; i ++) {
+        ecs_stage_t *victim = (ecs_stage_t*)ecs_get_stage(world, 
+            (stage_current + i) % stage_count);
+        while (steal_job(&victim->job_queue, &job)) {
+            run_job(stage->thread_ctx, &job);
+        }
+    }
+}
+
+
 void ecs_worker_begin(
     ecs_world_t *world)
 {
@@ -199,10 +335,12 @@ bool ecs_worker_sync(
         ecs_pipeline_update(world, world->pipeline, false);
         ecs_staging_begin(world);
 
-    /* Synchronize all workers. The last worker to reach the sync point will
-     * signal the main thread, which will perform the merge. */
+    /* Synchronize all workers. When all workers reached the sync point the 
+     * main thread will perform the merge, after which it signals the workers
+     * that they can resume. */
     } else {
         sync_worker(world);
+        wait_for_start(world);
     }
 
     return world->stats.pipeline_build_count_total != build_count;
@@ -220,8 +358,9 @@ void ecs_worker_end(
     if (stage_count == 1) {
         ecs_staging_end(world);
 
-    /* Synchronize all workers. The last worker to reach the sync point will
-     * signal the main thread, which will perform the merge. */
+    /* Synchronize all workers. When all workers reached the sync point the 
+     * main thread will perform the merge. Workers wait for the start of the
+     * next frame in the worker function. */
     } else {
         sync_worker(world);
     }
@@ -250,15 +389,11 @@ void ecs_workers_progress(
     } else {
         int32_t i, sync_count = ecs_pipeline_update(world, pipeline, true);
 
-        /* Make sure workers are running and ready */
-        wait_for_workers(world);
-
         /* Synchronize n times for each op in the pipeline */
         for (i = 0; i < sync_count; i ++) {
             ecs_staging_begin(world);
 
             /* Signal workers that they should start running systems */
-            world->workers_waiting = 0;
             signal_workers(world);
 
             /* Wait until all workers are waiting on sync point */
@@ -284,6 +419,26 @@ void ecs_workers_progress(
 
 /* -- Public functions -- */
 
+void ecs_set_work_stealing(
+    ecs_world_t *world,
+    bool enable)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!world->is_readonly, ECS_INVALID_OPERATION, NULL);
+    world->work_stealing = enable;
+}
+
+void ecs_set_parallel_systems(
+    ecs_world_t *world,
+    bool enable)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!world->is_readonly, ECS_INVALID_OPERATION, NULL);
+    world->parallel_systems = enable;
+}
+
 void ecs_set_threads(
     ecs_world_t *world,
     int32_t threads)
@@ -296,17 +451,18 @@ void ecs_set_threads(
         /* Stop existing threads */
         if (stage_count > 1) {
             if (ecs_stop_threads(world)) {
-                ecs_os_cond_free(world->worker_cond);
-                ecs_os_cond_free(world->sync_cond);
-                ecs_os_mutex_free(world->sync_mutex);
+                ecs_os_barrier_free(world->start_barrier);
+                ecs_os_barrier_free(world->sync_barrier);
+                ecs_os_barrier_free(world->level_barrier);
             }
         }
 
-        /* Start threads if number of threads > 1 */
+        /* Start threads if number of threads > 1. The main thread also
+         * participates in the barriers. */
         if (threads > 1) {
-            world->worker_cond = ecs_os_cond_new();
-            world->sync_cond = ecs_os_cond_new();
-            world->sync_mutex = ecs_os_mutex_new();
+            world->start_barrier = ecs_os_barrier_new(threads + 1);
+            world->sync_barrier = ecs_os_barrier_new(threads + 1);
+            world->level_barrier = ecs_os_barrier_new(threads);
             start_workers(world, threads);
         }
 
@@ -5,6 +5,10 @@
 #include "../../private_api.h"
 #include "system.h"
 
+#ifdef FLECS_PIPELINE
+#include "../pipeline/pipeline.h"
+#endif
+
 /* Global type variables */
 ECS_TYPE_DECL(EcsComponentLifecycle);
 ECS_TYPE_DECL(EcsSystem);
@@ -328,6 +332,11 @@ ecs_entity_t ecs_run_intern(
         while (ecs_query_next_w_filter(&it, filter)) {
             action(&it);
         }
+#ifdef FLECS_PIPELINE
+    } else if (world->work_stealing) {
+        ecs_worker_run_jobs(
+            stage->thread_ctx, &it, action, stage_current, stage_count);
+#endif
     } else {
         while (ecs_query_next_worker(&it, stage_current, stage_count)) {
             action(&it);               
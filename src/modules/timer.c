@@ -16,13 +16,293 @@ void AddTickSource(ecs_iter_t *it) {
     }
 }
 
+/* -- Timer wheel -- */
+
+/* The timer wheel divides time in ticks of a fixed resolution. Each level of
+ * the wheel has a slot per tick of the level, where a tick of a level spans all
+ * slots of the level below it. Timers are stored in the lowest level that can
+ * hold their expiry time, and move to a lower level when the wheel reaches
+ * their slot. Timers that expire beyond the range of the wheel are stored in an
+ * overflow list that is revisited each time the top level wraps around. */
+
+#define TIMER_WHEEL_BITS (6)
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS (4)
+#define TIMER_WHEEL_DEFAULT_RESOLUTION (0.001)
+
+typedef struct timer_wheel_elem_t {
+    ecs_entity_t timer;
+    double expire;
+} timer_wheel_elem_t;
+
+/* Time is stored as double, as the time of the wheel grows without bounds and
+ * loses precision quickly when stored as float. */
+typedef struct timer_wheel_t {
+    ecs_vector_t *slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    ecs_vector_t *overflow;
+    ecs_vector_t *expired;      /* Timers that expired in the current frame */
+    ecs_vector_t *ticked;       /* Timers that ticked in the previous frame */
+    ecs_map_t *expire;          /* Current expiry time for each timer */
+    double time;
+    double resolution;
+    uint64_t tick;
+    bool enabled;
+} timer_wheel_t;
+
+static
+void timer_wheel_free(
+    void *ctx)
+{
+    timer_wheel_t *wheel = ctx;
+
+    int32_t l, s;
+    for (l = 0; l < TIMER_WHEEL_LEVELS; l ++) {
+        for (s = 0; s < TIMER_WHEEL_SLOTS; s ++) {
+            ecs_vector_free(wheel->slots[l][s]);
+        }
+    }
+
+    ecs_vector_free(wheel->overflow);
+    ecs_vector_free(wheel->expired);
+    ecs_vector_free(wheel->ticked);
+    ecs_map_free(wheel->expire);
+    ecs_os_free(wheel);
+}
+
+static
+void timer_wheel_insert(
+    timer_wheel_t *wheel,
+    ecs_entity_t timer,
+    double expire)
+{
+    uint64_t tick = (uint64_t)(expire / wheel->resolution);
+    if (tick < wheel->tick) {
+        tick = wheel->tick;
+    }
+
+    uint64_t delta = tick - wheel->tick;
+    ecs_vector_t **slot = &wheel->overflow;
+
+    int32_t l;
+    for (l = 0; l < TIMER_WHEEL_LEVELS; l ++) {
+        if (delta < (1ull << (TIMER_WHEEL_BITS * (l + 1)))) {
+            uint64_t index = (tick >> (TIMER_WHEEL_BITS * l)) & TIMER_WHEEL_MASK;
+            slot = &wheel->slots[l][index];
+            break;
+        }
+    }
+
+    timer_wheel_elem_t *elem = ecs_vector_add(slot, timer_wheel_elem_t);
+    elem->timer = timer;
+    elem->expire = expire;
+}
+
+static
+void timer_wheel_schedule(
+    timer_wheel_t *wheel,
+    ecs_entity_t timer,
+    double expire)
+{
+    /* Don't insert the timer twice when it is rescheduled with the same time */
+    const double *cur = ecs_map_get(wheel->expire, double, timer);
+    if (cur && *cur == expire) {
+        return;
+    }
+
+    ecs_map_set(wheel->expire, timer, &expire);
+    timer_wheel_insert(wheel, timer, expire);
+}
+
+/* Reinsert the timers of a slot, which moves them to a lower level */
+static
+void timer_wheel_cascade(
+    timer_wheel_t *wheel,
+    ecs_vector_t **slot)
+{
+    ecs_vector_t *elems = *slot;
+    *slot = NULL;
+
+    ecs_vector_each(elems, timer_wheel_elem_t, elem, {
+        timer_wheel_insert(wheel, elem->timer, elem->expire);
+    });
+
+    ecs_vector_free(elems);
+}
+
+/* Move timers that have expired from the current slot to the expired list. The
+ * current tick may only have partially elapsed, so timers that have not yet
+ * expired stay in the slot. */
+static
+void timer_wheel_expire(
+    timer_wheel_t *wheel)
+{
+    ecs_vector_t **slot = &wheel->slots[0][wheel->tick & TIMER_WHEEL_MASK];
+    timer_wheel_elem_t *elems = ecs_vector_first(*slot, timer_wheel_elem_t);
+    int32_t i, kept = 0, count = ecs_vector_count(*slot);
+    if (!count) {
+        return;
+    }
+
+    for (i = 0; i < count; i ++) {
+        if (elems[i].expire <= wheel->time) {
+            timer_wheel_elem_t *elem = ecs_vector_add(
+                &wheel->expired, timer_wheel_elem_t);
+            *elem = elems[i];
+        } else {
+            elems[kept ++] = elems[i];
+        }
+    }
+
+    ecs_vector_set_count(slot, timer_wheel_elem_t, kept);
+}
+
+static
+void timer_wheel_advance(
+    timer_wheel_t *wheel)
+{
+    uint64_t tick = (uint64_t)(wheel->time / wheel->resolution);
+
+    timer_wheel_expire(wheel);
+
+    while (wheel->tick < tick) {
+        uint64_t t = ++ wheel->tick;
+
+        /* Cascade from the top, so that timers that move down from a higher
+         * level are cascaded again if they land in a slot that is reached in
+         * this tick. */
+        if (!(t & ((1ull << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1))) {
+            timer_wheel_cascade(wheel, &wheel->overflow);
+        }
+
+        int32_t l;
+        for (l = TIMER_WHEEL_LEVELS - 1; l > 0; l --) {
+            if (!(t & ((1ull << (TIMER_WHEEL_BITS * l)) - 1))) {
+                uint64_t index = (t >> (TIMER_WHEEL_BITS * l)) & TIMER_WHEEL_MASK;
+                timer_wheel_cascade(wheel, &wheel->slots[l][index]);
+            }
+        }
+
+        timer_wheel_expire(wheel);
+    }
+}
+
+/* The wheel updates timers in place like ProgressTimers does, so that systems
+ * that run later in the frame see the tick without waiting for a merge. */
+#define get_in_place(world, e, T)\
+    ((T*)(uintptr_t)ecs_get_id(world, e, ecs_id(T)))
+
+static
+void timer_wheel_fire(
+    ecs_world_t *world,
+    timer_wheel_t *wheel,
+    const timer_wheel_elem_t *elem)
+{
+    ecs_entity_t e = elem->timer;
+
+    /* Timers that were rescheduled, stopped or deleted after this element was
+     * inserted are skipped */
+    const double *expire = ecs_map_get(wheel->expire, double, e);
+    if (!expire || *expire != elem->expire) {
+        return;
+    }
+
+    EcsTimer *timer = NULL;
+    if (ecs_is_alive(world, e)) {
+        timer = get_in_place(world, e, EcsTimer);
+    }
+
+    if (!timer || !timer->active) {
+        ecs_map_remove(wheel->expire, e);
+        return;
+    }
+
+    FLECS_FLOAT timeout = timer->timeout;
+    double t = wheel->time - elem->expire;
+    if (t > timeout) {
+        t = 0;
+    }
+
+    FLECS_FLOAT time_elapsed = 
+        (FLECS_FLOAT)(wheel->time - elem->expire) + timeout;
+
+    EcsTickSource *tick_source = get_in_place(world, e, EcsTickSource);
+    if (tick_source) {
+        tick_source->tick = true;
+        tick_source->time_elapsed = time_elapsed;
+    } else {
+        ecs_set(world, e, EcsTickSource, {
+            .tick = true, 
+            .time_elapsed = time_elapsed
+        });
+    }
+
+    timer->time = (FLECS_FLOAT)t; /* Initialize with remainder */
+
+    ecs_map_remove(wheel->expire, e);
+
+    if (timer->single_shot) {
+        timer->active = false;
+    } else {
+        timer_wheel_schedule(wheel, e, wheel->time - t + timeout);
+    }
+
+    ecs_entity_t *ticked = ecs_vector_add(&wheel->ticked, ecs_entity_t);
+    *ticked = e;
+}
+
+static
+void timer_wheel_progress(
+    ecs_world_t *world,
+    timer_wheel_t *wheel)
+{
+
+    /* Reset tick sources of timers that ticked in the previous frame */
+    ecs_vector_each(wheel->ticked, ecs_entity_t, e_ptr, {
+        ecs_entity_t e = *e_ptr;
+        if (ecs_is_alive(world, e)) {
+            EcsTickSource *tick_source = get_in_place(world, e, EcsTickSource);
+            if (tick_source) {
+                tick_source->tick = false;
+            }
+        }
+    });
+
+    ecs_vector_clear(wheel->ticked);
+
+    const ecs_world_info_t *info = ecs_get_world_info(world);
+    wheel->time += (double)info->delta_time_raw;
+
+    timer_wheel_advance(wheel);
+
+    /* Fire timers after advancing, as firing reschedules interval timers */
+    ecs_vector_each(wheel->expired, timer_wheel_elem_t, elem, {
+        timer_wheel_fire(world, wheel, elem);
+    });
+
+    ecs_vector_clear(wheel->expired);
+}
+
 static
 void ProgressTimers(ecs_iter_t *it) {
+    timer_wheel_t *wheel = it->ctx;
+    if (wheel->enabled) {
+        /* The wheel visits timers by itself, so it only runs once per frame
+         * for the invocation that contains the first timer. */
+        if (!it->frame_offset) {
+            timer_wheel_progress(it->world, wheel);
+        }
+        return;
+    }
+
     EcsTimer *timer = ecs_term(it, EcsTimer, 1);
     EcsTickSource *tick_source = ecs_term(it, EcsTickSource, 2);
 
     ecs_assert(timer != NULL, ECS_INTERNAL_ERROR, NULL);
 
+    const ecs_world_info_t *info = ecs_get_world_info(it->world);
+    FLECS_FLOAT delta_time = info->delta_time_raw;
+
     int i;
     for (i = 0; i < it->count; i ++) {
         tick_source[i].tick = false;
@@ -31,8 +311,7 @@ void ProgressTimers(ecs_iter_t *it) {
             continue;
         }
 
-        const ecs_world_info_t *info = ecs_get_world_info(it->world);
-        FLECS_FLOAT time_elapsed = timer[i].time + info->delta_time_raw;
+        FLECS_FLOAT time_elapsed = timer[i].time + delta_time;
         FLECS_FLOAT timeout = timer[i].timeout;
         
         if (time_elapsed >= timeout) {
@@ -59,6 +338,11 @@ void ProgressRateFilters(ecs_iter_t *it) {
     EcsRateFilter *filter = ecs_term(it, EcsRateFilter, 1);
     EcsTickSource *tick_dst = ecs_term(it, EcsTickSource, 2);
 
+    /* Filters often share a source, so only look up the source when it is
+     * different from the previous filter */
+    ecs_entity_t last_src = 0;
+    bool last_inc = true;
+
     int i;
     for (i = 0; i < it->count; i ++) {
         ecs_entity_t src = filter[i].src;
@@ -67,12 +351,17 @@ void ProgressRateFilters(ecs_iter_t *it) {
         filter[i].time_elapsed += it->delta_time;
 
         if (src) {
-            const EcsTickSource *tick_src = ecs_get(it->world, src, EcsTickSource);
-            if (tick_src) {
-                inc = tick_src->tick;
-            } else {
-                inc = true;
+            if (src != last_src) {
+                const EcsTickSource *tick_src = ecs_get(
+                    it->world, src, EcsTickSource);
+                if (tick_src) {
+                    last_inc = tick_src->tick;
+                } else {
+                    last_inc = true;
+                }
+                last_src = src;
             }
+            inc = last_inc;
         } else {
             inc = true;
         }
@@ -89,6 +378,11 @@ void ProgressRateFilters(ecs_iter_t *it) {
         } else {
             tick_dst[i].tick = false;
         }
+
+        /* Nested rate filters can use a filter in this table as source */
+        if (it->entities[i] == last_src) {
+            last_src = 0;
+        }
     }
 }
 
@@ -104,6 +398,88 @@ void ProgressTickSource(ecs_iter_t *it) {
     }
 }
 
+static
+void timer_wheel_schedule_timers(
+    timer_wheel_t *wheel,
+    ecs_iter_t *it)
+{
+    EcsTimer *timer = ecs_term(it, EcsTimer, 1);
+
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        ecs_entity_t e = it->entities[i];
+        if (timer[i].active) {
+            timer_wheel_schedule(wheel, e,
+                wheel->time + timer[i].timeout - timer[i].time);
+        } else {
+            ecs_map_remove(wheel->expire, e);
+        }
+    }
+}
+
+static
+void ScheduleTimers(ecs_iter_t *it) {
+    timer_wheel_schedule_timers(it->ctx, it);
+}
+
+void ecs_enable_timer_wheel(
+    ecs_world_t *world,
+    FLECS_FLOAT resolution)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!world->is_readonly, ECS_INVALID_WHILE_ITERATING, NULL);
+    ecs_assert(resolution >= 0, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_entity_t system = ecs_lookup_fullpath(
+        world, "flecs.timer.ProgressTimers");
+    ecs_assert(system != 0, ECS_INTERNAL_ERROR, NULL);
+
+    timer_wheel_t *wheel = ecs_get_system_ctx(world, system);
+    ecs_assert(wheel != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!wheel->enabled, ECS_INVALID_OPERATION, NULL);
+
+    if (resolution == 0) {
+        resolution = (FLECS_FLOAT)TIMER_WHEEL_DEFAULT_RESOLUTION;
+    }
+
+    wheel->resolution = (double)resolution;
+    wheel->enabled = true;
+    wheel->expire = ecs_map_new(double, 0);
+
+    /* Keep the wheel up to date when timers are set, started or stopped */
+    ecs_entity_t old_scope = ecs_set_scope(world, 
+        ecs_lookup_fullpath(world, "flecs.timer"));
+
+    ecs_system_init(world, &(ecs_system_desc_t){
+        .entity = { .name = "ScheduleTimers", .add = {EcsOnSet} },
+        .query.filter.expr = "flecs.timer.Timer",
+        .callback = ScheduleTimers,
+        .ctx = wheel
+    });
+
+    ecs_set_scope(world, old_scope);
+
+    /* Schedule existing timers. The tick sources of existing timers are reset,
+     * as the wheel only resets the timers that it ticked. */
+    ecs_query_t *q = ecs_query_new(world, 
+        "flecs.timer.Timer, ?flecs.system.TickSource");
+
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        timer_wheel_schedule_timers(wheel, &it);
+
+        EcsTickSource *tick_source = ecs_term(&it, EcsTickSource, 2);
+        if (tick_source) {
+            int i;
+            for (i = 0; i < it.count; i ++) {
+                tick_source[i].tick = false;
+            }
+        }
+    }
+
+    ecs_query_fini(q);
+}
+
 ecs_entity_t ecs_set_timeout(
     ecs_world_t *world,
     ecs_entity_t timer,
@@ -187,6 +563,8 @@ void ecs_start_timer(
 
     ptr->active = true;
     ptr->time = 0;
+
+    ecs_modified(world, timer, EcsTimer);
 }
 
 void ecs_stop_timer(
@@ -197,6 +575,8 @@ void ecs_stop_timer(
     ecs_assert(ptr != NULL, ECS_INVALID_PARAMETER, NULL);
 
     ptr->active = false;
+
+    ecs_modified(world, timer, EcsTimer);
 }
 
 ecs_entity_t ecs_set_rate(
@@ -260,8 +640,15 @@ void FlecsTimerImport(
     /* Add EcsTickSource to timers and rate filters */
     ECS_SYSTEM(world, AddTickSource, EcsPreFrame, [in] Timer || RateFilter, [out] !flecs.system.TickSource);
 
-    /* Timer handling */
-    ECS_SYSTEM(world, ProgressTimers, EcsPreFrame, Timer, flecs.system.TickSource);
+    /* Timer handling. The context holds the timer wheel, which is used
+     * instead of visiting each timer after ecs_enable_timer_wheel is called. */
+    ecs_system_init(world, &(ecs_system_desc_t){
+        .entity = { .name = "ProgressTimers", .add = {EcsPreFrame} },
+        .query.filter.expr = "Timer, flecs.system.TickSource",
+        .callback = ProgressTimers,
+        .ctx = ecs_os_calloc(sizeof(timer_wheel_t)),
+        .ctx_free = timer_wheel_free
+    });
 
     /* Rate filter handling */
     ECS_SYSTEM(world, ProgressRateFilters, EcsPreFrame, [in] RateFilter, [out] flecs.system.TickSource);
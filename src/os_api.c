@@ -12,12 +12,21 @@ int64_t ecs_os_api_realloc_count = 0;
 int64_t ecs_os_api_calloc_count = 0;
 int64_t ecs_os_api_free_count = 0;
 
+static
+void ecs_os_set_barrier_defaults(void);
+
 void ecs_os_set_api(
     ecs_os_api_t *os_api)
 {
     if (!ecs_os_api_initialized) {
         ecs_os_api = *os_api;
         ecs_os_api_initialized = true;
+
+        /* Applications that don't provide a barrier get the default barrier,
+         * which is implemented on top of the mutex & condition variable */
+        if (!ecs_os_api.barrier_new_) {
+            ecs_os_set_barrier_defaults();
+        }
     }
 }
 
@@ -168,6 +177,108 @@ char* ecs_os_api_strdup(const char *str) {
     }
 }
 
+/* Default barrier. Threads that arrive at the barrier spin for a bounded number
+ * of iterations before falling back to waiting on a condition variable, so
+ * that short waits don't pay the cost of putting a thread to sleep. The last 
+ * thread to arrive flips the sense of the barrier, which releases the other
+ * threads and prepares the barrier for the next round. */
+typedef struct ecs_os_default_barrier_t {
+    int32_t count;          /* Number of participating threads */
+    int32_t waiting;        /* Number of threads that arrived at the barrier */
+    int32_t sense;          /* Flipped when all threads have arrived */
+    ecs_os_mutex_t mutex;
+    ecs_os_cond_t cond;
+} ecs_os_default_barrier_t;
+
+#define ECS_OS_BARRIER_SPIN_COUNT (4096)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ECS_OS_BARRIER_SPIN
+#define barrier_load(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define barrier_store(ptr, value) __atomic_store_n(ptr, value, __ATOMIC_RELEASE)
+#define barrier_arrive(ptr) __atomic_add_fetch(ptr, 1, __ATOMIC_ACQ_REL)
+#endif
+
+static
+ecs_os_barrier_t ecs_os_api_barrier_new(
+    int32_t count)
+{
+    ecs_assert(count > 0, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_os_default_barrier_t *b = ecs_os_calloc(
+        ECS_SIZEOF(ecs_os_default_barrier_t));
+    b->count = count;
+    b->mutex = ecs_os_mutex_new();
+    b->cond = ecs_os_cond_new();
+    return (ecs_os_barrier_t)(uintptr_t)b;
+}
+
+static
+void ecs_os_api_barrier_free(
+    ecs_os_barrier_t barrier)
+{
+    ecs_os_default_barrier_t *b = (ecs_os_default_barrier_t*)barrier;
+    ecs_os_cond_free(b->cond);
+    ecs_os_mutex_free(b->mutex);
+    ecs_os_free(b);
+}
+
+static
+void ecs_os_api_barrier_wait(
+    ecs_os_barrier_t barrier)
+{
+    ecs_os_default_barrier_t *b = (ecs_os_default_barrier_t*)barrier;
+
+#ifdef ECS_OS_BARRIER_SPIN
+    int32_t sense = barrier_load(&b->sense);
+
+    if (barrier_arrive(&b->waiting) == b->count) {
+        /* Reset counter before releasing the other threads, as they may
+         * immediately arrive at the barrier again */
+        b->waiting = 0;
+
+        ecs_os_mutex_lock(b->mutex);
+        barrier_store(&b->sense, !sense);
+        ecs_os_cond_broadcast(b->cond);
+        ecs_os_mutex_unlock(b->mutex);
+        return;
+    }
+
+    int32_t i;
+    for (i = 0; i < ECS_OS_BARRIER_SPIN_COUNT; i ++) {
+        if (barrier_load(&b->sense) != sense) {
+            return;
+        }
+    }
+
+    ecs_os_mutex_lock(b->mutex);
+    while (barrier_load(&b->sense) == sense) {
+        ecs_os_cond_wait(b->cond, b->mutex);
+    }
+    ecs_os_mutex_unlock(b->mutex);
+#else
+    ecs_os_mutex_lock(b->mutex);
+    int32_t sense = b->sense;
+    if (++ b->waiting == b->count) {
+        b->waiting = 0;
+        b->sense = !sense;
+        ecs_os_cond_broadcast(b->cond);
+    } else {
+        while (b->sense == sense) {
+            ecs_os_cond_wait(b->cond, b->mutex);
+        }
+    }
+    ecs_os_mutex_unlock(b->mutex);
+#endif
+}
+
+static
+void ecs_os_set_barrier_defaults(void) {
+    ecs_os_api.barrier_new_ = ecs_os_api_barrier_new;
+    ecs_os_api.barrier_free_ = ecs_os_api_barrier_free;
+    ecs_os_api.barrier_wait_ = ecs_os_api_barrier_wait;
+}
+
 /* Replace dots with underscores */
 static
 char *module_file_base(const char *module, char sep) {
@@ -240,6 +351,9 @@ void ecs_os_set_api_defaults(void)
     /* Strings */
     ecs_os_api.strdup_ = ecs_os_api_strdup;
 
+    /* Barrier */
+    ecs_os_set_barrier_defaults();
+
     /* Time */
     ecs_os_api.sleep_ = ecs_os_time_sleep;
     ecs_os_api.get_time_ = ecs_os_gettime;
@@ -281,6 +395,9 @@ bool ecs_os_has_threading(void) {
         (ecs_os_api.cond_wait_ != NULL) &&
         (ecs_os_api.cond_signal_ != NULL) &&
         (ecs_os_api.cond_broadcast_ != NULL) &&
+        (ecs_os_api.barrier_new_ != NULL) &&
+        (ecs_os_api.barrier_free_ != NULL) &&
+        (ecs_os_api.barrier_wait_ != NULL) &&
         (ecs_os_api.thread_new_ != NULL) &&
         (ecs_os_api.thread_join_ != NULL);   
 }
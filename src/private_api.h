@@ -112,6 +112,10 @@ void ecs_monitor_register(
     ecs_entity_t id,
     ecs_query_t *query);
 
+/* Invalidate bases cached by tables for inherited components */
+void ecs_monitor_invalidate_bases(
+    ecs_world_t *world);
+
 void ecs_notify_tables(
     ecs_world_t *world,
     ecs_id_t id,
@@ -177,6 +181,11 @@ void ecs_stage_deinit(
     ecs_world_t *world,
     ecs_stage_t *stage);
 
+/* Create new entity id from stage while world is readonly */
+ecs_entity_t ecs_stage_new_id(
+    ecs_world_t *world,
+    ecs_stage_t *stage);
+
 /* Post-frame merge actions */
 void ecs_stage_merge_post_frame(
     ecs_world_t *world,
@@ -266,6 +275,60 @@ bool ecs_defer_flush(
     ecs_world_t *world,
     ecs_stage_t *stage);
 
+/* Get next operation in defer queue. Pass NULL for op to get the first. */
+ecs_op_t* ecs_defer_next(
+    const ecs_defer_queue_t *queue,
+    ecs_defer_chunk_t **chunk,
+    ecs_op_t *op);
+
+/* Empty defer queue, keeping its memory for reuse */
+void ecs_defer_reset(
+    ecs_defer_queue_t *queue);
+
+/* Free memory of defer queue */
+void ecs_defer_fini(
+    ecs_defer_queue_t *queue);
+
+////////////////////////////////////////////////////////////////////////////////
+//// Hierarchy API
+////////////////////////////////////////////////////////////////////////////////
+
+/** Add name of entity to the name indices of its parents, and to the symbol
+ * index. The entity must be stored in a table. */
+void ecs_name_index_add(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    const EcsName *name);
+
+/** Remove name of entity from the name indices of its parents, and from the
+ * symbol index. */
+void ecs_name_index_remove(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    const EcsName *name);
+
+/** Add names of a range of entities in a table to the name indices */
+void ecs_name_index_table(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    int32_t row,
+    int32_t count);
+
+/** Move names of a range of entities in src_table to the name indices of the
+ * parents of dst_table. If dst_table is NULL, names are removed. */
+void ecs_name_index_move(
+    ecs_world_t *world,
+    ecs_table_t *dst_table,
+    ecs_table_t *src_table,
+    ecs_data_t *src_data,
+    int32_t row,
+    int32_t count);
+
+/** Free name index */
+void ecs_name_index_free(
+    ecs_map_t *index);
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Type API
 ////////////////////////////////////////////////////////////////////////////////
@@ -435,6 +498,11 @@ int32_t ecs_table_appendn(
     int32_t count,
     const ecs_entity_t *ids);
 
+/* Shrink table storage if it uses much less than it has allocated */
+bool ecs_table_shrink(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
 /* Set table to a fixed size. Useful for preallocating memory in advance. */
 void ecs_table_set_size(
     ecs_world_t *world,
@@ -497,6 +565,14 @@ void ecs_table_swap(
     int32_t row_1,
     int32_t row_2);
 
+/* Move row to another position, shifting the rows in between */
+void ecs_table_move_row(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    int32_t row_from,
+    int32_t row_to);
+
 ecs_table_t *ecs_table_traverse_add(
     ecs_world_t *world,
     ecs_table_t *table,
@@ -531,6 +607,14 @@ void ecs_table_clear_edges(
     ecs_world_t *world,
     ecs_table_t *table);
 
+/* Clear edges that point to tables that are marked for deletion */
+void ecs_table_clear_edges_to_deleted(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
+int32_t ecs_table_edges_memory(
+    ecs_table_t *table);
+
 void ecs_table_delete_entities(
     ecs_world_t *world,
     ecs_table_t *table);
@@ -35,6 +35,10 @@
 
 #define ECS_MAX_JOBS_PER_WORKER (16)
 
+/* Bounds for the number of entity ids a worker stage reserves per frame */
+#define ECS_ID_BLOCK_MIN (64)
+#define ECS_ID_BLOCK_MAX (64 * 1024)
+
 /** These values are used to verify validity of the pointers passed into the API
  * and to allow for passing a thread as a world to some API calls (this allows
  * for transparently passing thread context to API functions) */
@@ -138,6 +142,9 @@ typedef struct ecs_table_leaf_t {
 #define EcsTableHasMonitors         32768u
 #define EcsTableHasSwitch           65536u
 #define EcsTableHasDisabled         131072u
+#define EcsTableHasName             262144u   /**< Does the table have EcsName */
+#define EcsTableIsPinned            524288u   /**< Is table type used as ecs_type_t */
+#define EcsTableMarkedForDelete     1048576u  /**< Is table about to be deleted */
 
 /* Composite constants */
 #define EcsTableHasLifecycle        (EcsTableHasCtors | EcsTableHasDtors)
@@ -145,12 +152,37 @@ typedef struct ecs_table_leaf_t {
 #define EcsTableHasAddActions       (EcsTableHasBase | EcsTableHasSwitch | EcsTableHasCtors | EcsTableHasOnAdd | EcsTableHasOnSet | EcsTableHasMonitors)
 #define EcsTableHasRemoveActions    (EcsTableHasBase | EcsTableHasDtors | EcsTableHasOnRemove | EcsTableHasUnSet | EcsTableHasMonitors)
 
+/** Cached result of looking up an inherited component for a table. An element
+ * is valid as long as the monitor generation has not changed, and the base is
+ * still stored in the same table. */
+typedef struct ecs_base_elem_t {
+    ecs_entity_t base;              /**< Base that has the component, 0 if none */
+    ecs_table_t *table;             /**< Table of base */
+    int32_t column;                 /**< Column of component in base table */
+    int32_t generation;             /**< Monitor generation of cached result */
+} ecs_base_elem_t;
+
 /** Edge used for traversing the table graph. */
 typedef struct ecs_edge_t {
     ecs_table_t *add;               /**< Edges traversed when adding */
     ecs_table_t *remove;            /**< Edges traversed when removing */
 } ecs_edge_t;
 
+/** Edge stored with the id it is stored for. */
+typedef struct ecs_edge_elem_t {
+    ecs_id_t id;                    /**< Id of edge, 0 if slot is empty */
+    ecs_edge_t edge;
+} ecs_edge_elem_t;
+
+/** Open addressed hash for edges with low ids. Because low ids are small and
+ * mostly sequential, the id itself is used as hash. This keeps lookups almost
+ * as cheap as indexing an array, while only storing the edges that are used. */
+typedef struct ecs_edge_cache_t {
+    ecs_edge_elem_t *elems;         /**< Slots, size is a power of 2 */
+    int32_t count;                  /**< Number of occupied slots */
+    int32_t size;                   /**< Number of slots */
+} ecs_edge_cache_t;
+
 /** Quey matched with table with backref to query table administration.
  * This type is used to store a matched query together with the array index of
  * where the table is stored in the query administration. This type is used when
@@ -175,9 +207,13 @@ struct ecs_table_t {
     ecs_data_t *data;                /**< Component storage */
     ecs_type_info_t **c_info;        /**< Cached pointers to component info */
 
-    ecs_edge_t *lo_edges;            /**< Edges to other tables */
+    ecs_edge_cache_t lo_edges;       /**< Edges to other tables */
     ecs_map_t *hi_edges;
 
+    int16_t *lo_column_map;          /**< Type index + 1 for ids < HI_COMPONENT_ID */
+    int32_t lo_column_count;         /**< Number of elements in lo_column_map */
+    ecs_map_t *base_cache;           /**< Resolved bases for inherited ids */
+
     ecs_vector_t *queries;           /**< Queries matched with table */
     ecs_vector_t *monitors;          /**< Monitor systems matched with table */
     ecs_vector_t **on_set;           /**< OnSet systems, broken up by column */
@@ -187,6 +223,7 @@ struct ecs_table_t {
 
     int32_t *dirty_state;            /**< Keep track of changes in columns */
     int32_t alloc_count;             /**< Increases when columns are reallocd */
+    int32_t gc_count;                /**< Number of frames table has been empty */
 
     int32_t sw_column_count;
     int32_t sw_column_offset;
@@ -311,6 +348,9 @@ struct ecs_query_t {
     ecs_flags32_t flags;
 
     uint64_t id;                /* Id of query in query storage */
+    ecs_id_t index_id;          /* Id record the query is registered with */
+    ecs_id_t index_rel_id;      /* (relation, *) record for matching bases */
+    int32_t match_stamp;        /* Prevents notifying query twice for table */
     int32_t cascade_by;         /* Identify CASCADE column */
     int32_t match_count;        /* How often have tables been (un)matched */
     int32_t prev_match_count;   /* Used to track if sorting is needed */
@@ -375,6 +415,7 @@ typedef struct ecs_op_n_t {
 
 typedef struct ecs_op_t {
     ecs_op_kind_t kind;         /* Operation kind */    
+    ecs_size_t stride;          /* Size of operation and payload in queue */
     ecs_entity_t component;     /* Single component (components.count = 1) */
     ecs_ids_t components;  /* Multiple components */
     union {
@@ -383,6 +424,42 @@ typedef struct ecs_op_t {
     } is;
 } ecs_op_t;
 
+/** Chunk in the queue with deferred operations.
+ * Operations are stored inline in the chunk, directly followed by their
+ * payload (component values, id arrays). Chunks are never reallocated, so that
+ * pointers to the payload remain valid until the queue is flushed. */
+typedef struct ecs_defer_chunk_t {
+    struct ecs_defer_chunk_t *next;
+    ecs_size_t size;            /* Number of bytes available for operations */
+    ecs_size_t used;            /* Number of bytes used by operations */
+} ecs_defer_chunk_t;
+
+/** Queue with deferred operations.
+ * The queue is a bump allocator. After it has been flushed the chunks are
+ * reset and reused, so that deferring operations doesn't allocate. */
+typedef struct ecs_defer_queue_t {
+    ecs_defer_chunk_t *first;
+    ecs_defer_chunk_t *cur;     /* Chunk to which operations are added */
+    int32_t count;              /* Number of operations in queue */
+} ecs_defer_queue_t;
+
+/** Job for the work stealing scheduler.
+ * A job is a chunk of a table matched by a system, which can be ran by any of
+ * the worker threads. */
+typedef struct ecs_worker_job_t {
+    ecs_iter_t it;                  /* Iterator prepared for the chunk */
+    ecs_iter_action_t action;       /* System action */
+} ecs_worker_job_t;
+
+/** Job queue of a worker.
+ * The worker that owns the queue takes jobs from the back, idle workers steal
+ * jobs from the front. */
+typedef struct ecs_job_queue_t {
+    ecs_vector_t *jobs;             /* vector<ecs_worker_job_t> */
+    int32_t head;                   /* First job that hasn't been stolen */
+    ecs_os_mutex_t lock;            /* Protects jobs and head */
+} ecs_job_queue_t;
+
 /** A stage is a data structure in which delta's are stored until it is safe to
  * merge those delta's with the main world stage. A stage allows flecs systems
  * to arbitrarily add/remove/set components and create/delete entities while
@@ -394,15 +471,22 @@ struct ecs_stage_t {
 
     /* Are operations deferred? */
     int32_t defer;
-    ecs_vector_t *defer_queue;
+    ecs_defer_queue_t defer_queue;
 
     ecs_world_t *thread_ctx;    /* Points to stage when a thread stage */
     ecs_world_t *world;         /* Reference to world */
     ecs_os_thread_t thread;     /* Thread handle (0 if no threading is used) */
+    ecs_job_queue_t job_queue;  /* Jobs when work stealing is enabled */
 
     /* One-shot actions to be executed after the merge */
     ecs_vector_t *post_frame_actions;
 
+    /* Entity ids reserved for this stage while the world is readonly */
+    ecs_vector_t *id_block;        /* vector<ecs_entity_t> */
+    int32_t id_block_index;        /* Next id to hand out from block */
+    int32_t id_block_size;         /* Number of ids to reserve for next block */
+    int32_t id_new_count;          /* Ids created since block was reserved */
+
     /* Namespacing */
     ecs_table_t *scope_table;      /* Table for current scope */
     ecs_entity_t scope;            /* Entity of current scope */
@@ -429,6 +513,7 @@ typedef struct ecs_monitor_set_t {
 typedef struct ecs_relation_monitor_t {
     ecs_map_t *monitor_sets; /* map<relation_id, ecs_monitor_set_t> */
     bool is_dirty;          /* Should monitor sets be evaluated? */
+    int32_t generation;     /* Increases when a watched entity changes table */
 } ecs_relation_monitor_t;
 
 /* Payload for table index which returns all tables for a given component, with
@@ -439,11 +524,26 @@ typedef struct ecs_table_record_t {
     int32_t count;
 } ecs_table_record_t;
 
+/* Element of a name index. Most hashes map to a single entity, which is stored
+ * inline. Entities with the same name (or a colliding hash) are stored in the
+ * collisions vector. */
+typedef struct ecs_name_index_elem_t {
+    ecs_entity_t entity;
+    ecs_vector_t *collisions;       /* vector<ecs_entity_t> */
+} ecs_name_index_elem_t;
+
 /* Payload for id index which contains all datastructures for an id. */
 typedef struct ecs_id_record_t {
     /* All tables that contain the id */
     ecs_map_t *table_index;         /* map<table_id, ecs_table_record_t> */
 
+    /* Names of entities in tables with the id. Only used for ChildOf pairs, to
+     * find children of a parent by name. */
+    ecs_map_t *name_index;          /* map<name_hash, ecs_name_index_elem_t> */
+
+    /* Queries that need to be notified of tables with the id */
+    ecs_vector_t *queries;          /* vector<ecs_query_t*> */
+
     ecs_entity_t on_delete;         /* Cleanup action for removing id */
     ecs_entity_t on_delete_object;  /* Cleanup action for removing object */
 } ecs_id_record_t;
@@ -498,12 +598,20 @@ struct ecs_world_t {
     /* --  Type metadata -- */
 
     ecs_map_t *id_index;         /* map<id, ecs_id_record_t> */
+    ecs_id_record_t **id_index_lo; /* Id records for ids < HI_COMPONENT_ID */
     ecs_map_t *id_triggers;      /* map<id, ecs_id_trigger_t> */
     ecs_sparse_t *type_info;     /* sparse<type_id, type_info_t> */
 
     /* Is entity range checking enabled? */
     bool range_check_enabled;
 
+    /* Delete tables that have been empty for more frames (0 = disabled) */
+    int32_t table_gc_frames;
+
+    /* Number of alive snapshots. Tables are not deleted while snapshots, which
+     * store table pointers, are alive. */
+    int32_t snapshot_count;
+
 
     /* --  Data storage -- */
 
@@ -513,6 +621,8 @@ struct ecs_world_t {
     /* --  Storages for API objects -- */
 
     ecs_sparse_t *queries; /* sparse<query_id, ecs_query_t> */
+    ecs_vector_t *unindexed_queries; /* Queries not in id index */
+    int32_t query_match_stamp; /* Incremented for each table (un)match */
     ecs_sparse_t *triggers; /* sparse<query_id, ecs_trigger_t> */
     ecs_sparse_t *observers; /* sparse<query_id, ecs_observer_t> */
     
@@ -554,15 +664,17 @@ struct ecs_world_t {
     /* -- Hierarchy administration -- */
 
     const char *name_prefix;        /* Remove prefix from C names in modules */
+    ecs_map_t *symbol_index;        /* map<symbol_hash, ecs_name_index_elem_t> */
 
 
     /* -- Multithreading -- */
 
-    ecs_os_cond_t worker_cond;       /* Signal that worker threads can start */
-    ecs_os_cond_t sync_cond;         /* Signal that worker thread job is done */
-    ecs_os_mutex_t sync_mutex;       /* Mutex for job_cond */
+    ecs_os_barrier_t start_barrier;  /* Signal that worker threads can start */
+    ecs_os_barrier_t sync_barrier;   /* Signal that worker thread job is done */
+    ecs_os_barrier_t level_barrier;  /* Synchronizes levels of parallel systems */
     int32_t workers_running;         /* Number of threads running */
-    int32_t workers_waiting;         /* Number of workers waiting on sync */
+    bool work_stealing;              /* Distribute work with job queues */
+    bool parallel_systems;           /* Run systems in parallel */
 
 
     /* -- Time management -- */
@@ -611,6 +723,7 @@ struct ecs_world_t {
     bool measure_system_time;     /* Time spent by each system */
     bool should_quit;             /* Did a system signal that app should quit */
     bool locking_enabled;         /* Lock world when in progress */ 
+    bool defer_batching;          /* Batch deferred add/remove operations */
 
     void *context;               /* Application context */
     ecs_vector_t *fini_actions;  /* Callbacks to execute when world exits */
@@ -4,6 +4,11 @@
 #include "modules/system/system.h"
 #endif
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#define ECS_QUERY_AVX2
+#endif
+
 static
 void activate_table(
     ecs_world_t *world,
@@ -943,27 +948,248 @@ bool ecs_query_match(
     return true;
 }
 
+static
+int32_t id_table_count(
+    const ecs_world_t *world,
+    ecs_id_t id)
+{
+    ecs_id_record_t *r = ecs_get_id_record(world, id);
+    if (!r) {
+        return 0;
+    }
+    return ecs_map_count(r->table_index);
+}
+
+static
+bool is_index_id(
+    ecs_id_t id)
+{
+    if (ECS_HAS_ROLE(id, PAIR)) {
+        ecs_entity_t rel = ECS_PAIR_RELATION(id);
+        ecs_entity_t obj = ECS_PAIR_OBJECT(id);
+        return rel && obj && rel != EcsThis && obj != EcsThis;
+    }
+
+    return id && !(id & ECS_ROLE_MASK) && id != EcsWildcard && id != EcsThis;
+}
+
+static
+void add_index_query(
+    ecs_world_t *world,
+    ecs_id_t id,
+    ecs_query_t *query)
+{
+    ecs_id_record_t *r = ecs_ensure_id_record(world, id);
+    ecs_query_t **elem = ecs_vector_add(&r->queries, ecs_query_t*);
+    *elem = query;
+}
+
+static
+void remove_index_query(
+    ecs_vector_t *queries,
+    ecs_query_t *query)
+{
+    int32_t i, count = ecs_vector_count(queries);
+    ecs_query_t **q_ptr = ecs_vector_first(queries, ecs_query_t*);
+
+    for (i = 0; i < count; i ++) {
+        if (q_ptr[i] == query) {
+            ecs_vector_remove(queries, ecs_query_t*, i);
+            break;
+        }
+    }
+}
+
+/* Register query with the id index, so that only tables that have the id of
+ * one of its terms are matched with the query. A table can only match an And
+ * term for This if it has the term id, or if it has the relation that is used
+ * to find the id on a base. Of the eligible terms, the one with the fewest
+ * tables is used. */
+static
+void register_query_index(
+    ecs_world_t *world,
+    ecs_query_t *query)
+{
+    ecs_term_t *terms = query->filter.terms;
+    int32_t i, count = query->filter.term_count;
+    int32_t min_count = -1;
+
+    for (i = 0; i < count; i ++) {
+        ecs_term_t *term = &terms[i];
+        ecs_term_id_t *subj = &term->args[0];
+
+        if (term->oper != EcsAnd || subj->entity != EcsThis) {
+            continue;
+        }
+
+        if (!is_index_id(term->id)) {
+            continue;
+        }
+
+        ecs_id_t id = 0, rel_id = 0;
+        int32_t table_count = 0;
+
+        if (!subj->set.min_depth) {
+            id = term->id;
+            table_count += id_table_count(world, id);
+        }
+
+        if (subj->set.relation) {
+            rel_id = ecs_pair(subj->set.relation, EcsWildcard);
+            table_count += id_table_count(world, rel_id);
+        }
+
+        if (!id && !rel_id) {
+            continue;
+        }
+
+        if (min_count == -1 || table_count < min_count) {
+            query->index_id = id;
+            query->index_rel_id = rel_id;
+            min_count = table_count;
+        }
+    }
+
+    if (query->index_id) {
+        add_index_query(world, query->index_id, query);
+    }
+    if (query->index_rel_id) {
+        add_index_query(world, query->index_rel_id, query);
+    }
+
+    if (min_count == -1) {
+        ecs_query_t **elem = ecs_vector_add(
+            &world->unindexed_queries, ecs_query_t*);
+        *elem = query;
+    }
+}
+
+static
+void unregister_query_index(
+    ecs_world_t *world,
+    ecs_query_t *query)
+{
+    ecs_id_t ids[] = { query->index_id, query->index_rel_id };
+    int32_t i;
+
+    if (!ids[0] && !ids[1]) {
+        remove_index_query(world->unindexed_queries, query);
+        return;
+    }
+
+    for (i = 0; i < 2; i ++) {
+        ecs_id_record_t *r = ecs_get_id_record(world, ids[i]);
+        if (!ids[i] || !r) {
+            continue;
+        }
+
+        remove_index_query(r->queries, query);
+
+        if (!ecs_map_count(r->table_index) && !ecs_vector_count(r->queries)) {
+            ecs_clear_id_record(world, ids[i]);
+        }
+    }
+}
+
+static
+int compare_table_id(
+    const void *ptr1,
+    const void *ptr2)
+{
+    const ecs_table_t *t1 = *(ecs_table_t* const*)ptr1;
+    const ecs_table_t *t2 = *(ecs_table_t* const*)ptr2;
+    return (t1->id > t2->id) - (t1->id < t2->id);
+}
+
+/* Get tables that can match the query. If the query is not registered with
+ * the id index, this returns NULL and all tables should be evaluated. */
+static
+ecs_vector_t* get_candidate_tables(
+    ecs_world_t *world,
+    ecs_query_t *query)
+{
+    if (!query->index_id && !query->index_rel_id) {
+        return NULL;
+    }
+
+    ecs_vector_t *result = ecs_vector_new(ecs_table_t*, 0);
+
+    ecs_map_t *id_tables = NULL;
+    if (query->index_id) {
+        ecs_id_record_t *r = ecs_get_id_record(world, query->index_id);
+        id_tables = r ? r->table_index : NULL;
+
+        ecs_map_iter_t it = ecs_map_iter(id_tables);
+        ecs_table_record_t *tr;
+        while ((tr = ecs_map_next(&it, ecs_table_record_t, NULL))) {
+            ecs_table_t **elem = ecs_vector_add(&result, ecs_table_t*);
+            *elem = tr->table;
+        }
+    }
+
+    if (query->index_rel_id) {
+        ecs_id_record_t *r = ecs_get_id_record(world, query->index_rel_id);
+        ecs_map_iter_t it = ecs_map_iter(r ? r->table_index : NULL);
+        ecs_table_record_t *tr;
+        ecs_map_key_t table_id;
+        while ((tr = ecs_map_next(&it, ecs_table_record_t, &table_id))) {
+            /* Don't add tables twice if they also have the id */
+            if (ecs_map_get(id_tables, ecs_table_record_t, table_id)) {
+                continue;
+            }
+            ecs_table_t **elem = ecs_vector_add(&result, ecs_table_t*);
+            *elem = tr->table;
+        }
+    }
+
+    /* Match tables in the order in which they were created, which keeps the
+     * order of the matched tables the same as when scanning the storage */
+    int32_t count = ecs_vector_count(result);
+    if (count > 1) {
+        qsort(ecs_vector_first(result, ecs_table_t*), (size_t)count, 
+            ECS_SIZEOF(ecs_table_t*), compare_table_id);
+    }
+
+    return result;
+}
+
 /** Match existing tables against system (table is created before system) */
 static
 void match_tables(
     ecs_world_t *world,
     ecs_query_t *query)
 {
-    int32_t i, count = ecs_sparse_count(world->store.tables);
+    ecs_vector_t *candidates = get_candidate_tables(world, query);
+    int32_t i, count;
 
-    for (i = 0; i < count; i ++) {
-        ecs_table_t *table = ecs_sparse_get(
-            world->store.tables, ecs_table_t, i);
+    if (candidates) {
+        ecs_table_t **tables = ecs_vector_first(candidates, ecs_table_t*);
+        count = ecs_vector_count(candidates);
 
-        if (ecs_query_match(world, table, query, NULL)) {
-            add_table(world, query, table);
+        for (i = 0; i < count; i ++) {
+            if (ecs_query_match(world, tables[i], query, NULL)) {
+                add_table(world, query, tables[i]);
+            }
+        }
+
+        ecs_vector_free(candidates);
+    } else {
+        count = ecs_sparse_count(world->store.tables);
+
+        for (i = 0; i < count; i ++) {
+            ecs_table_t *table = ecs_sparse_get(
+                world->store.tables, ecs_table_t, i);
+
+            if (ecs_query_match(world, table, query, NULL)) {
+                add_table(world, query, table);
+            }
         }
     }
 
     order_ranked_tables(world, query);
 }
 
-#define ELEM(ptr, size, index) ECS_OFFSET(ptr, size * index)
+#define ELEM(ptr, size, index) ECS_OFFSET(ptr, (size) * (index))
 
 static
 int32_t qsort_partition(
@@ -1037,22 +1263,91 @@ void qsort_array(
     qsort_array(world, table, data, entities, ptr, size, p + 1, hi, compare); 
 }
 
+/* Find the row before which row i should be inserted in the sorted range
+ * [0, i). Rows that are out of order are usually close to their position, so
+ * the search gallops back from the end of the range before doing a binary
+ * search. Equal rows are kept in their current order. */
 static
-void sort_table(
+int32_t gallop_insert_row(
+    ecs_entity_t *entities,
+    void *ptr,
+    int32_t size,
+    int32_t i,
+    ecs_compare_action_t compare)
+{
+    ecs_entity_t e = entities[i];
+    const void *el = ELEM(ptr, size, i);
+    int32_t hi = i - 1, lo = hi - 1, step = 1;
+
+    /* Row hi is always larger than row i */
+    while (lo >= 0 && compare(entities[lo], ELEM(ptr, size, lo), e, el) > 0) {
+        hi = lo;
+        step *= 2;
+        lo = hi - step;
+    }
+
+    if (lo < -1) {
+        lo = -1;
+    }
+
+    while ((hi - lo) > 1) {
+        int32_t mid = lo + (hi - lo) / 2;
+        if (compare(entities[mid], ELEM(ptr, size, mid), e, el) > 0) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+
+    return hi;
+}
+
+static
+void insertion_sort_array(
     ecs_world_t *world,
     ecs_table_t *table,
-    int32_t column_index,
+    ecs_data_t *data,
+    ecs_entity_t *entities,
+    void *ptr,
+    int32_t size,
+    int32_t first,
+    int32_t count,
     ecs_compare_action_t compare)
+{
+    int32_t i;
+    for (i = first; i < count; i ++) {
+        if (compare(entities[i - 1], ELEM(ptr, size, i - 1), 
+            entities[i], ELEM(ptr, size, i)) <= 0) 
+        {
+            continue;
+        }
+
+        int32_t row = gallop_insert_row(entities, ptr, size, i, compare);
+        ecs_table_move_row(world, table, data, i, row);
+    }
+}
+
+/* Sort a table. Tables that were sorted before are usually still mostly in
+ * order, as new entities are appended to the end of a table and a deleted
+ * entity is replaced with the last entity in the table. For those tables only
+ * the rows that are out of order are moved. Returns whether rows were moved. */
+static
+bool sort_table(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    int32_t column_index,
+    ecs_compare_action_t compare,
+    bool was_sorted)
 {
     ecs_data_t *data = ecs_table_get_data(table);
     if (!data || !data->entities) {
         /* Nothing to sort */
-        return;
+        return false;
     }
 
     int32_t count = ecs_table_data_count(data);
     if (count < 2) {
-        return;
+        return false;
     }
 
     ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
@@ -1065,7 +1360,44 @@ void sort_table(
         ptr = ecs_vector_first_t(column->data, size, column->alignment);
     }
 
-    qsort_array(world, table, data, entities, ptr, size, 0, count - 1, compare);
+    if (!was_sorted) {
+        qsort_array(
+            world, table, data, entities, ptr, size, 0, count - 1, compare);
+        return true;
+    }
+
+    /* Count rows that are out of order */
+    int32_t i, first = 0, unordered = 0, max_unordered = 1;
+    for (i = count; i > 1; i /= 2) {
+        max_unordered ++;
+    }
+
+    for (i = 1; i < count; i ++) {
+        if (compare(entities[i - 1], ELEM(ptr, size, i - 1), 
+            entities[i], ELEM(ptr, size, i)) > 0) 
+        {
+            if (!unordered) {
+                first = i;
+            }
+            if (++ unordered > max_unordered) {
+                break;
+            }
+        }
+    }
+
+    if (!unordered) {
+        return false;
+    }
+
+    if (unordered <= max_unordered) {
+        insertion_sort_array(
+            world, table, data, entities, ptr, size, first, count, compare);
+    } else {
+        qsort_array(
+            world, table, data, entities, ptr, size, 0, count - 1, compare);
+    }
+
+    return true;
 }
 
 /* Helper struct for building sorted table ranges */
@@ -1094,14 +1426,48 @@ const void* ptr_from_helper(
 }
 
 static
-ecs_entity_t e_from_helper(
-    sort_helper_t *helper)
+bool helper_less(
+    sort_helper_t *helper,
+    int32_t h1,
+    int32_t h2,
+    ecs_compare_action_t compare)
 {
-    if (helper->row < helper->count) {
-        return helper->entities[helper->row];
-    } else {
-        return 0;
-    }
+    sort_helper_t *helper_1 = &helper[h1];
+    sort_helper_t *helper_2 = &helper[h2];
+    int ret = compare(
+        helper_1->entities[helper_1->row], ptr_from_helper(helper_1),
+        helper_2->entities[helper_2->row], ptr_from_helper(helper_2));
+    return ret < 0 || (ret == 0 && h1 < h2);
+}
+
+static
+void heap_sift_down(
+    sort_helper_t *helper,
+    int32_t *heap,
+    int32_t count,
+    int32_t i,
+    ecs_compare_action_t compare)
+{
+    do {
+        int32_t min = i, child = i * 2 + 1;
+        if (child < count && helper_less(helper, heap[child], heap[min], compare)) {
+            min = child;
+        }
+
+        child ++;
+        if (child < count && helper_less(helper, heap[child], heap[min], compare)) {
+            min = child;
+        }
+
+        if (min == i) {
+            break;
+        }
+
+        int32_t tmp = heap[i];
+        heap[i] = heap[min];
+        heap[min] = tmp;
+        i = min;
+    } while (true);
 }
 
 static
@@ -1164,42 +1530,23 @@ void build_sorted_table_range(
         to_sort ++;      
     }
 
-    ecs_table_slice_t *cur = NULL;
-
-    bool proceed;
-    do {
-        int32_t j, min = 0;
-        proceed = true;
-
-        ecs_entity_t e1;
-        while (!(e1 = e_from_helper(&helper[min]))) {
-            min ++;
-            if (min == to_sort) {
-                proceed = false;
-                break;
-            }
-        }
-
-        if (!proceed) {
-            break;
-        }
-
-        for (j = min + 1; j < to_sort; j++) {
-            ecs_entity_t e2 = e_from_helper(&helper[j]);
-            if (!e2) {
-                continue;
-            }
+    /* Merge the sorted tables with a heap that is ordered by the current row
+     * of each table. Equal rows are ordered by table, so that the result is
+     * the same as that of a linear scan over the tables. */
+    int32_t *heap = ecs_os_malloc(to_sort * ECS_SIZEOF(int32_t));
+    for (i = 0; i < to_sort; i ++) {
+        heap[i] = i;
+    }
 
-            const void *ptr1 = ptr_from_helper(&helper[min]);
-            const void *ptr2 = ptr_from_helper(&helper[j]);
+    int32_t heap_count = to_sort;
+    for (i = heap_count / 2 - 1; i >= 0; i --) {
+        heap_sift_down(helper, heap, heap_count, i, compare);
+    }
 
-            if (compare(e1, ptr1, e2, ptr2) > 0) {
-                min = j;
-                e1 = e_from_helper(&helper[min]);
-            }
-        }
+    ecs_table_slice_t *cur = NULL;
 
-        sort_helper_t *cur_helper = &helper[min];
+    while (heap_count) {
+        sort_helper_t *cur_helper = &helper[heap[0]];
         if (!cur || cur->table != cur_helper->table) {
             cur = ecs_vector_add(&query->table_slices, ecs_table_slice_t);
             ecs_assert(cur != NULL, ECS_INTERNAL_ERROR, NULL);
@@ -1211,8 +1558,14 @@ void build_sorted_table_range(
         }
 
         cur_helper->row ++;
-    } while (proceed);
+        if (cur_helper->row == cur_helper->count) {
+            heap[0] = heap[-- heap_count];
+        }
+
+        heap_sift_down(helper, heap, heap_count, 0, compare);
+    }
 
+    ecs_os_free(heap);
     ecs_os_free(helper);
 }
 
@@ -1324,24 +1677,28 @@ void sort_tables(
     int32_t i, count = ecs_vector_count(query->tables);
     ecs_matched_table_t *tables = ecs_vector_first(
         query->tables, ecs_matched_table_t);
-    bool tables_sorted = false;
+    bool rebuild = query->match_count != query->prev_match_count;
 
     for (i = 0; i < count; i ++) {
         ecs_matched_table_t *table_data = &tables[i];
         ecs_table_t *table = table_data->iter_data.table;
 
         /* If no monitor had been created for the table yet, create it now */
-        bool is_dirty = false;
+        bool is_dirty = false, was_sorted = true;
         if (!table_data->monitor) {
             table_data->monitor = ecs_table_get_monitor(table);
 
             /* A new table is always dirty */
             is_dirty = true;
+            was_sorted = false;
         }
 
         int32_t *dirty_state = ecs_table_get_dirty_state(table);
 
+        /* If entities have been added or removed the table ranges have to be
+         * rebuilt, even if the table itself does not need to be sorted */
         is_dirty = is_dirty || (dirty_state[0] != table_data->monitor[0]);
+        rebuild = rebuild || is_dirty;
 
         int32_t index = -1;
         if (sort_on_component) {
@@ -1359,15 +1716,16 @@ void sort_tables(
         }      
         
         /* Check both if entities have moved (element 0) or if the component
-         * we're sorting on has changed (index + 1) */
+         * we're sorting on has changed (index + 1). A table of which only the
+         * component values changed doesn't need new ranges if its rows are
+         * still in order. */
         if (is_dirty) {
-            /* Sort the table */
-            sort_table(world, table, index, compare);
-            tables_sorted = true;
+            rebuild = sort_table(world, table, index, compare, was_sorted) || 
+                rebuild;
         }
     }
 
-    if (tables_sorted || query->match_count != query->prev_match_count) {
+    if (rebuild) {
         build_sorted_tables(query);
         query->match_count ++; /* Increase version if tables changed */
     }
@@ -2026,13 +2384,21 @@ void rematch_tables(
             rematch_table(world, query, table);
         }        
     } else {
-        ecs_sparse_t *tables = world->store.tables;
-        int32_t i, count = ecs_sparse_count(tables);
+        ecs_vector_t *candidates = get_candidate_tables(world, query);
+        if (candidates) {
+            ecs_vector_each(candidates, ecs_table_t*, table, {
+                rematch_table(world, query, *table);
+            });
+            ecs_vector_free(candidates);
+        } else {
+            ecs_sparse_t *tables = world->store.tables;
+            int32_t i, count = ecs_sparse_count(tables);
 
-        for (i = 0; i < count; i ++) {
-            /* Is the system currently matched with the table? */
-            ecs_table_t *table = ecs_sparse_get(tables, ecs_table_t, i);
-            rematch_table(world, query, table);
+            for (i = 0; i < count; i ++) {
+                /* Is the system currently matched with the table? */
+                ecs_table_t *table = ecs_sparse_get(tables, ecs_table_t, i);
+                rematch_table(world, query, table);
+            }
         }
     }
 
@@ -2154,6 +2520,10 @@ ecs_query_t* ecs_query_init(
 
     process_signature(world, result);
 
+    if (result->flags & EcsQueryNeedsTables) {
+        register_query_index(world, result);
+    }
+
     ecs_trace_2("query #[green]%s#[reset] created with expression #[red]%s", 
         query_name(world, result), result->filter.expr);
 
@@ -2221,6 +2591,8 @@ void ecs_query_fini(
         .kind = EcsQueryOrphan
     });
 
+    unregister_query_index(world, query);
+
     ecs_vector_each(query->empty_tables, ecs_matched_table_t, table, {
         if (!(query->flags & EcsQueryIsSubquery)) {
             ecs_table_notify(world, table->iter_data.table, &(ecs_table_event_t){
@@ -2442,6 +2814,74 @@ int find_smallest_column(
     return index;
 }
 
+/* If the number of entities in the table is less than the number of entities
+ * for a case times this ratio, the switch column is scanned for contiguous runs
+ * of the case. Otherwise the linked list of the case is followed, which returns
+ * one entity at a time. */
+#define SPARSE_SCAN_RATIO (32)
+
+/* Test if all sparse columns match the row */
+static
+bool sparse_row_match(
+    ecs_sparse_column_t *columns,
+    int32_t count,
+    int32_t row)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        ecs_sparse_column_t *column = &columns[i];
+        uint64_t *values = ecs_vector_first(
+            column->sw_column->data->values, uint64_t);
+        if (values[row] != column->sw_case) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Find the next contiguous run of rows that match all sparse columns. The
+ * first column is tested inline, as most queries have a single case term. */
+static
+int sparse_column_scan(
+    ecs_sparse_column_t *columns,
+    int32_t count,
+    ecs_query_iter_t *iter,
+    ecs_page_cursor_t *cur)
+{
+    ecs_vector_t *values_vec = columns[0].sw_column->data->values;
+    uint64_t *values = ecs_vector_first(values_vec, uint64_t);
+    uint64_t sw_case = columns[0].sw_case;
+    int32_t row_count = ecs_vector_count(values_vec);
+    int32_t first = iter->sparse_first;
+
+    for (; first < row_count; first ++) {
+        if (values[first] == sw_case && 
+            sparse_row_match(&columns[1], count - 1, first)) 
+        {
+            break;
+        }
+    }
+
+    if (first == row_count) {
+        return -1;
+    }
+
+    int32_t last = first + 1;
+    for (; last < row_count; last ++) {
+        if (values[last] != sw_case || 
+            !sparse_row_match(&columns[1], count - 1, last)) 
+        {
+            break;
+        }
+    }
+
+    cur->first = first;
+    cur->count = last - first;
+    iter->sparse_first = last;
+
+    return 0;
+}
+
 static
 int sparse_column_next(
     ecs_table_t *table,
@@ -2453,16 +2893,33 @@ int sparse_column_next(
     bool first_iteration = false;
     int32_t sparse_smallest;
 
+    ecs_sparse_column_t *columns = ecs_vector_first(
+        sparse_columns, ecs_sparse_column_t);
+    int32_t i, count = ecs_vector_count(sparse_columns);
+
     if (!(sparse_smallest = iter->sparse_smallest)) {
         sparse_smallest = iter->sparse_smallest = find_smallest_column(
             table, matched_table, sparse_columns);
         first_iteration = true;
+
+        /* If the case is common, find runs of the case so that more than one
+         * entity can be returned at a time. */
+        ecs_sparse_column_t *column = &columns[sparse_smallest - 1];
+        ecs_switch_t *sw = column->sw_column->data;
+        int32_t case_count = ecs_switch_case_count(sw, column->sw_case);
+        iter->sparse_scan = case_count * SPARSE_SCAN_RATIO >= 
+            ecs_vector_count(sw->values);
+    }
+
+    if (iter->sparse_scan) {
+        if (sparse_column_scan(columns, count, iter, cur)) {
+            goto done;
+        }
+        return 0;
     }
 
     sparse_smallest -= 1;
 
-    ecs_sparse_column_t *columns = ecs_vector_first(
-        sparse_columns, ecs_sparse_column_t);
     ecs_sparse_column_t *column = &columns[sparse_smallest];
     ecs_switch_t *sw, *sw_smallest = column->sw_column->data;
     ecs_entity_t case_smallest = column->sw_case;
@@ -2480,7 +2937,6 @@ int sparse_column_next(
     }    
 
     /* Check if entity matches with other sparse columns, if any */
-    int32_t i, count = ecs_vector_count(sparse_columns);
     do {
         for (i = 0; i < count; i ++) {
             if (i == sparse_smallest) {
@@ -2509,12 +2965,91 @@ done:
      * next matched table. */
     iter->sparse_smallest = 0;
     iter->sparse_first = 0;
+    iter->sparse_scan = false;
 
     return -1;
 }
 
 #define BS_MAX ((uint64_t)0xFFFFFFFFFFFFFFFF)
 
+/* Get index of the first set bit in a bitset block */
+static
+int32_t bitset_first_set(
+    uint64_t v)
+{
+    ecs_assert(v != 0, ECS_INTERNAL_ERROR, NULL);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int32_t result = 0;
+    if (!(v & 0xFFFFFFFF)) {
+        v >>= 32;
+        result += 32;
+    }
+    while (!(v & 1)) {
+        v >>= 1;
+        result ++;
+    }
+    return result;
+#endif
+}
+
+/* Get a block of enabled elements for all bitset columns */
+static
+uint64_t bitset_block(
+    ecs_bitset_column_t *columns,
+    int32_t count,
+    int32_t block)
+{
+    uint64_t v = columns[0].bs_column->data.data[block];
+    int32_t i;
+    for (i = 1; i < count; i ++) {
+        v &= columns[i].bs_column->data.data[block];
+    }
+    return v;
+}
+
+/* Find the first block from block that is not equal to value. Runs of disabled
+ * elements are skipped with value 0, runs of enabled elements with BS_MAX. If
+ * all remaining blocks are equal to value, block_count is returned. */
+static
+int32_t bitset_skip(
+    ecs_bitset_column_t *columns,
+    int32_t count,
+    int32_t block,
+    int32_t block_count,
+    uint64_t value)
+{
+#ifdef ECS_QUERY_AVX2
+    __m256i expect = _mm256_set1_epi64x((long long)value);
+    for (; (block + 4) <= block_count; block += 4) {
+        __m256i v = _mm256_loadu_si256(
+            (const __m256i*)&columns[0].bs_column->data.data[block]);
+        int32_t i;
+        for (i = 1; i < count; i ++) {
+            v = _mm256_and_si256(v, _mm256_loadu_si256(
+                (const __m256i*)&columns[i].bs_column->data.data[block]));
+        }
+
+        __m256i diff = _mm256_xor_si256(v, expect);
+        if (!_mm256_testz_si256(diff, diff)) {
+            break;
+        }
+    }
+#endif
+
+    for (; block < block_count; block ++) {
+        if (bitset_block(columns, count, block) != value) {
+            break;
+        }
+    }
+
+    return block;
+}
+
+/* Find the next range of elements for which all bitset columns are enabled.
+ * Blocks of all columns are combined, so that a range is found in a single
+ * pass, and ranges are as large as possible. */
 static
 int bitset_column_next(
     ecs_table_t *table,
@@ -2522,179 +3057,85 @@ int bitset_column_next(
     ecs_query_iter_t *iter,
     ecs_page_cursor_t *cur)
 {
-    /* Precomputed single-bit test */
-    static const uint64_t bitmask[64] = {
-    (uint64_t)1 << 0, (uint64_t)1 << 1, (uint64_t)1 << 2, (uint64_t)1 << 3,
-    (uint64_t)1 << 4, (uint64_t)1 << 5, (uint64_t)1 << 6, (uint64_t)1 << 7,
-    (uint64_t)1 << 8, (uint64_t)1 << 9, (uint64_t)1 << 10, (uint64_t)1 << 11,
-    (uint64_t)1 << 12, (uint64_t)1 << 13, (uint64_t)1 << 14, (uint64_t)1 << 15,
-    (uint64_t)1 << 16, (uint64_t)1 << 17, (uint64_t)1 << 18, (uint64_t)1 << 19,
-    (uint64_t)1 << 20, (uint64_t)1 << 21, (uint64_t)1 << 22, (uint64_t)1 << 23,
-    (uint64_t)1 << 24, (uint64_t)1 << 25, (uint64_t)1 << 26, (uint64_t)1 << 27,  
-    (uint64_t)1 << 28, (uint64_t)1 << 29, (uint64_t)1 << 30, (uint64_t)1 << 31,
-    (uint64_t)1 << 32, (uint64_t)1 << 33, (uint64_t)1 << 34, (uint64_t)1 << 35,  
-    (uint64_t)1 << 36, (uint64_t)1 << 37, (uint64_t)1 << 38, (uint64_t)1 << 39,
-    (uint64_t)1 << 40, (uint64_t)1 << 41, (uint64_t)1 << 42, (uint64_t)1 << 43,
-    (uint64_t)1 << 44, (uint64_t)1 << 45, (uint64_t)1 << 46, (uint64_t)1 << 47,  
-    (uint64_t)1 << 48, (uint64_t)1 << 49, (uint64_t)1 << 50, (uint64_t)1 << 51,
-    (uint64_t)1 << 52, (uint64_t)1 << 53, (uint64_t)1 << 54, (uint64_t)1 << 55,  
-    (uint64_t)1 << 56, (uint64_t)1 << 57, (uint64_t)1 << 58, (uint64_t)1 << 59,
-    (uint64_t)1 << 60, (uint64_t)1 << 61, (uint64_t)1 << 62, (uint64_t)1 << 63
-    };
-
-    /* Precomputed test to verify if remainder of block is set (or not) */
-    static const uint64_t bitmask_remain[64] = {
-    BS_MAX, BS_MAX - (BS_MAX >> 63), BS_MAX - (BS_MAX >> 62),
-    BS_MAX - (BS_MAX >> 61), BS_MAX - (BS_MAX >> 60), BS_MAX - (BS_MAX >> 59),
-    BS_MAX - (BS_MAX >> 58), BS_MAX - (BS_MAX >> 57), BS_MAX - (BS_MAX >> 56), 
-    BS_MAX - (BS_MAX >> 55), BS_MAX - (BS_MAX >> 54), BS_MAX - (BS_MAX >> 53), 
-    BS_MAX - (BS_MAX >> 52), BS_MAX - (BS_MAX >> 51), BS_MAX - (BS_MAX >> 50), 
-    BS_MAX - (BS_MAX >> 49), BS_MAX - (BS_MAX >> 48), BS_MAX - (BS_MAX >> 47), 
-    BS_MAX - (BS_MAX >> 46), BS_MAX - (BS_MAX >> 45), BS_MAX - (BS_MAX >> 44), 
-    BS_MAX - (BS_MAX >> 43), BS_MAX - (BS_MAX >> 42), BS_MAX - (BS_MAX >> 41), 
-    BS_MAX - (BS_MAX >> 40), BS_MAX - (BS_MAX >> 39), BS_MAX - (BS_MAX >> 38), 
-    BS_MAX - (BS_MAX >> 37), BS_MAX - (BS_MAX >> 36), BS_MAX - (BS_MAX >> 35), 
-    BS_MAX - (BS_MAX >> 34), BS_MAX - (BS_MAX >> 33), BS_MAX - (BS_MAX >> 32), 
-    BS_MAX - (BS_MAX >> 31), BS_MAX - (BS_MAX >> 30), BS_MAX - (BS_MAX >> 29), 
-    BS_MAX - (BS_MAX >> 28), BS_MAX - (BS_MAX >> 27), BS_MAX - (BS_MAX >> 26), 
-    BS_MAX - (BS_MAX >> 25), BS_MAX - (BS_MAX >> 24), BS_MAX - (BS_MAX >> 23), 
-    BS_MAX - (BS_MAX >> 22), BS_MAX - (BS_MAX >> 21), BS_MAX - (BS_MAX >> 20), 
-    BS_MAX - (BS_MAX >> 19), BS_MAX - (BS_MAX >> 18), BS_MAX - (BS_MAX >> 17), 
-    BS_MAX - (BS_MAX >> 16), BS_MAX - (BS_MAX >> 15), BS_MAX - (BS_MAX >> 14), 
-    BS_MAX - (BS_MAX >> 13), BS_MAX - (BS_MAX >> 12), BS_MAX - (BS_MAX >> 11), 
-    BS_MAX - (BS_MAX >> 10), BS_MAX - (BS_MAX >> 9), BS_MAX - (BS_MAX >> 8), 
-    BS_MAX - (BS_MAX >> 7), BS_MAX - (BS_MAX >> 6), BS_MAX - (BS_MAX >> 5), 
-    BS_MAX - (BS_MAX >> 4), BS_MAX - (BS_MAX >> 3), BS_MAX - (BS_MAX >> 2),
-    BS_MAX - (BS_MAX >> 1)
-    };
-
     int32_t i, count = ecs_vector_count(bitset_columns);
     ecs_bitset_column_t *columns = ecs_vector_first(
         bitset_columns, ecs_bitset_column_t);
     int32_t bs_offset = table->bs_column_offset;
-
-    int32_t first = iter->bitset_first;
-    int32_t last = 0;
+    int32_t elem_count = 0;
 
     for (i = 0; i < count; i ++) {
         ecs_bitset_column_t *column = &columns[i];
-        ecs_bs_column_t *bs_column = columns[i].bs_column;
+        ecs_bs_column_t *bs_column = column->bs_column;
 
         if (!bs_column) {
             ecs_data_t *data = table->data;
             int32_t index = column->column_index;
             ecs_assert((index - bs_offset >= 0), ECS_INTERNAL_ERROR, NULL);
             bs_column = &data->bs_columns[index - bs_offset];
-            columns[i].bs_column = bs_column;
-        }
-        
-        ecs_bitset_t *bs = &bs_column->data;
-        int32_t bs_elem_count = bs->count;
-        int32_t bs_block = first >> 6;
-        int32_t bs_block_count = ((bs_elem_count - 1) >> 6) + 1;
-
-        if (bs_block >= bs_block_count) {
-            goto done;
+            column->bs_column = bs_column;
         }
 
-        uint64_t *data = bs->data;
-        int32_t bs_start = first & 0x3F;
-
-        /* Step 1: find the first non-empty block */
-        uint64_t v = data[bs_block];
-        uint64_t remain = bitmask_remain[bs_start];
-        while (!(v & remain)) {
-            /* If no elements are remaining, move to next block */
-            if ((++bs_block) >= bs_block_count) {
-                /* No non-empty blocks left */
-                goto done;
-            }
-
-            bs_start = 0;
-            remain = BS_MAX; /* Test the full block */
-            v = data[bs_block];
+        int32_t bs_elem_count = bs_column->data.count;
+        if (!i || bs_elem_count < elem_count) {
+            elem_count = bs_elem_count;
         }
+    }
 
-        /* Step 2: find the first non-empty element in the block */
-        while (!(v & bitmask[bs_start])) {
-            bs_start ++;
-
-            /* Block was not empty, so bs_start must be smaller than 64 */
-            ecs_assert(bs_start < 64, ECS_INTERNAL_ERROR, NULL);
-        }
-        
-        /* Step 3: Find number of contiguous enabled elements after start */
-        int32_t bs_end = bs_start, bs_block_end = bs_block;
-        
-        remain = bitmask_remain[bs_end];
-        while ((v & remain) == remain) {
-            bs_end = 0;
-            bs_block_end ++;
+    int32_t first = iter->bitset_first;
+    if (first >= elem_count) {
+        goto done;
+    }
 
-            if (bs_block_end == bs_block_count) {
-                break;
-            }
+    int32_t block_count = ((elem_count - 1) >> 6) + 1;
+    int32_t block = first >> 6;
 
-            v = data[bs_block_end];
-            remain = BS_MAX; /* Test the full block */
+    /* Step 1: find the first enabled element, starting from first */
+    uint64_t v = bitset_block(columns, count, block) & (BS_MAX << (first & 63));
+    if (!v) {
+        block = bitset_skip(columns, count, block + 1, block_count, 0);
+        if (block == block_count) {
+            goto done;
         }
 
-        /* Step 4: find remainder of enabled elements in current block */
-        if (bs_block_end != bs_block_count) {
-            while ((v & bitmask[bs_end])) {
-                bs_end ++;
-            }
-        }
+        v = bitset_block(columns, count, block);
+    }
 
-        /* Block was not 100% occupied, so bs_start must be smaller than 64 */
-        ecs_assert(bs_end < 64, ECS_INTERNAL_ERROR, NULL);
+    first = block * 64 + bitset_first_set(v);
+    if (first >= elem_count) {
+        goto done;
+    }
 
-        /* Step 5: translate to element start/end and make sure that each column
-         * range is a subset of the previous one. */
-        first = bs_block * 64 + bs_start;
-        int32_t cur_last = bs_block_end * 64 + bs_end;
-        
-        /* No enabled elements found in table */
-        if (first == cur_last) {
-            goto done;
+    /* Step 2: find the first disabled element after first */
+    int32_t last;
+    uint64_t disabled = ~v & (BS_MAX << (first & 63));
+    if (!disabled) {
+        block = bitset_skip(columns, count, block + 1, block_count, BS_MAX);
+        if (block == block_count) {
+            last = elem_count;
+        } else {
+            disabled = ~bitset_block(columns, count, block);
+            last = block * 64 + bitset_first_set(disabled);
         }
+    } else {
+        last = block * 64 + bitset_first_set(disabled);
+    }
 
-        /* If multiple bitsets are evaluated, make sure each subsequent range
-         * is equal or a subset of the previous range */
-        if (i) {
-            /* If the first element of a subsequent bitset is larger than the
-             * previous last value, start over. */
-            if (first >= last) {
-                i = -1;
-                continue;
-            }
+    /* Bits after the last element are not guaranteed to be cleared */
+    if (last > elem_count) {
+        last = elem_count;
+    }
 
-            /* Make sure the last element of the range doesn't exceed the last
-             * element of the previous range. */
-            if (cur_last > last) {
-                cur_last = last;
-            }
-        }
-        
-        last = cur_last;
-        int32_t elem_count = last - first;
+    cur->first = first;
+    cur->count = last - first;
 
-        /* Make sure last element doesn't exceed total number of elements in 
-         * the table */
-        if (elem_count > bs_elem_count) {
-            elem_count = bs_elem_count;
-        }
-        
-        cur->first = first;
-        cur->count = elem_count;
-        iter->bitset_first = first;
-    }
-    
     /* Keep track of last processed element for iteration */ 
     iter->bitset_first = last;
 
     return 0;
 done:
+    /* Start from the first element for the next table */
+    iter->bitset_first = 0;
+
     return -1;
 }
 
@@ -383,8 +383,10 @@ const uint64_t* ecs_sparse_new_ids(
         uint64_t *dense_array = ecs_vector_first(sparse->dense, uint64_t);
 
         for (i = 0; i < to_create; i ++) {
-            uint64_t index = create_id(sparse, count + i);
-            dense_array[dense_count + i] = index;
+            uint64_t index = create_id(sparse, dense_count + i);
+            ecs_assert(dense_array[dense_count + i] == index, 
+                ECS_INTERNAL_ERROR, NULL);
+            (void)index;
         }
     }
 
@@ -552,6 +554,33 @@ void ecs_sparse_remove(
     }
 }
 
+void ecs_sparse_release_id(
+    ecs_sparse_t *sparse,
+    uint64_t index)
+{
+    ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    chunk_t *chunk = get_chunk(sparse, CHUNK(index));
+    ecs_assert(chunk != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    uint64_t gen = strip_generation(&index);
+    int32_t offset = OFFSET(index);
+    int32_t dense = chunk->sparse[offset];
+    int32_t count = sparse->count;
+    (void)gen;
+
+    ecs_assert(dense != 0 && dense < count, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert((ecs_vector_first(sparse->dense, uint64_t)[dense] & 
+        ECS_GENERATION_MASK) == gen, ECS_INVALID_PARAMETER, NULL);
+
+    if (dense != (count - 1)) {
+        swap_dense(sparse, chunk, dense, count - 1);
+    }
+
+    sparse->count --;
+    ecs_os_memset(DATA(chunk->data, sparse->size, offset), 0, sparse->size);
+}
+
 void ecs_sparse_set_generation(
     ecs_sparse_t *sparse,
     uint64_t index)
@@ -731,6 +760,15 @@ void ecs_sparse_restore(
     const ecs_sparse_t * src)
 {
     ecs_assert(dst != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    /* Reset values of alive elements, so that elements that are not alive in
+     * the source don't keep their values when they are revived. */
+    uint64_t *dense_array = ecs_vector_first(dst->dense, uint64_t);
+    int32_t i, count = dst->count;
+    for (i = 1; i < count; i ++) {
+        ecs_os_memset(try_sparse_any(dst, dense_array[i]), 0, dst->size);
+    }
+
     dst->count = 1;
     if (src) {
         sparse_copy(dst, src);
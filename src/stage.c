@@ -1,16 +1,153 @@
 #include "private_api.h"
 
+/* Operations and payload in the defer queue are aligned to 16 bytes, so that
+ * component values with any alignment can be stored inline */
+#define DEFER_ALIGN (16)
+#define DEFER_CHUNK_SIZE (64 * 1024)
+#define DEFER_CHUNK_HDR ECS_ALIGN(ECS_SIZEOF(ecs_defer_chunk_t), DEFER_ALIGN)
+#define DEFER_OP_SIZE ECS_ALIGN(ECS_SIZEOF(ecs_op_t), DEFER_ALIGN)
+
+static
+void* defer_chunk_data(
+    ecs_defer_chunk_t *chunk)
+{
+    return ECS_OFFSET(chunk, DEFER_CHUNK_HDR);
+}
+
+static
+void* defer_alloc(
+    ecs_defer_queue_t *queue,
+    ecs_size_t size)
+{
+    ecs_defer_chunk_t *chunk = queue->cur;
+
+    if (!chunk || (chunk->used + size) > chunk->size) {
+        /* Chunks after the current chunk are empty, reuse next chunk if the
+         * operation fits. Otherwise insert a new chunk. */
+        ecs_defer_chunk_t *next = chunk ? chunk->next : queue->first;
+        if (!next || next->size < size) {
+            ecs_size_t chunk_size = ECS_MAX(DEFER_CHUNK_SIZE, size);
+            ecs_defer_chunk_t *new_chunk = ecs_os_malloc(
+                DEFER_CHUNK_HDR + chunk_size);
+            ecs_assert(new_chunk != NULL, ECS_OUT_OF_MEMORY, NULL);
+            new_chunk->next = next;
+            new_chunk->size = chunk_size;
+            new_chunk->used = 0;
+
+            if (chunk) {
+                chunk->next = new_chunk;
+            } else {
+                queue->first = new_chunk;
+            }
+
+            next = new_chunk;
+        }
+
+        ecs_assert(next->used == 0, ECS_INTERNAL_ERROR, NULL);
+        queue->cur = chunk = next;
+    }
+
+    void *result = ECS_OFFSET(defer_chunk_data(chunk), chunk->used);
+    chunk->used += size;
+    return result;
+}
+
+ecs_op_t* ecs_defer_next(
+    const ecs_defer_queue_t *queue,
+    ecs_defer_chunk_t **chunk_ptr,
+    ecs_op_t *op)
+{
+    ecs_defer_chunk_t *chunk = *chunk_ptr;
+    ecs_size_t offset;
+
+    if (!op) {
+        chunk = queue->first;
+        offset = 0;
+    } else {
+        offset = (ecs_size_t)((uintptr_t)op - 
+            (uintptr_t)defer_chunk_data(chunk)) + op->stride;
+    }
+
+    /* Chunks after the current chunk are empty */
+    while (chunk && offset == chunk->used) {
+        if (chunk == queue->cur) {
+            return NULL;
+        }
+        chunk = chunk->next;
+        offset = 0;
+    }
+
+    *chunk_ptr = chunk;
+    if (!chunk) {
+        return NULL;
+    }
+
+    return ECS_OFFSET(defer_chunk_data(chunk), offset);
+}
+
+void ecs_defer_reset(
+    ecs_defer_queue_t *queue)
+{
+    ecs_defer_chunk_t *chunk;
+    for (chunk = queue->first; chunk; chunk = chunk->next) {
+        chunk->used = 0;
+    }
+
+    queue->cur = queue->first;
+    queue->count = 0;
+}
+
+void ecs_defer_fini(
+    ecs_defer_queue_t *queue)
+{
+    ecs_defer_chunk_t *chunk = queue->first;
+    while (chunk) {
+        ecs_defer_chunk_t *next = chunk->next;
+        ecs_os_free(chunk);
+        chunk = next;
+    }
+
+    *queue = (ecs_defer_queue_t){ 0 };
+}
+
+/* Add operation to the queue. The payload is stored directly after the
+ * operation and can be obtained with defer_payload. */
 static
-ecs_op_t* new_defer_op(ecs_stage_t *stage) {
-    ecs_op_t *result = ecs_vector_add(&stage->defer_queue, ecs_op_t);
+ecs_op_t* new_defer_op(
+    ecs_stage_t *stage,
+    ecs_size_t payload_size) 
+{
+    ecs_size_t stride = DEFER_OP_SIZE + ECS_ALIGN(payload_size, DEFER_ALIGN);
+    ecs_op_t *result = defer_alloc(&stage->defer_queue, stride);
     ecs_os_memset(result, 0, ECS_SIZEOF(ecs_op_t));
+    result->stride = stride;
+    stage->defer_queue.count ++;
     return result;
 }
 
+static
+void* defer_payload(
+    ecs_op_t *op)
+{
+    return ECS_OFFSET(op, DEFER_OP_SIZE);
+}
+
+static
+ecs_size_t defer_ids_size(
+    const ecs_ids_t *components)
+{
+    if (components && components->count > 1) {
+        return ECS_ALIGN(components->count * ECS_SIZEOF(ecs_entity_t), 
+            DEFER_ALIGN);
+    }
+    return 0;
+}
+
 static 
 void new_defer_component_ids(
     ecs_op_t *op, 
-    const ecs_ids_t *components)
+    const ecs_ids_t *components,
+    void *payload)
 {
     ecs_assert(components != NULL, ECS_INTERNAL_ERROR, NULL);
     
@@ -24,7 +161,7 @@ void new_defer_component_ids(
         };
     } else if (components_count) {
         ecs_size_t array_size = components_count * ECS_SIZEOF(ecs_entity_t);
-        op->components.array = ecs_os_malloc(array_size);
+        op->components.array = payload;
         ecs_os_memcpy(op->components.array, components->array, array_size);
         op->components.count = components_count;
     } else {
@@ -48,11 +185,11 @@ bool defer_add_remove(
             }
         }
 
-        ecs_op_t *op = new_defer_op(stage);
+        ecs_op_t *op = new_defer_op(stage, defer_ids_size(components));
         op->kind = op_kind;
         op->is._1.entity = entity;
 
-        new_defer_component_ids(op, components);
+        new_defer_component_ids(op, components, defer_payload(op));
 
         if (op_kind == EcsOpNew) {
             world->new_count ++;
@@ -150,7 +287,7 @@ bool ecs_defer_modified(
 {
     (void)world;
     if (stage->defer) {
-        ecs_op_t *op = new_defer_op(stage);
+        ecs_op_t *op = new_defer_op(stage, 0);
         op->kind = EcsOpModified;
         op->component = component;
         op->is._1.entity = entity;
@@ -171,7 +308,7 @@ bool ecs_defer_clone(
 {   
     (void)world;
     if (stage->defer) {
-        ecs_op_t *op = new_defer_op(stage);
+        ecs_op_t *op = new_defer_op(stage, 0);
         op->kind = EcsOpClone;
         op->component = src;
         op->is._1.entity = entity;
@@ -191,7 +328,7 @@ bool ecs_defer_delete(
 {
     (void)world;
     if (stage->defer) {
-        ecs_op_t *op = new_defer_op(stage);
+        ecs_op_t *op = new_defer_op(stage, 0);
         op->kind = EcsOpDelete;
         op->is._1.entity = entity;
         world->delete_count ++;
@@ -209,7 +346,7 @@ bool ecs_defer_clear(
 {
     (void)world;
     if (stage->defer) {
-        ecs_op_t *op = new_defer_op(stage);
+        ecs_op_t *op = new_defer_op(stage, 0);
         op->kind = EcsOpClear;
         op->is._1.entity = entity;
         world->clear_count ++;
@@ -229,7 +366,7 @@ bool ecs_defer_enable(
 {
     (void)world;
     if (stage->defer) {
-        ecs_op_t *op = new_defer_op(stage);
+        ecs_op_t *op = new_defer_op(stage, 0);
         op->kind = enable ? EcsOpEnable : EcsOpDisable;
         op->is._1.entity = entity;
         op->component = component;
@@ -249,8 +386,31 @@ bool ecs_defer_bulk_new(
     const ecs_entity_t **ids_out)
 {
     if (stage->defer) {
-        ecs_entity_t *ids = ecs_os_malloc(count * ECS_SIZEOF(ecs_entity_t));
+        int c, c_count = components_ids->count;
+        ecs_entity_t *components = components_ids->array;
+
+        /* Compute size of payload, which stores the entity ids, component ids
+         * and a copy of the component data */
+        ecs_size_t ids_size = ECS_ALIGN(
+            count * ECS_SIZEOF(ecs_entity_t), DEFER_ALIGN);
+        ecs_size_t components_size = defer_ids_size(components_ids);
+        ecs_size_t payload_size = ids_size + components_size;
+
+        if (component_data) {
+            payload_size += ECS_ALIGN(c_count * ECS_SIZEOF(void*), DEFER_ALIGN);
+            for (c = 0; c < c_count; c ++) {
+                const EcsComponent *cptr = ecs_component_from_id(
+                    world, components[c]);
+                ecs_assert(cptr != NULL, ECS_INVALID_PARAMETER, NULL);
+                payload_size += ECS_ALIGN(cptr->size * count, DEFER_ALIGN);
+            }
+        }
+
+        ecs_op_t *op = new_defer_op(stage, payload_size);
+        void *payload = defer_payload(op);
+        ecs_entity_t *ids = payload;
         void **defer_data = NULL;
+        payload = ECS_OFFSET(payload, ids_size);
 
         world->bulk_new_count ++;
 
@@ -260,19 +420,25 @@ bool ecs_defer_bulk_new(
             ids[i] = ecs_new_id(world);
         }
 
+        new_defer_component_ids(op, components_ids, payload);
+        payload = ECS_OFFSET(payload, components_size);
+
         /* Create private copy for component data */
         if (component_data) {
-            int c, c_count = components_ids->count;
-            ecs_entity_t *components = components_ids->array;
-            defer_data = ecs_os_malloc(ECS_SIZEOF(void*) * c_count);
+            defer_data = payload;
+            payload = ECS_OFFSET(payload, 
+                ECS_ALIGN(c_count * ECS_SIZEOF(void*), DEFER_ALIGN));
+
             for (c = 0; c < c_count; c ++) {
                 ecs_entity_t comp = components[c];
                 const EcsComponent *cptr = ecs_component_from_id(world, comp);
                 ecs_assert(cptr != NULL, ECS_INVALID_PARAMETER, NULL);
 
                 ecs_size_t size = cptr->size;
-                void *data = ecs_os_malloc(size * count);
+                void *data = payload;
                 defer_data[c] = data;
+                payload = ECS_OFFSET(payload, 
+                    ECS_ALIGN(size * count, DEFER_ALIGN));
 
                 const ecs_type_info_t *cinfo = NULL;
                 ecs_entity_t real_id = ecs_get_typeid(world, comp);
@@ -297,12 +463,10 @@ bool ecs_defer_bulk_new(
         }
 
         /* Store data in op */
-        ecs_op_t *op = new_defer_op(stage);
         op->kind = EcsOpBulkNew;
         op->is._n.entities = ids;
         op->is._n.bulk_data = defer_data;
         op->is._n.count = count;
-        new_defer_component_ids(op, components_ids);
         *ids_out = ids;
 
         return true;
@@ -359,12 +523,12 @@ bool ecs_defer_set(
             size = cptr->size;
         }
 
-        ecs_op_t *op = new_defer_op(stage);
+        ecs_op_t *op = new_defer_op(stage, size);
         op->kind = op_kind;
         op->component = component;
         op->is._1.entity = entity;
         op->is._1.size = size;
-        op->is._1.value = ecs_os_malloc(size);
+        op->is._1.value = defer_payload(op);
 
         if (!value) {
             value = ecs_get_id(world, entity, component);
@@ -408,6 +572,89 @@ bool ecs_defer_set(
     return false;
 }
 
+/* Reserve a block of entity ids for a worker stage, so that the stage can
+ * create entities while the world is readonly without contending with other
+ * threads on the world id counter. The block is taken from the entity index,
+ * which means that recycled ids are handed out first. */
+static
+void stage_reserve_ids(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    int32_t count = stage->id_block_size;
+
+    /* Don't reserve ids when the application limits the id range, as reserved
+     * ids could exceed the range without being used */
+    if (!count || world->stats.max_id || ecs_vector_count(stage->id_block)) {
+        return;
+    }
+
+    const ecs_entity_t *ids = ecs_sparse_new_ids(
+        world->store.entity_index, count);
+
+    /* The returned buffer is owned by the entity index, so copy the ids */
+    ecs_vector_set_count(&stage->id_block, ecs_entity_t, count);
+    ecs_os_memcpy(ecs_vector_first(stage->id_block, ecs_entity_t), ids, 
+        count * ECS_SIZEOF(ecs_entity_t));
+    stage->id_block_index = 0;
+}
+
+/* Return the ids that the stage did not use to the entity index, and size the
+ * next block after the number of ids the stage created. */
+static
+void stage_release_ids(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    ecs_entity_t *ids = ecs_vector_first(stage->id_block, ecs_entity_t);
+    int32_t i, count = ecs_vector_count(stage->id_block);
+
+    /* Release in reverse order, so that ids are recycled in the order in which
+     * they were reserved. Since stages are also released in reverse order,
+     * trailing ids can be released without moving them in the index. */
+    for (i = count - 1; i >= stage->id_block_index; i --) {
+        ecs_sparse_release_id(world->store.entity_index, ids[i]);
+    }
+
+    ecs_vector_clear(stage->id_block);
+    stage->id_block_index = 0;
+
+    int32_t size = stage->id_block_size;
+    int32_t new_count = stage->id_new_count;
+    stage->id_new_count = 0;
+
+    if (new_count > size || new_count < size / 2) {
+        /* Size the block after the number of created ids with some headroom,
+         * so the stage rarely falls back to the atomic counter */
+        size = new_count + new_count / 4;
+        size = ECS_ALIGN(size, ECS_ID_BLOCK_MIN);
+        if (size > ECS_ID_BLOCK_MAX) {
+            size = ECS_ID_BLOCK_MAX;
+        }
+    }
+
+    stage->id_block_size = size;
+}
+
+ecs_entity_t ecs_stage_new_id(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    if (!stage->asynchronous) {
+        stage->id_new_count ++;
+    }
+
+    int32_t index = stage->id_block_index;
+    if (index < ecs_vector_count(stage->id_block)) {
+        stage->id_block_index = index + 1;
+        return ecs_vector_first(stage->id_block, ecs_entity_t)[index];
+    }
+
+    /* No ids left in block. Can't atomically increase number above max int */
+    ecs_assert(world->stats.last_id < UINT_MAX, ECS_INTERNAL_ERROR, NULL);
+    return (ecs_entity_t)ecs_os_ainc((int32_t*)&world->stats.last_id);
+}
+
 void ecs_stage_merge_post_frame(
     ecs_world_t *world,
     ecs_stage_t *stage)
@@ -446,14 +693,14 @@ void ecs_stage_deinit(
     ecs_assert(stage->magic == ECS_STAGE_MAGIC, ECS_INVALID_PARAMETER, NULL);
 
     /* Make sure stage has no unmerged data */
-    ecs_assert(ecs_vector_count(stage->defer_queue) == 0, 
-        ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(stage->defer_queue.count == 0, ECS_INVALID_PARAMETER, NULL);
 
     /* Set magic to 0 so that accessing the stage after deinitializing it will
      * throw an assert. */
     stage->magic = 0;
 
-    ecs_vector_free(stage->defer_queue);
+    ecs_defer_fini(&stage->defer_queue);
+    ecs_vector_free(stage->id_block);
 }
 
 void ecs_set_stages(
@@ -554,7 +801,12 @@ bool ecs_staging_begin(
 
     int32_t i, count = ecs_get_stage_count(world);
     for (i = 0; i < count; i ++) {
-        ecs_defer_begin(ecs_get_stage(world, i));
+        ecs_world_t *stage = ecs_get_stage(world, i);
+        ecs_defer_begin(stage);
+
+        if (count > 1 && ecs_os_has_threading()) {
+            stage_reserve_ids(world, (ecs_stage_t*)stage);
+        }
     }
 
     bool is_readonly = world->is_readonly;
@@ -576,6 +828,13 @@ void ecs_staging_end(
     /* After this it is safe again to mutate the world directly */
     world->is_readonly = false;
 
+    /* Return unused ids before merging, so that entities created by the merge
+     * can recycle them */
+    int32_t i, count = ecs_get_stage_count(world);
+    for (i = count - 1; i >= 0; i --) {
+        stage_release_ids(world, (ecs_stage_t*)ecs_get_stage(world, i));
+    }
+
     do_auto_merge(world);
 }
 
@@ -601,6 +601,16 @@ void dtor_all_components(
     }
 }
 
+static
+void mark_table_dirty(
+    ecs_table_t *table,
+    int32_t index)
+{
+    if (table->dirty_state) {
+        table->dirty_state[index] ++;
+    }
+}
+
 void ecs_table_clear_data(
     ecs_world_t *world,
     ecs_table_t *table,
@@ -613,6 +623,13 @@ void ecs_table_clear_data(
     }
 
     int32_t count = ecs_table_data_count(data);
+
+    /* Data that is not owned by the table (like snapshot data) is not indexed */
+    if (data == table->data) {
+        ecs_name_index_move(world, NULL, table, data, 0, count);
+        mark_table_dirty(table, 0);
+    }
+
     dtor_all_components(world, table, data, 0, count);
     
     ecs_column_t *columns = data->columns;
@@ -666,6 +683,8 @@ void ecs_table_clear_silent(
         return;
     }
 
+    ecs_monitor_invalidate_bases(world);
+
     int32_t count = ecs_vector_count(data->entities);
     
     ecs_table_clear_data(world, table, data);
@@ -751,8 +770,10 @@ void ecs_table_free(
 
     ecs_unregister_table(world, table);
 
-    ecs_os_free(table->lo_edges);
+    ecs_os_free(table->lo_edges.elems);
     ecs_map_free(table->hi_edges);
+    ecs_os_free(table->lo_column_map);
+    ecs_map_free(table->base_cache);
     ecs_vector_free(table->queries);
     ecs_vector_free((ecs_vector_t*)table->type);
     ecs_os_free(table->dirty_state);
@@ -786,22 +807,12 @@ void ecs_table_reset(
     ecs_assert(!table->lock, ECS_LOCKED_STORAGE, NULL);
     
     (void)world;
-    ecs_os_free(table->lo_edges);
+    ecs_os_free(table->lo_edges.elems);
     ecs_map_free(table->hi_edges);
-    table->lo_edges = NULL;
+    table->lo_edges = (ecs_edge_cache_t){0};
     table->hi_edges = NULL;
 }
 
-static
-void mark_table_dirty(
-    ecs_table_t *table,
-    int32_t index)
-{
-    if (table->dirty_state) {
-        table->dirty_state[index] ++;
-    }
-}
-
 void ecs_table_mark_dirty(
     ecs_table_t *table,
     ecs_entity_t component)
@@ -812,7 +823,7 @@ void ecs_table_mark_dirty(
     if (table->dirty_state) {
         int32_t index = ecs_type_index_of(table->type, component);
         ecs_assert(index != -1, ECS_INTERNAL_ERROR, NULL);
-        table->dirty_state[index] ++;
+        table->dirty_state[index + 1] ++;
     }
 }
 
@@ -991,12 +1002,12 @@ void grow_column(
     ecs_assert(new_size >= new_count, ECS_INTERNAL_ERROR, NULL);
 
     /* If the array could possibly realloc and the component has a move action 
-     * defined, move old elements manually */
-    ecs_move_t move;
-    if (c_info && count && can_realloc && (move = c_info->lifecycle.move)) {
-        ecs_xtor_t ctor = c_info->lifecycle.ctor;
-        ecs_assert(ctor != NULL, ECS_INTERNAL_ERROR, NULL);
-
+     * defined, move old elements manually. Elements are relocated with the
+     * merge action (move ctor + dtor), which does a single pass over the old
+     * elements instead of constructing, move assigning and leaving behind the
+     * moved-from elements. Only the added elements are constructed. */
+    ecs_move_ctor_t merge;
+    if (c_info && count && can_realloc && (merge = c_info->lifecycle.merge)) {
         /* Create new vector */
         ecs_vector_t *new_vec = ecs_vector_new_t(size, alignment, new_size);
         ecs_vector_set_count_t(&new_vec, size, alignment, new_count);
@@ -1007,22 +1018,27 @@ void grow_column(
         void *new_buffer = ecs_vector_first_t(
             new_vec, size, alignment);
 
-        /* First construct elements (old and new) in new buffer */
-        ctor(world, c_info->component, entities, new_buffer, 
-            ecs_to_size_t(size), construct ? new_count : count, 
-            c_info->lifecycle.ctx);
-        
-        /* Move old elements */
-        move(world, c_info->component, entities, entities, 
-            new_buffer, old_buffer, ecs_to_size_t(size), count, 
+        /* Move old elements into uninitialized storage of new buffer */
+        merge(world, c_info->component, &c_info->lifecycle, entities, 
+            entities, new_buffer, old_buffer, ecs_to_size_t(size), count, 
             c_info->lifecycle.ctx);
 
+        /* Construct new elements */
+        ecs_xtor_t ctor;
+        if (construct && to_add && (ctor = c_info->lifecycle.ctor)) {
+            void *elem = ECS_OFFSET(new_buffer, size * count);
+            ctor(world, c_info->component, &entities[count], elem, 
+                ecs_to_size_t(size), to_add, c_info->lifecycle.ctx);
+        }
+
         /* Free old vector */
         ecs_vector_free(vec);
         column->data = new_vec;
     } else {
         /* If array won't realloc or has no move, simply add new elements */
-        if (can_realloc) {
+        if (new_size < old_size) {
+            ecs_vector_reclaim_t(&vec, size, alignment);
+        } else if (can_realloc) {
             ecs_vector_set_size_t(&vec, size, alignment, new_size);
         }
 
@@ -1313,6 +1329,12 @@ void ecs_table_delete(
     int32_t column_count = table->column_count;
     int32_t i;
 
+    /* If the entity is not destructed it was moved to another table, in which
+     * case the name index has already been updated. */
+    if (destruct) {
+        ecs_name_index_move(world, NULL, table, data, index, 1);
+    }
+
     ecs_entity_t *entities = ecs_vector_first(entity_column, ecs_entity_t);
     ecs_entity_t entity_to_move = entities[count];
 
@@ -1502,6 +1524,10 @@ void ecs_table_move(
         new_table, new_data, new_index, old_table, old_data, old_index, 1);
 
     bool same_entity = dst_entity == src_entity;
+    if (same_entity) {
+        ecs_name_index_move(
+            world, new_table, old_table, old_data, old_index, 1);
+    }
 
     ecs_type_t new_type = new_table->type;
     ecs_type_t old_type = old_table->type;
@@ -1582,6 +1608,11 @@ void ecs_table_move(
         dtor_component(world, old_table->c_info[i_old],
             &old_columns[i_old], &src_entity, old_index, 1);
     }
+
+    /* If the entity is a copy of another entity, add its name to the index */
+    if (!same_entity) {
+        ecs_name_index_table(world, new_table, new_data, new_index, 1);
+    }
 }
 
 int32_t ecs_table_appendn(
@@ -1623,6 +1654,52 @@ void ecs_table_set_size(
     }
 }
 
+bool ecs_table_shrink(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_assert(!table->lock, ECS_LOCKED_STORAGE, NULL);
+
+    ecs_data_t *data = table->data;
+    if (!data) {
+        return false;
+    }
+
+    /* Only shrink when the count dropped well below the allocated size, so
+     * that a table that fluctuates in size doesn't keep reallocating */
+    int32_t count = ecs_vector_count(data->entities);
+    int32_t size = ecs_vector_size(data->entities);
+    if (count * 4 >= size) {
+        return false;
+    }
+
+    ecs_vector_reclaim(&data->entities, ecs_entity_t);
+    ecs_vector_reclaim(&data->record_ptrs, ecs_record_t*);
+
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    ecs_type_info_t **c_info_array = table->c_info;
+    ecs_column_t *columns = data->columns;
+    int32_t i, column_count = table->column_count;
+
+    for (i = 0; i < column_count; i ++) {
+        ecs_column_t *column = &columns[i];
+        if (!column->size || ecs_vector_size(column->data) == count) {
+            continue;
+        }
+
+        ecs_type_info_t *c_info = c_info_array ? c_info_array[i] : NULL;
+
+        /* Growing with 0 elements to a smaller size relocates elements the
+         * same way as a regular realloc, using the move actions if set */
+        grow_column(world, entities, column, c_info, 0, count, false);
+    }
+
+    /* Invalidate cached pointers to table columns */
+    table->alloc_count ++;
+
+    return true;
+}
+
 int32_t ecs_table_data_count(
     const ecs_data_t *data)
 {
@@ -1742,6 +1819,96 @@ void ecs_table_swap(
     }  
 }
 
+void ecs_table_move_row(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    int32_t row_from,
+    int32_t row_to)
+{
+    (void)world;
+
+    ecs_assert(!table->lock, ECS_LOCKED_STORAGE, NULL);
+    ecs_assert(data != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(row_from >= 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(row_to >= 0, ECS_INTERNAL_ERROR, NULL);
+
+    if (row_from == row_to) {
+        return;
+    }
+
+    mark_table_dirty(table, 0);
+
+    /* Rows in between from and to shift one row towards from */
+    int32_t lo, hi, dst, src, shift;
+    if (row_from < row_to) {
+        lo = row_from; hi = row_to; src = lo + 1; dst = lo; shift = -1;
+    } else {
+        lo = row_to; hi = row_from; src = lo; dst = lo + 1; shift = 1;
+    }
+
+    int32_t i, count = hi - lo;
+
+    /* Switch and bitset columns don't store rows contiguously, so rotate them
+     * with swaps */
+    if (table->sw_column_count || table->bs_column_count) {
+        if (shift < 0) {
+            for (i = lo; i < hi; i ++) {
+                swap_switch_columns(table, data, i, i + 1);
+                swap_bitset_columns(table, data, i, i + 1);
+            }
+        } else {
+            for (i = hi; i > lo; i --) {
+                swap_switch_columns(table, data, i - 1, i);
+                swap_bitset_columns(table, data, i - 1, i);
+            }
+        }
+    }
+
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    ecs_record_t **record_ptrs = ecs_vector_first(
+        data->record_ptrs, ecs_record_t*);
+
+    ecs_entity_t e = entities[row_from];
+    ecs_record_t *record_ptr = record_ptrs[row_from];
+    ecs_assert(record_ptr != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_os_memmove(&entities[dst], &entities[src], 
+        count * ECS_SIZEOF(ecs_entity_t));
+    ecs_os_memmove(&record_ptrs[dst], &record_ptrs[src], 
+        count * ECS_SIZEOF(ecs_record_t*));
+    entities[row_to] = e;
+    record_ptrs[row_to] = record_ptr;
+
+    /* Update the rows of all moved records, keeping the watched state */
+    for (i = lo; i <= hi; i ++) {
+        ecs_record_t *r = record_ptrs[i];
+        ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+        r->row = ecs_row_to_record(i, r->row < 0);
+    }
+
+    ecs_column_t *columns = data->columns;
+    if (!columns) {
+        return;
+    }
+
+    int32_t column_count = table->column_count;
+    for (i = 0; i < column_count; i ++) {
+        int16_t size = columns[i].size;
+        int16_t alignment = columns[i].alignment;
+
+        if (size) {
+            void *ptr = ecs_vector_first_t(columns[i].data, size, alignment);
+            void *tmp = ecs_os_alloca(size);
+
+            ecs_os_memcpy(tmp, ECS_OFFSET(ptr, size * row_from), size);
+            ecs_os_memmove(ECS_OFFSET(ptr, size * dst), 
+                ECS_OFFSET(ptr, size * src), size * count);
+            ecs_os_memcpy(ECS_OFFSET(ptr, size * row_to), tmp, size);
+        }
+    }
+}
+
 static
 void merge_vector(
     ecs_vector_t **dst_out,
@@ -1997,6 +2164,9 @@ ecs_data_t* ecs_table_merge(
 {
     ecs_assert(old_table != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(!old_table->lock, ECS_LOCKED_STORAGE, NULL);
+
+    /* Entities are moved without evaluating monitors */
+    ecs_monitor_invalidate_bases(world);
     
     bool move_data = false;
     
@@ -2044,6 +2214,12 @@ ecs_data_t* ecs_table_merge(
         record->table = new_table;
     }
 
+    /* Remove names from the index for the parents of the old table. If the
+     * data is not owned by the table, the names weren't indexed. */
+    if (old_data == old_table->data) {
+        ecs_name_index_move(world, NULL, old_table, old_data, 0, old_count);
+    }
+
     /* Merge table columns */
     if (move_data) {
         *new_data = *old_data;
@@ -2052,6 +2228,8 @@ ecs_data_t* ecs_table_merge(
             old_data, new_data);
     }
 
+    ecs_name_index_table(world, new_table, new_data, new_count, old_count);
+
     new_table->alloc_count ++;
 
     if (!new_count && old_count) {
@@ -2071,6 +2249,8 @@ void ecs_table_replace_data(
     ecs_assert(!data || data != table_data, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(!table->lock, ECS_LOCKED_STORAGE, NULL);
 
+    ecs_monitor_invalidate_bases(world);
+
     if (table_data) {
         prev_count = ecs_vector_count(table_data->entities);
         run_remove_actions(world, table, table_data);
@@ -2084,6 +2264,11 @@ void ecs_table_replace_data(
         return;
     }
 
+    ecs_name_index_table(world, table, table_data, 0, 
+        ecs_table_data_count(table_data));
+
+    mark_table_dirty(table, 0);
+
     int32_t count = ecs_table_count(table);
 
     if (!prev_count && count) {
@@ -188,16 +188,97 @@ ecs_type_t entities_to_type(
     }
 }
 
+#define ECS_EDGE_CACHE_INIT_SIZE (8)
+
+static
+ecs_edge_elem_t* edge_cache_find(
+    ecs_edge_elem_t *elems,
+    int32_t size,
+    ecs_id_t id)
+{
+    int32_t mask = size - 1;
+    int32_t i = (int32_t)id & mask;
+
+    /* The cache is never full, so this always finds the id or an empty slot */
+    while (elems[i].id && elems[i].id != id) {
+        i = (i + 1) & mask;
+    }
+
+    return &elems[i];
+}
+
+static
+void edge_cache_grow(
+    ecs_edge_cache_t *cache)
+{
+    int32_t i, size = cache->size;
+    int32_t new_size = size ? size * 2 : ECS_EDGE_CACHE_INIT_SIZE;
+    ecs_edge_elem_t *elems = cache->elems;
+    ecs_edge_elem_t *new_elems = ecs_os_calloc(
+        ECS_SIZEOF(ecs_edge_elem_t) * new_size);
+
+    for (i = 0; i < size; i ++) {
+        ecs_edge_elem_t *elem = &elems[i];
+        if (elem->id) {
+            *edge_cache_find(new_elems, new_size, elem->id) = *elem;
+        }
+    }
+
+    ecs_os_free(elems);
+    cache->elems = new_elems;
+    cache->size = new_size;
+}
+
+static
+ecs_edge_t* edge_cache_get(
+    ecs_edge_cache_t *cache,
+    ecs_id_t id)
+{
+    if (!cache->size) {
+        return NULL;
+    }
+
+    ecs_edge_elem_t *elem = edge_cache_find(cache->elems, cache->size, id);
+    if (!elem->id) {
+        return NULL;
+    }
+
+    return &elem->edge;
+}
+
+static
+ecs_edge_t* edge_cache_ensure(
+    ecs_edge_cache_t *cache,
+    ecs_id_t id)
+{
+    ecs_edge_elem_t *elem;
+
+    if (cache->size) {
+        elem = edge_cache_find(cache->elems, cache->size, id);
+        if (elem->id) {
+            return &elem->edge;
+        }
+    }
+
+    /* Keep load factor below 3/4 so probe sequences stay short */
+    if ((cache->count + 1) * 4 > cache->size * 3) {
+        edge_cache_grow(cache);
+    }
+
+    elem = edge_cache_find(cache->elems, cache->size, id);
+    elem->id = id;
+    cache->count ++;
+
+    return &elem->edge;
+}
+
 static
 ecs_edge_t* get_edge(
     ecs_table_t *node,
     ecs_entity_t e)
 {
     if (e < ECS_HI_COMPONENT_ID) {
-        if (!node->lo_edges) {
-            node->lo_edges = ecs_os_calloc(sizeof(ecs_edge_t) * ECS_HI_COMPONENT_ID);
-        }
-        return &node->lo_edges[e];
+        return edge_cache_ensure(&node->lo_edges, e);
     } else {
         if (!node->hi_edges) {
             node->hi_edges = ecs_map_new(ecs_edge_t, 1);
@@ -214,7 +295,7 @@ void init_edges(
     ecs_entity_t *entities = ecs_vector_first(table->type, ecs_entity_t);
     int32_t count = ecs_vector_count(table->type);
 
-    table->lo_edges = NULL;
+    table->lo_edges = (ecs_edge_cache_t){0};
     table->hi_edges = NULL;
     
     /* Make add edges to own components point to self */
@@ -252,6 +333,10 @@ void init_edges(
             table->flags |= EcsTableIsDisabled;
         }
 
+        if (e == ecs_id(EcsName)) {
+            table->flags |= EcsTableHasName;
+        }
+
         if (e == ecs_id(EcsComponent)) {
             table->flags |= EcsTableHasComponentData;
         }
@@ -299,6 +384,41 @@ void init_edges(
     });
 }
 
+/* Map low ids to their index in the table type, so that a component can be
+ * looked up in a table without going through the id index. Low ids sort
+ * before roles and pairs, so only the start of the type has to be scanned. */
+static
+void init_column_map(
+    ecs_table_t * table)
+{
+    ecs_id_t *ids = ecs_vector_first(table->type, ecs_id_t);
+    int32_t i, count = ecs_vector_count(table->type);
+
+    for (i = 0; i < count; i ++) {
+        if (ids[i] >= ECS_HI_COMPONENT_ID) {
+            break;
+        }
+    }
+
+    table->lo_column_map = NULL;
+    table->lo_column_count = 0;
+
+    if (!i) {
+        return;
+    }
+
+    ecs_assert(i < INT16_MAX, ECS_INTERNAL_ERROR, NULL);
+
+    int32_t map_count = (int32_t)ids[i - 1] + 1;
+    table->lo_column_map = ecs_os_calloc(ECS_SIZEOF(int16_t) * map_count);
+    table->lo_column_count = map_count;
+
+    int32_t c;
+    for (c = 0; c < i; c ++) {
+        table->lo_column_map[ids[c]] = (int16_t)(c + 1);
+    }
+}
+
 static
 void init_table(
     ecs_world_t * world,
@@ -317,6 +437,7 @@ void init_table(
     table->un_set_all = NULL;
     table->alloc_count = 0;
     table->lock = 0;
+    table->base_cache = NULL;
 
     /* Ensure the component ids for the table exist */
     ensure_columns(world, table);
@@ -326,6 +447,7 @@ void init_table(
     table->sw_column_count = switch_column_count(table);
     table->bs_column_count = bitset_column_count(table);
 
+    init_column_map(table);
     init_edges(world, table);
 }
 
@@ -631,6 +753,9 @@ ecs_table_t* ecs_table_traverse_remove(
                     return NULL;
                 }
 
+                /* Creating a table can add edges to node, which can move
+                 * the edge in memory. */
+                edge = get_edge(node, e);
                 edge->remove = next;
             } else {
                 /* If the add edge does not point to self, the table
@@ -718,6 +843,10 @@ ecs_table_t* ecs_table_traverse_add(
         if (!next) {
             next = find_or_create_table_include(world, node, e);
             ecs_assert(next != NULL, ECS_INTERNAL_ERROR, NULL);
+
+            /* Creating a table can add edges to node, which can move the
+             * edge in memory. */
+            edge = get_edge(node, e);
             edge->add = next;
         }
 
@@ -947,17 +1076,26 @@ void ecs_table_clear_edges(
     ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
     ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INTERNAL_ERROR, NULL);   
 
-    uint32_t i;
+    int32_t i, size = table->lo_edges.size;
+    ecs_edge_elem_t *elems = table->lo_edges.elems;
+
+    for (i = 0; i < size; i ++) {
+        ecs_id_t id = elems[i].id;
+        if (!id) {
+            continue;
+        }
 
-    if (table->lo_edges) {
-        for (i = 0; i < ECS_HI_COMPONENT_ID; i ++) {
-            ecs_edge_t *e = &table->lo_edges[i];
-            ecs_table_t *add = e->add, *remove = e->remove;
-            if (add) {
-                add->lo_edges[i].remove = NULL;
+        ecs_table_t *add = elems[i].edge.add, *remove = elems[i].edge.remove;
+        if (add) {
+            ecs_edge_t *e = edge_cache_get(&add->lo_edges, id);
+            if (e) {
+                e->remove = NULL;
             }
-            if (remove) {
-                remove->lo_edges[i].add = NULL;
+        }
+        if (remove) {
+            ecs_edge_t *e = edge_cache_get(&remove->lo_edges, id);
+            if (e) {
+                e->add = NULL;
             }
         }
     }
@@ -984,6 +1122,55 @@ void ecs_table_clear_edges(
     }
 }
 
+static
+void clear_edge_to_deleted(
+    ecs_edge_t *edge)
+{
+    if (edge->add && edge->add->flags & EcsTableMarkedForDelete) {
+        edge->add = NULL;
+    }
+    if (edge->remove && edge->remove->flags & EcsTableMarkedForDelete) {
+        edge->remove = NULL;
+    }
+}
+
+void ecs_table_clear_edges_to_deleted(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    (void)world;
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INTERNAL_ERROR, NULL);
+
+    /* Edges are not guaranteed to have a backlink (for example when a table
+     * is reached through an XOR replace), so ecs_table_clear_edges can't find
+     * all edges to a deleted table. This visits the edges of a table and
+     * clears the ones that point to a table that is about to be deleted. */
+    int32_t i, size = table->lo_edges.size;
+    ecs_edge_elem_t *elems = table->lo_edges.elems;
+    for (i = 0; i < size; i ++) {
+        if (elems[i].id) {
+            clear_edge_to_deleted(&elems[i].edge);
+        }
+    }
+
+    ecs_map_iter_t it = ecs_map_iter(table->hi_edges);
+    ecs_edge_t *edge;
+    while ((edge = ecs_map_next(&it, ecs_edge_t, NULL))) {
+        clear_edge_to_deleted(edge);
+    }
+}
+
+int32_t ecs_table_edges_memory(
+    ecs_table_t *table)
+{
+    int32_t result = table->lo_edges.size * ECS_SIZEOF(ecs_edge_elem_t);
+    if (table->hi_edges) {
+        ecs_map_memory(table->hi_edges, &result, NULL);
+    }
+    return result;
+}
+
 /* Public convenience functions for traversing table graph */
 ecs_table_t* ecs_table_add_id(
     ecs_world_t *world,
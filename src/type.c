@@ -165,6 +165,7 @@ ecs_type_t ecs_type_merge(
     if (!table) {
         return NULL;
     } else {
+        table->flags |= EcsTableIsPinned;
         return table->type;
     }
 }
@@ -189,6 +190,9 @@ ecs_type_t ecs_type_find(
     ecs_table_t *table = ecs_table_find_or_create(unsafe_world, &entities);
     ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
 
+    /* Prevent table from being deleted while its type is in use */
+    table->flags |= EcsTableIsPinned;
+
     return table->type;
 }
 
@@ -417,6 +421,7 @@ ecs_type_t ecs_type_add(
     table = ecs_table_traverse_add(unsafe_world, table, &entities, NULL);
 
     ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+    table->flags |= EcsTableIsPinned;
 
     return table->type;
 }
@@ -442,6 +447,7 @@ ecs_type_t ecs_type_remove(
 
     table = ecs_table_traverse_remove(unsafe_world, table, &entities, NULL);
     ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+    table->flags |= EcsTableIsPinned;
 
     return table->type;    
 }
@@ -1,14 +1,82 @@
 #include "private_api.h"
 
+/* Vectors with an offset larger than the header store elements that have an
+ * alignment larger than the header, which can be larger than the alignment
+ * guaranteed by the OS allocator. These vectors overallocate, so that the 
+ * header can be placed at an address where the elements are aligned. */
+#define IS_ALIGNED(offset) ((offset) > ECS_SIZEOF(ecs_vector_t))
+
+/* The element buffer is padded to a multiple of the offset, so that elements
+ * can be processed in blocks of the alignment size. For vectors that aren't
+ * aligned this is typically free, as allocators round up to a multiple of the
+ * header size. */
+static
+ecs_size_t pad_size(
+    int16_t offset,
+    ecs_size_t size)
+{
+    if (size) {
+        return ECS_ALIGN(size, offset);
+    } else {
+        return 0;
+    }
+}
+
+/** Allocate a vector buffer */
+static
+ecs_vector_t* alloc_vector(
+    int16_t offset,
+    ecs_size_t size)
+{
+    size = pad_size(offset, size);
+
+    if (!IS_ALIGNED(offset)) {
+        ecs_vector_t *result = ecs_os_malloc(offset + size);
+        ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+        result->alloc_offset = 0;
+        return result;
+    }
+
+    /* If the vector is aligned, the offset is equal to the alignment */
+    ecs_assert(!(offset & (offset - 1)), ECS_INVALID_PARAMETER, NULL);
+
+    void *ptr = ecs_os_malloc(offset + size + offset);
+    ecs_assert(ptr != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    uintptr_t elems = ((uintptr_t)ptr + (uintptr_t)(offset + offset - 1)) & 
+        ~(uintptr_t)(offset - 1);
+    ecs_vector_t *result = (ecs_vector_t*)(elems - (uintptr_t)offset);
+    result->alloc_offset = (int32_t)((uintptr_t)result - (uintptr_t)ptr);
+    return result;
+}
+
 /** Resize the vector buffer */
 static
 ecs_vector_t* resize(
     ecs_vector_t *vector,
+    ecs_size_t elem_size,
     int16_t offset,
-    int32_t size)
+    int32_t elem_count)
 {
-    ecs_vector_t *result = ecs_os_realloc(vector, offset + size);
-    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, 0);
+    if (!IS_ALIGNED(offset)) {
+        ecs_vector_t *result = ecs_os_realloc(
+            vector, offset + pad_size(offset, elem_size * elem_count));
+        ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, 0);
+        return result;
+    }
+
+    /* Realloc does not preserve alignment, so copy to a new buffer */
+    ecs_vector_t *result = alloc_vector(offset, elem_size * elem_count);
+    int32_t alloc_offset = result->alloc_offset;
+    int32_t count = vector->count;
+    if (count > elem_count) {
+        count = elem_count;
+    }
+
+    ecs_os_memcpy(result, vector, offset + elem_size * count);
+    result->alloc_offset = alloc_offset;
+    ecs_vector_free(vector);
+
     return result;
 }
 
@@ -21,10 +89,7 @@ ecs_vector_t* _ecs_vector_new(
 {
     ecs_assert(elem_size != 0, ECS_INTERNAL_ERROR, NULL);
     
-    ecs_vector_t *result =
-        ecs_os_malloc(offset + elem_size * elem_count);
-    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
-
+    ecs_vector_t *result = alloc_vector(offset, elem_size * elem_count);
     result->count = 0;
     result->size = elem_count;
 #ifndef NDEBUG
@@ -41,10 +106,7 @@ ecs_vector_t* _ecs_vector_from_array(
 {
     ecs_assert(elem_size != 0, ECS_INTERNAL_ERROR, NULL);
     
-    ecs_vector_t *result =
-        ecs_os_malloc(offset + elem_size * elem_count);
-    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
-
+    ecs_vector_t *result = alloc_vector(offset, elem_size * elem_count);
     ecs_os_memcpy(ECS_OFFSET(result, offset), array, elem_size * elem_count);
 
     result->count = elem_count;
@@ -58,7 +120,9 @@ ecs_vector_t* _ecs_vector_from_array(
 void ecs_vector_free(
     ecs_vector_t *vector)
 {
-    ecs_os_free(vector);
+    if (vector) {
+        ecs_os_free(ECS_OFFSET(vector, -vector->alloc_offset));
+    }
 }
 
 void ecs_vector_clear(
@@ -122,7 +186,7 @@ void* _ecs_vector_addn(
             }
         }
 
-        vector = resize(vector, offset, max_count * elem_size);
+        vector = resize(vector, elem_size, offset, max_count);
         vector->size = max_count;
         *array_inout = vector;
     }
@@ -150,7 +214,7 @@ void* _ecs_vector_add(
             if (!size) {
                 size = 2;
             }
-            vector = resize(vector, offset, size * elem_size);
+            vector = resize(vector, elem_size, offset, size);
             *array_inout = vector;
             vector->size = size;
         }
@@ -256,7 +320,7 @@ void _ecs_vector_reclaim(
 
     if (count < size) {
         size = count;
-        vector = resize(vector, offset, size * elem_size);
+        vector = resize(vector, elem_size, offset, size);
         vector->size = size;
         *array_inout = vector;
     }
@@ -302,7 +366,7 @@ int32_t _ecs_vector_set_size(
 
         if (result < elem_count) {
             elem_count = ecs_next_pow_of_2(elem_count);
-            vector = resize(vector, offset, elem_count * elem_size);
+            vector = resize(vector, elem_size, offset, elem_count);
             vector->size = elem_count;
             *array_inout = vector;
             result = elem_count;
@@ -474,6 +538,8 @@ ecs_vector_t* _ecs_vector_copy(
     }
 
     ecs_vector_t *dst = _ecs_vector_new(elem_size, offset, src->size);
-    ecs_os_memcpy(dst, src, offset + elem_size * src->count);
+    ecs_os_memcpy(ECS_OFFSET(dst, offset), ECS_OFFSET(src, offset), 
+        elem_size * src->count);
+    dst->count = src->count;
     return dst;
 }
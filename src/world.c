@@ -215,12 +215,21 @@ void ecs_monitor_register(
     *q = query;
 }
 
+void ecs_monitor_invalidate_bases(
+    ecs_world_t *world)
+{
+    world->monitors.generation ++;
+}
+
 static
 void monitors_init(
     ecs_relation_monitor_t *rm)
 {
     rm->monitor_sets = ecs_map_new(ecs_monitor_t, 0);
     rm->is_dirty = false;
+
+    /* Start at 1, so that new base cache elements are not valid */
+    rm->generation = 1;
 }
 
 static
@@ -319,15 +328,19 @@ ecs_world_t *ecs_mini(void) {
 
     world->type_info = ecs_sparse_new(ecs_type_info_t);
     world->id_index = ecs_map_new(ecs_id_record_t, 8);
+    world->id_index_lo = ecs_os_calloc(
+        ECS_SIZEOF(ecs_id_record_t*) * ECS_HI_COMPONENT_ID);
     world->id_triggers = ecs_map_new(ecs_id_trigger_t, 8);
 
     world->aliases = NULL;
 
     world->queries = ecs_sparse_new(ecs_query_t);
+    world->unindexed_queries = NULL;
     world->triggers = ecs_sparse_new(ecs_trigger_t);
     world->observers = ecs_sparse_new(ecs_observer_t);
     world->fini_tasks = ecs_vector_new(ecs_entity_t, 0);
     world->name_prefix = NULL;
+    world->symbol_index = NULL;
 
     monitors_init(&world->monitors);
 
@@ -336,7 +349,6 @@ ecs_world_t *ecs_mini(void) {
     world->on_enable_components = ecs_map_new(ecs_on_demand_in_t, 0);
 
     world->worker_stages = NULL;
-    world->workers_waiting = 0;
     world->workers_running = 0;
     world->quit_workers = false;
     world->is_readonly = false;
@@ -728,6 +740,7 @@ void fini_queries(
         ecs_query_fini(query);
     }
     ecs_sparse_free(world->queries);
+    ecs_vector_free(world->unindexed_queries);
 }
 
 static
@@ -755,9 +768,24 @@ void fini_id_index(
     ecs_id_record_t *r;
     while ((r = ecs_map_next(&it, ecs_id_record_t, NULL))) {
         ecs_map_free(r->table_index);
+        ecs_name_index_free(r->name_index);
+        ecs_vector_free(r->queries);
+    }
+
+    int32_t i;
+    for (i = 0; i < ECS_HI_COMPONENT_ID; i ++) {
+        r = world->id_index_lo[i];
+        if (r) {
+            ecs_map_free(r->table_index);
+            ecs_name_index_free(r->name_index);
+            ecs_vector_free(r->queries);
+            ecs_os_free(r);
+        }
     }
 
     ecs_map_free(world->id_index);
+    ecs_os_free(world->id_index_lo);
+    ecs_name_index_free(world->symbol_index);
 }
 
 static
@@ -953,6 +981,16 @@ void ecs_set_entity_range(
     world->stats.max_id = id_end;
 }
 
+void ecs_set_table_gc(
+    ecs_world_t *world,
+    int32_t empty_frames)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_OPERATION, NULL);
+    ecs_assert(empty_frames >= 0, ECS_INVALID_PARAMETER, NULL);
+    world->table_gc_frames = empty_frames;
+}
+
 bool ecs_enable_range_check(
     ecs_world_t *world,
     bool enable)
@@ -1204,6 +1242,10 @@ void ecs_frame_end(
         ecs_stage_merge_post_frame(world, stage);
     });        
 
+    if (world->table_gc_frames) {
+        ecs_delete_empty_tables(world, world->table_gc_frames);
+    }
+
     if (world->locking_enabled) {
         ecs_unlock(world);
 
@@ -1222,6 +1264,28 @@ const ecs_world_info_t* ecs_get_world_info(
     return &world->stats;
 }
 
+static
+void add_queries_for_id(
+    ecs_world_t *world,
+    ecs_id_t id,
+    int32_t stamp,
+    ecs_vector_t **result)
+{
+    ecs_id_record_t *r = ecs_get_id_record(world, id);
+    if (!r) {
+        return;
+    }
+
+    ecs_vector_each(r->queries, ecs_query_t*, q_ptr, {
+        ecs_query_t *q = *q_ptr;
+        if (q->match_stamp != stamp) {
+            q->match_stamp = stamp;
+            ecs_query_t **elem = ecs_vector_add(result, ecs_query_t*);
+            *elem = q;
+        }
+    });
+}
+
 void ecs_notify_queries(
     ecs_world_t *world,
     ecs_query_event_t *event)
@@ -1229,11 +1293,60 @@ void ecs_notify_queries(
     ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
     ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_OPERATION, NULL); 
 
-    int32_t i, count = ecs_sparse_count(world->queries);
+    ecs_query_eventkind_t kind = event->kind;
+    if (kind != EcsQueryTableMatch && kind != EcsQueryTableUnmatch) {
+        int32_t i, count = ecs_sparse_count(world->queries);
+        for (i = 0; i < count; i ++) {
+            ecs_query_notify(world, 
+                ecs_sparse_get(world->queries, ecs_query_t, i), event);
+        }
+        return;
+    }
+
+    /* A table can only match a query if it has the id (or the relation) the
+     * query is registered with, so only notify queries registered for one of
+     * the ids of the table. This uses the same ids as the table index. The
+     * queries are collected before they are notified, as notifying a query
+     * can create tables, which notifies queries recursively. */
+    ecs_vector_t *queries = NULL;
+    int32_t stamp = ++ world->query_match_stamp;
+    ecs_table_t *table = event->table;
+    int32_t i, count = ecs_vector_count(table->type);
+    ecs_id_t *ids = ecs_vector_first(table->type, ecs_id_t);
+
     for (i = 0; i < count; i ++) {
-        ecs_query_notify(world, 
-            ecs_sparse_get(world->queries, ecs_query_t, i), event);
-    }    
+        ecs_id_t id = ids[i];
+
+        if (ECS_HAS_RELATION(id, EcsIsA)) {
+            id = ecs_pair(EcsIsA, ECS_PAIR_OBJECT(id));
+        }
+
+        if (ECS_HAS_RELATION(id, EcsChildOf)) {
+            id = ecs_pair(EcsChildOf, ECS_PAIR_OBJECT(id));
+        }
+
+        add_queries_for_id(world, id, stamp, &queries);
+
+        if (ECS_HAS_ROLE(id, PAIR)) {
+            add_queries_for_id(world, 
+                ecs_pair(ECS_PAIR_RELATION(id), EcsWildcard), stamp, &queries);
+            add_queries_for_id(world, 
+                ecs_pair(EcsWildcard, ECS_PAIR_OBJECT(id)), stamp, &queries);
+            add_queries_for_id(world, 
+                ecs_pair(EcsWildcard, EcsWildcard), stamp, &queries);
+        }
+    }
+
+    ecs_vector_each(world->unindexed_queries, ecs_query_t*, q_ptr, {
+        ecs_query_t **elem = ecs_vector_add(&queries, ecs_query_t*);
+        *elem = *q_ptr;
+    });
+
+    ecs_vector_each(queries, ecs_query_t*, q_ptr, {
+        ecs_query_notify(world, *q_ptr, event);
+    });
+
+    ecs_vector_free(queries);
 }
 
 void ecs_delete_table(
@@ -1260,6 +1373,73 @@ void ecs_delete_table(
     ecs_sparse_remove(world->store.tables, id);
 }
 
+int32_t ecs_delete_empty_tables(
+    ecs_world_t *world,
+    int32_t empty_frames)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_OPERATION, NULL);
+    ecs_assert(!world->is_readonly, ECS_INVALID_OPERATION, NULL);
+    ecs_assert(empty_frames >= 0, ECS_INVALID_PARAMETER, NULL);
+
+    /* Snapshots store pointers to tables */
+    if (world->snapshot_count) {
+        return 0;
+    }
+
+    ecs_vector_t *to_delete = NULL;
+    int32_t i, count = ecs_sparse_count(world->store.tables);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_sparse_get(
+            world->store.tables, ecs_table_t, i);
+
+        /* Table is being iterated */
+        if (table->lock) {
+            continue;
+        }
+
+        if (ecs_table_count(table)) {
+            table->gc_count = 0;
+            ecs_table_shrink(world, table);
+            continue;
+        }
+
+        if (table->flags & (EcsTableHasBuiltins | EcsTableIsPinned) ||
+            table->gc_count < empty_frames) 
+        {
+            table->gc_count ++;
+            ecs_table_shrink(world, table);
+            continue;
+        }
+
+        table->flags |= EcsTableMarkedForDelete;
+        ecs_table_t **elem = ecs_vector_add(&to_delete, ecs_table_t*);
+        *elem = table;
+    }
+
+    int32_t delete_count = ecs_vector_count(to_delete);
+    if (!delete_count) {
+        return 0;
+    }
+
+    /* Remove edges to deleted tables before deleting, since not all edges can
+     * be found from the deleted tables */
+    ecs_table_clear_edges_to_deleted(world, &world->store.root);
+    for (i = 0; i < count; i ++) {
+        ecs_table_clear_edges_to_deleted(world, 
+            ecs_sparse_get(world->store.tables, ecs_table_t, i));
+    }
+
+    ecs_vector_each(to_delete, ecs_table_t*, table_ptr, {
+        ecs_delete_table(world, *table_ptr);
+    });
+
+    ecs_vector_free(to_delete);
+
+    return delete_count;
+}
+
 static
 void register_table_for_id(
     ecs_world_t *world,
@@ -1416,10 +1596,21 @@ void ecs_unregister_table(
     ecs_hashmap_remove(world->store.table_map, &key, ecs_table_t*);
 }
 
+/* Records for low ids are stored in a dense array, which avoids a map lookup
+ * for the most frequently requested (component) ids. */
 ecs_id_record_t* ecs_ensure_id_record(
     const ecs_world_t *world,
     ecs_id_t id)
 {
+    if (id < ECS_HI_COMPONENT_ID) {
+        ecs_id_record_t *r = world->id_index_lo[id];
+        if (!r) {
+            r = world->id_index_lo[id] = ecs_os_calloc(
+                ECS_SIZEOF(ecs_id_record_t));
+        }
+        return r;
+    }
+
     return ecs_map_ensure(world->id_index, ecs_id_record_t, id);
 }
 
@@ -1427,6 +1618,10 @@ ecs_id_record_t* ecs_get_id_record(
     const ecs_world_t *world,
     ecs_id_t id)
 {
+    if (id < ECS_HI_COMPONENT_ID) {
+        return world->id_index_lo[id];
+    }
+
     return ecs_map_get(world->id_index, ecs_id_record_t, id);
 }
 
@@ -1440,5 +1635,19 @@ void ecs_clear_id_record(
     }
 
     ecs_map_free(r->table_index);
-    ecs_map_remove(world->id_index, id);
+    r->table_index = NULL;
+
+    ecs_name_index_free(r->name_index);
+    r->name_index = NULL;
+
+    /* Keep record alive while queries are registered with it */
+    if (!ecs_vector_count(r->queries)) {
+        ecs_vector_free(r->queries);
+        if (id < ECS_HI_COMPONENT_ID) {
+            ecs_os_free(r);
+            world->id_index_lo[id] = NULL;
+        } else {
+            ecs_map_remove(world->id_index, id);
+        }
+    }
 }
@@ -687,3 +687,41 @@ void Add_add_after_remove_xor() {
     ecs_fini(world);
 }
 
+
+void Add_add_remove_many_lo_ids() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t ids[64];
+    int32_t i;
+    for (i = 0; i < 64; i ++) {
+        ids[i] = ecs_new_component_id(world);
+        test_assert(ids[i] < ECS_HI_COMPONENT_ID);
+    }
+
+    ecs_entity_t e1 = ecs_new(world, 0);
+    for (i = 0; i < 64; i ++) {
+        ecs_add_id(world, e1, ids[i]);
+    }
+
+    ecs_type_t type = ecs_get_type(world, e1);
+    test_int(ecs_vector_count(type), 64);
+
+    for (i = 0; i < 64; i ++) {
+        test_assert(ecs_has_id(world, e1, ids[i]));
+    }
+
+    /* Second traversal uses edges created by the first */
+    ecs_entity_t e2 = ecs_new(world, 0);
+    for (i = 0; i < 64; i ++) {
+        ecs_add_id(world, e2, ids[i]);
+    }
+    test_assert(ecs_get_type(world, e2) == type);
+
+    for (i = 63; i >= 0; i --) {
+        ecs_remove_id(world, e2, ids[i]);
+        test_assert(!ecs_has_id(world, e2, ids[i]));
+    }
+    test_assert(ecs_get_type(world, e2) == NULL);
+
+    ecs_fini(world);
+}
@@ -1365,10 +1365,11 @@ void ComponentLifecycle_move_on_realloc() {
 
     ctx = (cl_ctx){ { 0 } };
 
-    /* Trigger realloc & move */
+    /* Trigger realloc & move. Old element is moved with ctor + move, new
+     * elements are constructed separately. */
     ecs_new(world, Position);
     ecs_new(world, Position);
-    test_int(ctx.ctor.invoked, 2);
+    test_int(ctx.ctor.invoked, 3);
     test_int(ctx.move.invoked, 1);
 
     ecs_fini(world);
@@ -1438,8 +1439,103 @@ void ComponentLifecycle_move_on_bulk_new() {
 
     /* Trigger realloc & move */
     ecs_bulk_new(world, Position, 1000);
+    test_int(ctx.ctor.invoked, 2);
+    test_int(ctx.move.invoked, 1);
+
+    ecs_fini(world);
+}
+
+void ComponentLifecycle_dtor_on_realloc() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    cl_ctx ctx = { { 0 } };
+
+    ecs_set(world, ecs_id(Position), EcsComponentLifecycle, {
+        .ctor = comp_ctor,
+        .dtor = comp_dtor,
+        .move = comp_move,
+        .ctx = &ctx
+    });
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_set(world, e, Position, {1, 2});
     test_int(ctx.ctor.invoked, 1);
+
+    ctx = (cl_ctx){ { 0 } };
+
+    /* Trigger realloc & move. Moved-from elements are destructed, and only
+     * the old elements are passed to move and dtor. */
+    ecs_bulk_new(world, Position, 1000);
     test_int(ctx.move.invoked, 1);
+    test_int(ctx.move.count, 1);
+    test_int(ctx.move.entity, e);
+    test_int(ctx.dtor.invoked, 1);
+    test_int(ctx.dtor.count, 1);
+    test_int(ctx.dtor.entity, e);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_fini(world);
+}
+
+static int move_ctor_invoked = 0;
+
+static
+void comp_move_ctor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const EcsComponentLifecycle *lifecycle,
+    const ecs_entity_t *dst_entity,
+    const ecs_entity_t *src_entity,
+    void *dst_ptr,
+    void *src_ptr,
+    size_t size,
+    int32_t count,
+    void *ctx)
+{
+    move_ctor_invoked ++;
+    memcpy(dst_ptr, src_ptr, size * count);
+}
+
+void ComponentLifecycle_move_ctor_on_realloc() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    cl_ctx ctx = { { 0 } };
+
+    ecs_set(world, ecs_id(Position), EcsComponentLifecycle, {
+        .ctor = comp_ctor,
+        .dtor = comp_dtor,
+        .move = comp_move,
+        .move_ctor = comp_move_ctor,
+        .ctx = &ctx
+    });
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_set(world, e, Position, {1, 2});
+
+    ctx = (cl_ctx){ { 0 } };
+    move_ctor_invoked = 0;
+
+    /* Old element is relocated with the move ctor, which means that neither
+     * the ctor nor the move should be invoked for it. */
+    ecs_bulk_new(world, Position, 1000);
+    test_int(move_ctor_invoked, 1);
+    test_int(ctx.move.invoked, 0);
+    test_int(ctx.ctor.invoked, 1);
+    test_int(ctx.ctor.count, 1000);
+    test_int(ctx.dtor.invoked, 1);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
 
     ecs_fini(world);
 }
@@ -1617,3 +1617,304 @@ void DeferredActions_defer_disable() {
 
     ecs_fini(world);
 }
+
+void DeferredActions_defer_set_1000() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t entities[1000];
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        entities[i] = ecs_new_id(world);
+    }
+
+    /* Twice, so that the second time the queue memory is reused */
+    int j;
+    for (j = 0; j < 2; j ++) {
+        ecs_defer_begin(world);
+        for (i = 0; i < 1000; i ++) {
+            ecs_set(world, entities[i], Position, {i, j});
+        }
+        if (!j) {
+            test_assert(!ecs_has(world, entities[0], Position));
+        }
+        ecs_defer_end(world);
+
+        for (i = 0; i < 1000; i ++) {
+            const Position *p = ecs_get(world, entities[i], Position);
+            test_assert(p != NULL);
+            test_int(p->x, i);
+            test_int(p->y, j);
+        }
+    }
+
+    ecs_fini(world);
+}
+
+typedef struct LargeComponent {
+    char data[16 * 1024];
+} LargeComponent;
+
+void DeferredActions_defer_set_large_value() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, LargeComponent);
+
+    LargeComponent *value = ecs_os_calloc(ECS_SIZEOF(LargeComponent));
+    ecs_entity_t entities[10];
+
+    ecs_defer_begin(world);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        entities[i] = ecs_new_id(world);
+        value->data[0] = (char)i;
+        value->data[sizeof(value->data) - 1] = (char)(i + 1);
+        ecs_set(world, entities[i], Position, {i, 0});
+        ecs_set_ptr(world, entities[i], LargeComponent, value);
+    }
+
+    ecs_defer_end(world);
+
+    for (i = 0; i < 10; i ++) {
+        const LargeComponent *ptr = ecs_get(world, entities[i], LargeComponent);
+        test_assert(ptr != NULL);
+        test_int(ptr->data[0], i);
+        test_int(ptr->data[sizeof(ptr->data) - 1], i + 1);
+
+        const Position *p = ecs_get(world, entities[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+    }
+
+    ecs_os_free(value);
+
+    ecs_fini(world);
+}
+
+void DeferredActions_defer_get_mut_after_many_ops() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = ecs_new_id(world);
+
+    ecs_defer_begin(world);
+    Position *p = ecs_get_mut(world, e, Position, NULL);
+    test_assert(p != NULL);
+
+    /* Enqueue enough operations to fill more than one chunk. The pointer
+     * returned by get_mut must remain valid. */
+    int i;
+    for (i = 0; i < 5000; i ++) {
+        ecs_set(world, ecs_new_id(world), Velocity, {i, i});
+    }
+
+    p->x = 10;
+    p->y = 20;
+    ecs_defer_end(world);
+
+    const Position *ptr = ecs_get(world, e, Position);
+    test_assert(ptr != NULL);
+    test_int(ptr->x, 10);
+    test_int(ptr->y, 20);
+
+    ecs_fini(world);
+}
+
+void DeferredActions_defer_bulk_new_w_data_after_many_ops() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_defer_begin(world);
+
+    int i;
+    for (i = 0; i < 5000; i ++) {
+        ecs_new(world, Position);
+    }
+
+    /* Data that doesn't fit in a single chunk */
+    Position *data = ecs_os_malloc(ECS_SIZEOF(Position) * 10000);
+    for (i = 0; i < 10000; i ++) {
+        data[i] = (Position){i, i * 2};
+    }
+
+    const ecs_entity_t *ids = ecs_bulk_new_w_data(world, 10000, 
+        &(ecs_ids_t){ .array = (ecs_entity_t[]){ ecs_id(Position) }, .count = 1 },
+        (void*[]){ data });
+    test_assert(ids != NULL);
+
+    ecs_entity_t e1 = ids[0], e2 = ids[5000], e3 = ids[9999];
+    ecs_os_free(data);
+
+    ecs_defer_end(world);
+
+    test_int(ecs_count(world, Position), 15000);
+    test_int(ecs_get(world, e1, Position)->x, 0);
+    test_int(ecs_get(world, e2, Position)->x, 5000);
+    test_int(ecs_get(world, e3, Position)->y, 19998);
+
+    ecs_fini(world);
+}
+
+void DeferredActions_defer_batch_add_3_components() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ecs_set_defer_batching(world, true);
+
+    ecs_entity_t e = ecs_new(world, 0);
+
+    ecs_defer_begin(world);
+    ecs_add(world, e, Position);
+    ecs_add(world, e, Velocity);
+    ecs_add(world, e, Mass);
+    test_assert(!ecs_has(world, e, Position));
+    ecs_defer_end(world);
+
+    test_assert(ecs_has(world, e, Position));
+    test_assert(ecs_has(world, e, Velocity));
+    test_assert(ecs_has(world, e, Mass));
+
+    ecs_fini(world);
+}
+
+static
+void OnAddPosition(ecs_iter_t *it) {
+    probe_system(it);
+}
+
+void DeferredActions_defer_batch_add_1000_w_on_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TRIGGER(world, OnAddPosition, EcsOnAdd, Position);
+
+    Probe ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_set_defer_batching(world, true);
+
+    ecs_entity_t ids[1000];
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        ids[i] = ecs_new(world, Velocity);
+    }
+
+    ecs_defer_begin(world);
+    for (i = 0; i < 1000; i ++) {
+        ecs_add(world, ids[i], Position);
+    }
+    test_int(ctx.count, 0);
+    ecs_defer_end(world);
+
+    /* All entities moved from the same table, so the trigger is invoked once
+     * for all of them */
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 1000);
+
+    for (i = 0; i < 1000; i ++) {
+        test_assert(ecs_has(world, ids[i], Position));
+        test_assert(ecs_has(world, ids[i], Velocity));
+    }
+
+    test_int(ecs_count(world, Position), 1000);
+
+    ecs_fini(world);
+}
+
+void DeferredActions_defer_batch_add_set_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ecs_set_defer_batching(world, true);
+
+    ecs_entity_t e1 = ecs_new(world, 0);
+    ecs_entity_t e2 = ecs_new(world, 0);
+
+    ecs_defer_begin(world);
+    ecs_add(world, e1, Position);
+    ecs_add(world, e2, Position);
+    ecs_set(world, e1, Velocity, {1, 2});
+    ecs_add(world, e1, Mass);
+    ecs_add(world, e2, Mass);
+    ecs_defer_end(world);
+
+    test_assert(ecs_has(world, e1, Position));
+    test_assert(ecs_has(world, e1, Mass));
+    test_assert(ecs_has(world, e2, Position));
+    test_assert(ecs_has(world, e2, Mass));
+    test_assert(!ecs_has(world, e2, Velocity));
+
+    const Velocity *v = ecs_get(world, e1, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_fini(world);
+}
+
+void DeferredActions_defer_batch_add_remove_same() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_set_defer_batching(world, true);
+
+    ecs_entity_t e1 = ecs_new(world, Velocity);
+    ecs_entity_t e2 = ecs_new(world, Velocity);
+
+    ecs_defer_begin(world);
+    ecs_add(world, e1, Position);
+    ecs_remove(world, e1, Position);
+    ecs_add(world, e2, Position);
+    ecs_remove(world, e2, Velocity);
+    ecs_defer_end(world);
+
+    test_assert(!ecs_has(world, e1, Position));
+    test_assert(ecs_has(world, e1, Velocity));
+    test_assert(ecs_has(world, e2, Position));
+    test_assert(!ecs_has(world, e2, Velocity));
+
+    ecs_fini(world);
+}
+
+void DeferredActions_defer_batch_new_w_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_set_defer_batching(world, true);
+
+    ecs_entity_t ids[100];
+
+    ecs_defer_begin(world);
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ids[i] = ecs_new(world, Position);
+        ecs_add(world, ids[i], Velocity);
+    }
+    ecs_defer_end(world);
+
+    for (i = 0; i < 100; i ++) {
+        test_assert(ecs_has(world, ids[i], Position));
+        test_assert(ecs_has(world, ids[i], Velocity));
+    }
+
+    test_int(ecs_count(world, Position), 100);
+
+    ecs_fini(world);
+}
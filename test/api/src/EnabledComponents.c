@@ -1086,3 +1086,99 @@ void EnabledComponents_sort() {
 
     ecs_fini(world);
 }
+
+void EnabledComponents_query_disabled_2_tables() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t e1 = ecs_new(world, Position);
+    ecs_entity_t e2 = ecs_new(world, Position);
+    ecs_entity_t e3 = ecs_new(world, Position);
+    ecs_add(world, e3, Tag);
+    ecs_entity_t e4 = ecs_new(world, Position);
+    ecs_add(world, e4, Tag);
+
+    ecs_enable_component(world, e1, Position, false);
+    ecs_enable_component(world, e2, Position, true);
+    ecs_enable_component(world, e3, Position, true);
+    ecs_enable_component(world, e4, Position, true);
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    ecs_iter_t it = ecs_query_iter(q);
+
+    int32_t count = 0;
+    while (ecs_query_next(&it)) {
+        int32_t i;
+        for (i = 0; i < it.count; i ++) {
+            test_assert(it.entities[i] != e1);
+            test_assert(ecs_is_component_enabled(
+                world, it.entities[i], Position));
+        }
+        count += it.count;
+    }
+
+    test_int(count, 3);
+
+    ecs_fini(world);
+}
+
+void EnabledComponents_query_disabled_long_runs() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    /* Runs of 300 enabled and 300 disabled entities, which span blocks */
+    int32_t i;
+    for (i = 0; i < 3000; i ++) {
+        ecs_entity_t e = ecs_new(world, Position);
+        ecs_enable_component(world, e, Position, !((i / 300) % 2));
+    }
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    ecs_iter_t it = ecs_query_iter(q);
+
+    int32_t count = 0, runs = 0;
+    while (ecs_query_next(&it)) {
+        test_int(it.offset, runs * 600);
+        test_int(it.count, 300);
+        for (i = 0; i < it.count; i ++) {
+            test_assert(ecs_is_component_enabled(
+                world, it.entities[i], Position));
+        }
+        count += it.count;
+        runs ++;
+    }
+
+    test_int(runs, 5);
+    test_int(count, 1500);
+
+    ecs_fini(world);
+}
+
+void EnabledComponents_query_disabled_long_runs_2_bitsets() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    /* Position is enabled for [0, 1000), Velocity for [500, 1500) */
+    int32_t i;
+    for (i = 0; i < 2000; i ++) {
+        ecs_entity_t e = ecs_new(world, Position);
+        ecs_add(world, e, Velocity);
+        ecs_enable_component(world, e, Position, i < 1000);
+        ecs_enable_component(world, e, Velocity, i >= 500 && i < 1500);
+    }
+
+    ecs_query_t *q = ecs_query_new(world, "Position, Velocity");
+    ecs_iter_t it = ecs_query_iter(q);
+
+    test_assert(ecs_query_next(&it));
+    test_int(it.offset, 500);
+    test_int(it.count, 500);
+    test_assert(!ecs_query_next(&it));
+
+    ecs_fini(world);
+}
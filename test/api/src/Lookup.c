@@ -276,3 +276,141 @@ void Lookup_lookup_symbol_null() {
 
     ecs_fini(world);
 }
+
+void Lookup_lookup_child_after_reparent() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent1, 0);
+    ECS_ENTITY(world, Parent2, 0);
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"Child"});
+    ecs_add_pair(world, e, EcsChildOf, Parent1);
+    test_assert(ecs_lookup_child(world, Parent1, "Child") == e);
+    test_assert(ecs_lookup_child(world, Parent2, "Child") == 0);
+
+    ecs_remove_pair(world, e, EcsChildOf, Parent1);
+    ecs_add_pair(world, e, EcsChildOf, Parent2);
+    test_assert(ecs_lookup_child(world, Parent1, "Child") == 0);
+    test_assert(ecs_lookup_child(world, Parent2, "Child") == e);
+    test_assert(ecs_lookup_fullpath(world, "Parent2.Child") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_child_after_rename() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"Foo"});
+    ecs_add_pair(world, e, EcsChildOf, Parent);
+    test_assert(ecs_lookup_child(world, Parent, "Foo") == e);
+
+    ecs_set(world, e, EcsName, {"Bar"});
+    test_assert(ecs_lookup_child(world, Parent, "Foo") == 0);
+    test_assert(ecs_lookup_child(world, Parent, "Bar") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_child_after_remove_name() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"Child"});
+    ecs_add_pair(world, e, EcsChildOf, Parent);
+    test_assert(ecs_lookup_child(world, Parent, "Child") == e);
+
+    ecs_remove(world, e, EcsName);
+    test_assert(ecs_lookup_child(world, Parent, "Child") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_deleted_child() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t e1 = ecs_set(world, 0, EcsName, {"Child"});
+    ecs_add_pair(world, e1, EcsChildOf, Parent);
+    test_assert(ecs_lookup_child(world, Parent, "Child") == e1);
+
+    ecs_delete(world, e1);
+    test_assert(ecs_lookup_child(world, Parent, "Child") == 0);
+
+    /* Recycled id with the same name */
+    ecs_entity_t e2 = ecs_set(world, 0, EcsName, {"Child"});
+    ecs_add_pair(world, e2, EcsChildOf, Parent);
+    test_assert(ecs_lookup_child(world, Parent, "Child") == e2);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_child_many() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t children[1000];
+    char name[32];
+    int32_t i;
+    for (i = 0; i < 1000; i ++) {
+        sprintf(name, "Child%d", i);
+        children[i] = ecs_set(world, 0, EcsName, {.alloc_value = name});
+        ecs_add_pair(world, children[i], EcsChildOf, Parent);
+    }
+
+    for (i = 0; i < 1000; i += 2) {
+        ecs_delete(world, children[i]);
+    }
+
+    for (i = 0; i < 1000; i ++) {
+        sprintf(name, "Child%d", i);
+        if (i % 2) {
+            test_assert(ecs_lookup_child(world, Parent, name) == children[i]);
+        } else {
+            test_assert(ecs_lookup_child(world, Parent, name) == 0);
+        }
+    }
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_symbol_after_set_symbol() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"e", .symbol = "Foo"});
+    test_assert(ecs_lookup_symbol(world, "Foo") == e);
+
+    ecs_set(world, e, EcsName, {"e", .symbol = "Bar"});
+    test_assert(ecs_lookup_symbol(world, "Foo") == 0);
+    test_assert(ecs_lookup_symbol(world, "Bar") == e);
+
+    ecs_delete(world, e);
+    test_assert(ecs_lookup_symbol(world, "Bar") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_child_after_snapshot_restore() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"Foo"});
+    ecs_add_pair(world, e, EcsChildOf, Parent);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_set(world, e, EcsName, {"Bar"});
+    test_assert(ecs_lookup_child(world, Parent, "Foo") == 0);
+    test_assert(ecs_lookup_child(world, Parent, "Bar") == e);
+
+    ecs_snapshot_restore(world, s);
+    test_assert(ecs_lookup_child(world, Parent, "Foo") == e);
+    test_assert(ecs_lookup_child(world, Parent, "Bar") == 0);
+
+    ecs_fini(world);
+}
@@ -884,3 +884,250 @@ void MultiThread_fini_after_set_threads() {
     // Make sure code doesn't crash
     test_assert(true);
 }
+
+void MultiThread_work_stealing_2_thread_uneven_tables() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 5000, THREADS = 2;
+    ecs_entity_t *handles = ecs_os_malloc(sizeof(ecs_entity_t) * ENTITIES);
+
+    /* Most entities are in a single table, the rest in small tables */
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+        if (i < 10) {
+            ecs_add(world, handles[i], TagA);
+        } else if (i < 20) {
+            ecs_add(world, handles[i], TagB);
+        }
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_work_stealing(world, true);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position)->x, 1);
+    }
+
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position)->x, 2);
+    }
+
+    ecs_os_free(handles);
+
+    ecs_fini(world);
+}
+
+static
+void ProgressVelocity(ecs_iter_t *it) {
+    Progress(it);
+}
+
+void MultiThread_work_stealing_6_thread_1000_entity() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+    ECS_SYSTEM(world, ProgressVelocity, EcsOnUpdate, Position, Velocity);
+
+    int i, ENTITIES = 1000, THREADS = 6;
+    ecs_entity_t *handles = ecs_os_malloc(sizeof(ecs_entity_t) * ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+        if (i % 2) {
+            ecs_set(world, handles[i], Velocity, {0});
+        }
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_work_stealing(world, true);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position)->x, 1 + (i % 2));
+    }
+
+    ecs_os_free(handles);
+
+    ecs_fini(world);
+}
+
+static
+void AddVelocity(ecs_iter_t *it) {
+    ECS_COLUMN_COMPONENT(it, Velocity, 2);
+
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        ecs_set(it->world, it->entities[i], Velocity, {1, 2});
+    }
+}
+
+void MultiThread_work_stealing_w_deferred_add() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, AddVelocity, EcsOnUpdate, Position, [out] :Velocity);
+
+    int i, ENTITIES = 1000, THREADS = 4;
+    ecs_entity_t *handles = ecs_os_malloc(sizeof(ecs_entity_t) * ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_work_stealing(world, true);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        const Velocity *v = ecs_get(world, handles[i], Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 1);
+        test_int(v->y, 2);
+    }
+
+    ecs_os_free(handles);
+
+    ecs_fini(world);
+}
+
+static
+void IncPosition(ecs_iter_t *it) {
+    Position *p = ecs_term(it, Position, 1);
+
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        p[i].x ++;
+    }
+}
+
+static
+void IncVelocity(ecs_iter_t *it) {
+    Velocity *v = ecs_term(it, Velocity, 1);
+
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        v[i].x ++;
+    }
+}
+
+static
+void CopyPosition(ecs_iter_t *it) {
+    Position *p = ecs_term(it, Position, 1);
+    Velocity *v = ecs_term(it, Velocity, 2);
+
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        v[i].x = p[i].x;
+    }
+}
+
+void MultiThread_parallel_systems_disjoint() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, IncPosition, EcsOnUpdate, Position);
+    ECS_SYSTEM(world, IncVelocity, EcsOnUpdate, Velocity);
+
+    int i, ENTITIES = 1000, THREADS = 4;
+    ecs_entity_t *handles = ecs_os_malloc(sizeof(ecs_entity_t) * ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+        ecs_set(world, handles[i], Velocity, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_parallel_systems(world, true);
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position)->x, 2);
+        test_int(ecs_get(world, handles[i], Velocity)->x, 2);
+    }
+
+    ecs_os_free(handles);
+
+    ecs_fini(world);
+}
+
+void MultiThread_parallel_systems_conflicting() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, IncPosition, EcsOnUpdate, Position);
+    ECS_SYSTEM(world, CopyPosition, EcsOnUpdate, [in] Position, [out] Velocity);
+    ECS_SYSTEM(world, IncVelocity, EcsOnUpdate, Velocity);
+
+    int i, ENTITIES = 1000, THREADS = 4;
+    ecs_entity_t *handles = ecs_os_malloc(sizeof(ecs_entity_t) * ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+        ecs_set(world, handles[i], Velocity, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_parallel_systems(world, true);
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position)->x, 2);
+        test_int(ecs_get(world, handles[i], Velocity)->x, 3);
+    }
+
+    ecs_os_free(handles);
+
+    ecs_fini(world);
+}
+
+static
+void SetVelocity(ecs_iter_t *it) {
+    ECS_COLUMN_COMPONENT(it, Velocity, 2);
+
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        ecs_set(it->world, it->entities[i], Velocity, {10, 20});
+    }
+}
+
+void MultiThread_parallel_systems_w_merge() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, SetVelocity, EcsOnUpdate, Position, [out] :Velocity);
+    ECS_SYSTEM(world, IncVelocity, EcsOnUpdate, Velocity);
+    ECS_SYSTEM(world, IncPosition, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 1000, THREADS = 4;
+    ecs_entity_t *handles = ecs_os_malloc(sizeof(ecs_entity_t) * ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_parallel_systems(world, true);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position)->x, 1);
+        const Velocity *v = ecs_get(world, handles[i], Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 11);
+        test_int(v->y, 20);
+    }
+
+    ecs_os_free(handles);
+
+    ecs_fini(world);
+}
@@ -465,3 +465,153 @@ void MultiThreadStaging_custom_thread_partial_manual_merge() {
 
     ecs_fini(world);
 }
+
+static
+void stage_new_ids(
+    ecs_world_t *stage,
+    ecs_entity_t *ids,
+    int32_t count)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        ids[i] = ecs_new_id(stage);
+    }
+}
+
+void MultiThreadStaging_new_id_unique_across_stages() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_stages(world, 2);
+
+    ecs_world_t *ctx_1 = ecs_get_stage(world, 0);
+    ecs_world_t *ctx_2 = ecs_get_stage(world, 1);
+
+    ecs_entity_t ids[4][200];
+
+    int32_t f;
+    for (f = 0; f < 2; f ++) {
+        ecs_frame_begin(world, 0);
+        ecs_staging_begin(world);
+
+        stage_new_ids(ctx_1, ids[f * 2], 200);
+        stage_new_ids(ctx_2, ids[f * 2 + 1], 200);
+
+        int32_t i;
+        for (i = 0; i < 200; i ++) {
+            ecs_set(ctx_1, ids[f * 2][i], Position, {i, f});
+            ecs_set(ctx_2, ids[f * 2 + 1][i], Position, {i, f});
+        }
+
+        ecs_staging_end(world);
+        ecs_frame_end(world);
+    }
+
+    test_int(ecs_count(world, Position), 800);
+
+    int32_t i, j;
+    for (i = 0; i < 800; i ++) {
+        ecs_entity_t e = ids[0][i];
+        test_assert(ecs_is_alive(world, e));
+        test_assert(ecs_has(world, e, Position));
+        for (j = i + 1; j < 800; j ++) {
+            test_assert(e != ids[0][j]);
+        }
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThreadStaging_new_id_recycle_in_stage() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_stages(world, 2);
+
+    ecs_world_t *ctx_1 = ecs_get_stage(world, 0);
+    ecs_world_t *ctx_2 = ecs_get_stage(world, 1);
+
+    ecs_entity_t ids[2][100];
+
+    /* First frame sizes the id blocks of the stages */
+    ecs_frame_begin(world, 0);
+    ecs_staging_begin(world);
+    stage_new_ids(ctx_1, ids[0], 100);
+    stage_new_ids(ctx_2, ids[1], 100);
+    ecs_staging_end(world);
+    ecs_frame_end(world);
+
+    int32_t i;
+    for (i = 0; i < 200; i ++) {
+        ecs_delete(world, ids[0][i]);
+    }
+
+    /* Make sure there are more deleted ids than ids reserved by the stages */
+    ecs_entity_t extra[400];
+    for (i = 0; i < 400; i ++) {
+        extra[i] = ecs_new_id(world);
+    }
+    for (i = 0; i < 400; i ++) {
+        ecs_delete(world, extra[i]);
+    }
+
+    ecs_entity_t last_id = ecs_get_world_info(world)->last_id;
+
+    /* Deleted ids are recycled by the stages */
+    ecs_frame_begin(world, 0);
+    ecs_staging_begin(world);
+    stage_new_ids(ctx_1, ids[0], 100);
+    stage_new_ids(ctx_2, ids[1], 100);
+    ecs_staging_end(world);
+    ecs_frame_end(world);
+
+    for (i = 0; i < 200; i ++) {
+        ecs_entity_t e = ids[0][i];
+        test_assert(ecs_is_alive(world, e));
+        test_assert((uint32_t)e <= last_id);
+        test_assert(ECS_GENERATION(e) != 0);
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThreadStaging_new_id_release_unused() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_set_stages(world, 2);
+
+    ecs_world_t *ctx_1 = ecs_get_stage(world, 0);
+
+    ecs_entity_t ids[100];
+
+    ecs_frame_begin(world, 0);
+    ecs_staging_begin(world);
+    stage_new_ids(ctx_1, ids, 100);
+    ecs_staging_end(world);
+    ecs_frame_end(world);
+
+    /* Stage reserves a block, but doesn't use all ids */
+    ecs_frame_begin(world, 0);
+    ecs_staging_begin(world);
+    ecs_entity_t e = ecs_new_id(ctx_1);
+    test_assert(ecs_is_alive(world, e));
+    ecs_staging_end(world);
+    ecs_frame_end(world);
+
+    test_assert(ecs_is_alive(world, e));
+
+    /* Unused ids are returned without increasing their generation */
+    ecs_entity_t last_id = ecs_get_world_info(world)->last_id;
+    for (int32_t i = 0; i < 100; i ++) {
+        ecs_entity_t n = ecs_new_id(world);
+        test_int(ECS_GENERATION(n), 0);
+        test_assert(n != e);
+        test_assert(ecs_is_alive(world, n));
+    }
+
+    test_int(ecs_get_world_info(world)->last_id, last_id);
+
+    ecs_fini(world);
+}
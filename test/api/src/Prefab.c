@@ -3265,3 +3265,141 @@ void Prefab_rematch_after_add_to_recycled_base() {
 
     ecs_fini(world);
 }
+
+void Prefab_get_after_base_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base = ecs_new(world, 0);
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base);
+    test_assert(ecs_get(world, e, Position) == NULL);
+
+    ecs_set(world, base, Position, {10, 20});
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Prefab_get_after_base_remove() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base);
+    test_assert(ecs_get(world, e, Position) != NULL);
+
+    ecs_remove(world, base, Position);
+    test_assert(ecs_get(world, e, Position) == NULL);
+
+    ecs_fini(world);
+}
+
+void Prefab_get_after_base_row_change() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t base = ecs_set(world, 0, Position, {30, 40});
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    /* Moves base to the row of e1 */
+    ecs_delete(world, e1);
+
+    p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void Prefab_get_after_nested_base_override() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base_1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t base_2 = ecs_new_w_pair(world, EcsIsA, base_1);
+    ecs_entity_t base_3 = ecs_new_w_pair(world, EcsIsA, base_2);
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base_3);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_set(world, base_2, Position, {30, 40});
+
+    p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_remove(world, base_2, Position);
+
+    p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Prefab_get_after_base_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base_1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t base_2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base_1);
+    ecs_add_pair(world, e, EcsIsA, base_2);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_delete(world, base_1);
+
+    p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void Prefab_get_deferred_after_base_set() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base = ecs_new(world, 0);
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base);
+
+    ecs_defer_begin(world);
+    test_assert(ecs_get(world, e, Position) == NULL);
+    ecs_set(world, base, Position, {10, 20});
+    test_assert(ecs_get(world, e, Position) == NULL);
+    ecs_defer_end(world);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
@@ -1271,3 +1271,222 @@ void Queries_get_filter() {
 
     ecs_fini(world);
 }
+
+void Queries_match_new_table_w_rare_term() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t e1 = ecs_new(world, Position);
+    ecs_add(world, e1, Velocity);
+
+    ecs_query_t *q = ecs_query_new(world, "Position, Tag");
+    test_assert(q != NULL);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_assert(!ecs_query_next(&it));
+
+    ecs_entity_t e2 = ecs_new(world, Position);
+    ecs_add(world, e2, Tag);
+
+    ecs_entity_t e3 = ecs_new(world, Tag);
+    ecs_add(world, e3, Velocity);
+    ecs_add(world, e3, Position);
+
+    it = ecs_query_iter(q);
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_int(it.entities[0], e2);
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_int(it.entities[0], e3);
+    test_assert(!ecs_query_next(&it));
+
+    ecs_fini(world);
+}
+
+void Queries_match_new_table_w_isa_base() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_query_t *q = ecs_query_new(world, "ANY:Position, Tag");
+    test_assert(q != NULL);
+
+    ecs_entity_t base = ecs_new(world, Position);
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base);
+    ecs_add(world, e, Tag);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_int(it.entities[0], e);
+    test_assert(!ecs_query_next(&it));
+
+    ecs_fini(world);
+}
+
+void Queries_match_existing_table_w_isa_base() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t base = ecs_new(world, Tag);
+    ecs_entity_t e1 = ecs_new_w_pair(world, EcsIsA, base);
+    ecs_add(world, e1, Position);
+    ecs_entity_t e2 = ecs_new(world, Position);
+    ecs_add(world, e2, Tag);
+
+    ecs_query_t *q = ecs_query_new(world, "ANY:Tag");
+    test_assert(q != NULL);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_int(it.entities[0], base);
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_int(it.entities[0], e1);
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_int(it.entities[0], e2);
+    test_assert(!ecs_query_next(&it));
+
+    ecs_fini(world);
+}
+
+void Queries_match_new_table_after_query_fini() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_query_t *q_1 = ecs_query_new(world, "Position, Tag");
+    ecs_query_t *q_2 = ecs_query_new(world, "Tag");
+    test_assert(q_1 != NULL);
+    test_assert(q_2 != NULL);
+
+    ecs_query_fini(q_1);
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_add(world, e, Tag);
+
+    ecs_iter_t it = ecs_query_iter(q_2);
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_int(it.entities[0], e);
+    test_assert(!ecs_query_next(&it));
+
+    ecs_fini(world);
+}
+
+void Queries_query_overaligned_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t ecs_id(Position) = ecs_component_init(world, 
+        &(ecs_component_desc_t){
+            .entity = {.name = "Position"},
+            .size = sizeof(Position),
+            .alignment = 64
+        });
+    test_assert(ecs_id(Position) != 0);
+
+    const EcsComponent *c = ecs_get(world, ecs_id(Position), EcsComponent);
+    test_assert(c != NULL);
+    test_int(c->alignment, 64);
+
+    int32_t i;
+    for (i = 0; i < 100; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i * 2});
+        if (i % 2) {
+            ecs_add(world, e, Tag);
+        }
+    }
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    test_assert(q != NULL);
+
+    int32_t count = 0;
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        Position *p = ecs_term(&it, Position, 1);
+        test_assert(!((uintptr_t)p & 63));
+
+        for (i = 0; i < it.count; i ++) {
+            test_int(p[i].y, p[i].x * 2);
+        }
+
+        count += it.count;
+    }
+
+    test_int(count, 100);
+
+    ecs_fini(world);
+}
+
+void Queries_query_terms_w_size() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e1, Velocity, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_set(world, e2, Velocity, {3, 4});
+
+    ecs_query_t *q = ecs_query_new(world, "Position, Velocity");
+    test_assert(q != NULL);
+
+    size_t sizes[] = {sizeof(Position), sizeof(Velocity)};
+
+    int32_t count = 0;
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        void *ptrs[2];
+        test_bool(ecs_terms_w_size(&it, 2, sizes, ptrs), false);
+        test_assert(ptrs[0] == ecs_term(&it, Position, 1));
+        test_assert(ptrs[1] == ecs_term(&it, Velocity, 2));
+        count += it.count;
+    }
+
+    test_int(count, 2);
+
+    ecs_fini(world);
+}
+
+void Queries_query_terms_w_size_shared() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ecs_entity_t base = ecs_set(world, 0, Velocity, {1, 2});
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_add_pair(world, e, EcsIsA, base);
+
+    ecs_query_t *q = ecs_query_new(world, "Position, SHARED:Velocity, ?Mass");
+    test_assert(q != NULL);
+
+    int32_t count = 0;
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        void *ptrs[3];
+        test_bool(ecs_terms_w_size(&it, 3, NULL, ptrs), true);
+        test_assert(ptrs[0] == ecs_term(&it, Position, 1));
+        test_assert(ptrs[1] == ecs_get(world, base, Velocity));
+        test_assert(ptrs[2] == NULL);
+        count += it.count;
+    }
+
+    test_int(count, 1);
+
+    ecs_fini(world);
+}
@@ -1564,3 +1564,409 @@ void ReaderWriter_delete_all_after_restore() {
 
     ecs_vector_free(v);
 }
+
+static
+void* serialize_to_blob(
+    ecs_world_t *world,
+    size_t *size)
+{
+    *size = ecs_world_to_blob(world, NULL, 0);
+    test_assert(*size != 0);
+
+    void *blob = ecs_os_malloc((ecs_size_t)*size);
+    test_assert(ecs_world_to_blob(world, blob, *size) == *size);
+    return blob;
+}
+
+void ReaderWriter_blob_simple() {
+    ecs_entity_t e1, e2, e3;
+    size_t size;
+    void *blob;
+
+    {
+        ecs_world_t *world = ecs_init();
+        ECS_COMPONENT(world, Position);
+        ECS_COMPONENT(world, Velocity);
+
+        e1 = ecs_set(world, 0, Position, {1, 2});
+        e2 = ecs_set(world, 0, Position, {3, 4});
+        ecs_set(world, e2, Velocity, {5, 6});
+        e3 = ecs_set(world, 0, Velocity, {7, 8});
+
+        blob = serialize_to_blob(world, &size);
+
+        ecs_fini(world);
+    }
+
+    {
+        ecs_world_t *world = ecs_init();
+        test_int(ecs_world_from_blob(world, blob, size), 0);
+
+        ECS_COMPONENT(world, Position);
+        ECS_COMPONENT(world, Velocity);
+
+        test_assert(ecs_is_alive(world, e1));
+        test_assert(ecs_is_alive(world, e2));
+        test_assert(ecs_is_alive(world, e3));
+
+        test_assert(ecs_has(world, e1, Position));
+        test_assert(!ecs_has(world, e1, Velocity));
+        test_assert(ecs_has(world, e2, Position));
+        test_assert(ecs_has(world, e2, Velocity));
+        test_assert(!ecs_has(world, e3, Position));
+        test_assert(ecs_has(world, e3, Velocity));
+
+        const Position *p = ecs_get(world, e1, Position);
+        test_int(p->x, 1);
+        test_int(p->y, 2);
+
+        p = ecs_get(world, e2, Position);
+        test_int(p->x, 3);
+        test_int(p->y, 4);
+
+        const Velocity *v = ecs_get(world, e2, Velocity);
+        test_int(v->x, 5);
+        test_int(v->y, 6);
+
+        v = ecs_get(world, e3, Velocity);
+        test_int(v->x, 7);
+        test_int(v->y, 8);
+
+        ecs_entity_t e = ecs_new(world, 0);
+        test_assert(e > e3);
+
+        ecs_fini(world);
+    }
+
+    ecs_os_free(blob);
+}
+
+void ReaderWriter_blob_tag() {
+    ecs_entity_t e1, e2, tag;
+    size_t size;
+    void *blob;
+
+    {
+        ecs_world_t *world = ecs_init();
+        ECS_COMPONENT(world, Position);
+        ECS_TAG(world, Tag);
+
+        e1 = ecs_new(world, Tag);
+        e2 = ecs_set(world, 0, Position, {1, 2});
+        ecs_add(world, e2, Tag);
+        tag = Tag;
+
+        blob = serialize_to_blob(world, &size);
+
+        ecs_fini(world);
+    }
+
+    {
+        ecs_world_t *world = ecs_init();
+        test_int(ecs_world_from_blob(world, blob, size), 0);
+
+        ECS_COMPONENT(world, Position);
+
+        test_assert(ecs_has_id(world, e1, tag));
+        test_assert(ecs_has_id(world, e2, tag));
+        test_assert(ecs_has(world, e2, Position));
+
+        const Position *p = ecs_get(world, e2, Position);
+        test_int(p->x, 1);
+        test_int(p->y, 2);
+
+        ecs_fini(world);
+    }
+
+    ecs_os_free(blob);
+}
+
+void ReaderWriter_blob_names() {
+    ecs_entity_t e1, e2, e3;
+    size_t size;
+    void *blob;
+
+    {
+        ecs_world_t *world = ecs_init();
+        ECS_COMPONENT(world, Position);
+
+        e1 = ecs_set(world, 0, EcsName, {"E1"});
+        e2 = ecs_set(world, 0, EcsName, {"Parent"});
+        e3 = ecs_set(world, 0, EcsName, {"Child"});
+        ecs_add_pair(world, e3, EcsChildOf, e2);
+        ecs_set(world, e3, Position, {10, 20});
+
+        blob = serialize_to_blob(world, &size);
+
+        ecs_fini(world);
+    }
+
+    {
+        ecs_world_t *world = ecs_init();
+        test_int(ecs_world_from_blob(world, blob, size), 0);
+
+        ECS_COMPONENT(world, Position);
+
+        test_str(ecs_get_name(world, e1), "E1");
+        test_str(ecs_get_name(world, e2), "Parent");
+        test_str(ecs_get_name(world, e3), "Child");
+
+        test_int(ecs_lookup(world, "E1"), e1);
+        test_int(ecs_lookup(world, "Parent"), e2);
+        test_int(ecs_lookup_fullpath(world, "Parent.Child"), e3);
+        test_assert(ecs_has_pair(world, e3, EcsChildOf, e2));
+
+        const Position *p = ecs_get(world, e3, Position);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+
+        ecs_fini(world);
+    }
+
+    ecs_os_free(blob);
+}
+
+typedef struct AlignedPosition {
+    float x;
+    float y;
+} AlignedPosition;
+
+void ReaderWriter_blob_aligned_columns() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t comp = ecs_component_init(world, &(ecs_component_desc_t){
+        .entity.name = "AlignedPosition",
+        .size = sizeof(AlignedPosition),
+        .alignment = 64
+    });
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        ecs_set_id(world, 0, comp, sizeof(AlignedPosition), 
+            &(AlignedPosition){i, i});
+    }
+
+    size_t size;
+    uint8_t *blob = serialize_to_blob(world, &size);
+
+    ecs_blob_header_t *hdr = (ecs_blob_header_t*)blob;
+    test_int(hdr->magic, ECS_BLOB_MAGIC);
+    test_int(hdr->version, ECS_BLOB_VERSION);
+    test_int(hdr->size, size);
+
+    /* Find the table with the aligned component */
+    bool found = false;
+    uint32_t t;
+    for (t = 0; t < hdr->table_count; t ++) {
+        ecs_blob_table_t *bt = (ecs_blob_table_t*)&blob[
+            hdr->tables + sizeof(ecs_blob_table_t) * t];
+        ecs_entity_t *type = (ecs_entity_t*)&blob[bt->type];
+        if (bt->type_count != 1 || type[0] != comp) {
+            continue;
+        }
+
+        ecs_blob_column_t *columns = (ecs_blob_column_t*)&blob[bt->columns];
+        test_int(bt->column_count, 2);
+        test_int(bt->row_count, 3);
+        test_int(columns[1].size, sizeof(AlignedPosition));
+        test_int(columns[1].alignment, 64);
+        test_int(columns[1].data % 64, 0);
+
+        AlignedPosition *ptr = (AlignedPosition*)&blob[columns[1].data];
+        for (i = 0; i < 3; i ++) {
+            test_int(ptr[i].x, i);
+            test_int(ptr[i].y, i);
+        }
+
+        found = true;
+    }
+
+    test_assert(found);
+
+    ecs_os_free(blob);
+    ecs_fini(world);
+}
+
+void ReaderWriter_blob_buffer_too_small() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+
+    ecs_set(world, 0, Position, {1, 2});
+
+    size_t size = ecs_world_to_blob(world, NULL, 0);
+    test_assert(size != 0);
+
+    uint8_t *blob = ecs_os_calloc((ecs_size_t)size);
+    test_assert(ecs_world_to_blob(world, blob, size - 1) == size);
+
+    /* Nothing is written if the buffer is too small */
+    size_t i;
+    for (i = 0; i < size; i ++) {
+        test_int(blob[i], 0);
+    }
+
+    ecs_os_free(blob);
+    ecs_fini(world);
+}
+
+void ReaderWriter_blob_invalid_header() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {1, 2});
+
+    size_t size;
+    uint8_t *blob = serialize_to_blob(world, &size);
+    ecs_blob_header_t *hdr = (ecs_blob_header_t*)blob;
+
+    ecs_world_t *dst = ecs_init();
+
+    /* Blob smaller than header */
+    test_assert(ecs_world_from_blob(dst, blob, 4) != 0);
+
+    /* Truncated blob */
+    test_assert(ecs_world_from_blob(dst, blob, size - 1) != 0);
+
+    hdr->magic ++;
+    test_assert(ecs_world_from_blob(dst, blob, size) != 0);
+    hdr->magic --;
+
+    hdr->version ++;
+    test_assert(ecs_world_from_blob(dst, blob, size) != 0);
+    hdr->version --;
+
+    hdr->tables = size;
+    test_assert(ecs_world_from_blob(dst, blob, size) != 0);
+
+    test_assert(!ecs_is_alive(dst, e));
+
+    ecs_fini(dst);
+    ecs_os_free(blob);
+    ecs_fini(world);
+}
+
+void ReaderWriter_blob_invalid_table() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {1, 2});
+
+    size_t size;
+    uint8_t *blob = serialize_to_blob(world, &size);
+    ecs_blob_header_t *hdr = (ecs_blob_header_t*)blob;
+
+    /* Corrupt the last table, so that earlier tables are valid */
+    ecs_blob_table_t *bt = (ecs_blob_table_t*)&blob[
+        hdr->tables + sizeof(ecs_blob_table_t) * (hdr->table_count - 1)];
+    ecs_blob_column_t *columns = (ecs_blob_column_t*)&blob[bt->columns];
+
+    ecs_world_t *dst = ecs_init();
+
+    bt->row_count = (uint32_t)size;
+    test_assert(ecs_world_from_blob(dst, blob, size) != 0);
+    bt->row_count = 1;
+
+    bt->column_count = bt->type_count + 2;
+    test_assert(ecs_world_from_blob(dst, blob, size) != 0);
+    bt->column_count = bt->type_count + 1;
+
+    columns[1].data = size;
+    test_assert(ecs_world_from_blob(dst, blob, size) != 0);
+
+    /* Nothing is restored if a table is corrupt */
+    test_assert(!ecs_is_alive(dst, e));
+    test_assert(ecs_lookup(dst, "Position") == 0);
+
+    ecs_fini(dst);
+    ecs_os_free(blob);
+    ecs_fini(world);
+}
+
+void ReaderWriter_blob_invalid_name() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_set(world, 0, EcsName, {"Foo"});
+
+    size_t size;
+    char *blob = serialize_to_blob(world, &size);
+
+    /* Names are stored at the end of the blob. Remove the terminator of the
+     * last name. */
+    test_int(blob[size - 1], 0);
+    blob[size - 1] = 'x';
+
+    ecs_world_t *dst = ecs_init();
+    test_assert(ecs_world_from_blob(dst, blob, size) != 0);
+    test_assert(ecs_lookup(dst, "Foo") == 0);
+
+    ecs_fini(dst);
+    ecs_os_free(blob);
+    ecs_fini(world);
+}
+
+void ReaderWriter_blob_recycled_id() {
+    ecs_entity_t e0, e1, e2;
+    size_t size;
+    void *blob;
+
+    {
+        ecs_world_t *world = ecs_init();
+        ECS_TAG(world, Tag);
+
+        e0 = ecs_new(world, Tag);
+        ecs_delete(world, e0);
+        e1 = ecs_new(world, Tag);
+        e2 = ecs_new(world, Tag);
+
+        blob = serialize_to_blob(world, &size);
+
+        ecs_fini(world);
+    }
+
+    {
+        ecs_world_t *world = ecs_init();
+        test_int(ecs_world_from_blob(world, blob, size), 0);
+
+        ECS_TAG(world, Tag);
+
+        ecs_entity_t e = ecs_new(world, 0);
+        test_assert((int32_t)e > (int32_t)e1);
+        test_assert((int32_t)e > (int32_t)e2);
+
+        test_assert(ecs_is_alive(world, e1));
+        test_assert(ecs_is_alive(world, e2));
+        test_assert(ecs_has(world, e1, Tag));
+        test_assert(ecs_has(world, e2, Tag));
+
+        ecs_fini(world);
+    }
+
+    ecs_os_free(blob);
+}
+
+void ReaderWriter_blob_deserialize_twice() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t n = ecs_set(world, 0, EcsName, {"Foo"});
+
+    size_t size;
+    void *blob = serialize_to_blob(world, &size);
+
+    ecs_set(world, e, Position, {3, 4});
+
+    test_int(ecs_world_from_blob(world, blob, size), 0);
+    test_int(ecs_world_from_blob(world, blob, size), 0);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    test_str(ecs_get_name(world, n), "Foo");
+    test_int(ecs_lookup(world, "Foo"), n);
+    test_int(ecs_count(world, Position), 1);
+
+    ecs_os_free(blob);
+    ecs_fini(world);
+}
@@ -852,3 +852,725 @@ void Snapshot_snapshot_w_new_in_onset_in_snapshot_table() {
 
     ecs_fini(world);
 }
+
+void Snapshot_snapshot_incremental() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_snapshot_t *s1 = ecs_snapshot_take(world);
+
+    ecs_set(world, e, Position, {30, 40});
+
+    ecs_snapshot_t *s2 = ecs_snapshot_take_incremental(world, s1);
+
+    ecs_set(world, e, Position, {50, 60});
+    ecs_set(world, e, Velocity, {3, 4});
+
+    ecs_snapshot_restore(world, s2);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    const Velocity *v = ecs_get(world, e, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_snapshot_restore(world, s1);
+
+    p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    v = ecs_get(world, e, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_incremental_free_prev() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s1 = ecs_snapshot_take(world);
+    ecs_snapshot_t *s2 = ecs_snapshot_take_incremental(world, s1);
+    ecs_snapshot_free(s1);
+
+    ecs_set(world, e, Position, {30, 40});
+
+    ecs_snapshot_restore(world, s2);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_incremental_free_next() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s1 = ecs_snapshot_take(world);
+    ecs_snapshot_t *s2 = ecs_snapshot_take_incremental(world, s1);
+    ecs_snapshot_free(s2);
+
+    ecs_set(world, e, Position, {30, 40});
+
+    ecs_snapshot_restore(world, s1);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_incremental_chain() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s1 = ecs_snapshot_take_incremental(world, NULL);
+    ecs_snapshot_t *s2 = ecs_snapshot_take_incremental(world, s1);
+    ecs_snapshot_t *s3 = ecs_snapshot_take_incremental(world, s2);
+    ecs_snapshot_free(s2);
+
+    ecs_set(world, e, Position, {30, 40});
+
+    ecs_snapshot_restore(world, s3);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_set(world, e, Position, {50, 60});
+
+    ecs_snapshot_restore(world, s1);
+
+    p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_incremental_after_new() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s1 = ecs_snapshot_take(world);
+
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+
+    ecs_snapshot_t *s2 = ecs_snapshot_take_incremental(world, s1);
+
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {50, 60});
+
+    ecs_snapshot_restore(world, s2);
+
+    test_assert(ecs_is_alive(world, e1));
+    test_assert(ecs_is_alive(world, e2));
+    test_assert(!ecs_is_alive(world, e3));
+
+    const Position *p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_snapshot_restore(world, s1);
+
+    test_assert(ecs_is_alive(world, e1));
+    test_assert(!ecs_is_alive(world, e2));
+    test_assert(!ecs_is_alive(world, e3));
+
+    p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_incremental_restore_unchanged() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take_incremental(world, NULL);
+
+    /* Change is not communicated to the world, so table is not restored */
+    Position *p = ecs_get_mut(world, e, Position, NULL);
+    p->x = 30;
+    p->y = 40;
+
+    ecs_snapshot_restore(world, s);
+
+    const Position *ptr = ecs_get(world, e, Position);
+    test_assert(ptr != NULL);
+    test_int(ptr->x, 30);
+    test_int(ptr->y, 40);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_no_changes() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, 0, Position, {30, 40});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    test_assert(d != NULL);
+    test_int(ecs_vector_count(d->deleted), 0);
+    test_int(ecs_vector_count(d->created), 0);
+    test_int(ecs_vector_count(d->moved), 0);
+    test_int(ecs_vector_count(d->changed), 0);
+
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    test_assert(blob != NULL);
+    test_int(ecs_snapshot_diff_apply(world, blob, size), 0);
+
+    ecs_os_free(blob);
+    ecs_snapshot_diff_free(d);
+    ecs_snapshot_free(s);
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_changed_value() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {50, 60});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_set(world, e2, Position, {70, 80});
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    test_int(ecs_vector_count(d->deleted), 0);
+    test_int(ecs_vector_count(d->created), 0);
+    test_int(ecs_vector_count(d->moved), 0);
+    test_int(ecs_vector_count(d->changed), 1);
+
+    ecs_snapshot_diff_range_t *r = ecs_vector_first(
+        d->changed, ecs_snapshot_diff_range_t);
+    test_int(r->component, ecs_id(Position));
+    test_int(r->size, sizeof(Position));
+    test_int(r->count, 1);
+    test_bool(r->is_set, false);
+    test_int(r->entities[0], e2);
+
+    /* Delta is the new value XOR'd with the previous value */
+    Position prev = {30, 40}, cur = {70, 80};
+    uint8_t *delta = r->delta, *p_prev = (uint8_t*)&prev, *p_cur = (uint8_t*)&cur;
+    size_t i;
+    for (i = 0; i < sizeof(Position); i ++) {
+        test_int(delta[i], p_prev[i] ^ p_cur[i]);
+    }
+
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    ecs_snapshot_diff_free(d);
+
+    ecs_snapshot_restore(world, s);
+
+    const Position *p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    test_int(ecs_snapshot_diff_apply(world, blob, size), 0);
+    ecs_os_free(blob);
+
+    p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 70);
+    test_int(p->y, 80);
+
+    p = ecs_get(world, e3, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 50);
+    test_int(p->y, 60);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_changed_range() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e[6];
+    int i;
+    for (i = 0; i < 6; i ++) {
+        e[i] = ecs_set(world, 0, Position, {i, i});
+    }
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_set(world, e[1], Position, {10, 10});
+    ecs_set(world, e[2], Position, {20, 20});
+    ecs_set(world, e[4], Position, {40, 40});
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    test_int(ecs_vector_count(d->changed), 2);
+
+    ecs_snapshot_diff_range_t *r = ecs_vector_first(
+        d->changed, ecs_snapshot_diff_range_t);
+    test_int(r[0].count, 2);
+    test_int(r[0].entities[0], e[1]);
+    test_int(r[0].entities[1], e[2]);
+    test_int(r[1].count, 1);
+    test_int(r[1].entities[0], e[4]);
+
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    ecs_snapshot_diff_free(d);
+
+    ecs_snapshot_restore(world, s);
+    test_int(ecs_snapshot_diff_apply(world, blob, size), 0);
+    ecs_os_free(blob);
+
+    for (i = 0; i < 6; i ++) {
+        const Position *p = ecs_get(world, e[i], Position);
+        test_assert(p != NULL);
+        if (i == 1 || i == 2 || i == 4) {
+            test_int(p->x, i * 10);
+            test_int(p->y, i * 10);
+        } else {
+            test_int(p->x, i);
+            test_int(p->y, i);
+        }
+    }
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_created() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {30, 40});
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    test_int(ecs_vector_count(d->deleted), 0);
+    test_int(ecs_vector_count(d->created), 1);
+    test_int(ecs_vector_count(d->moved), 0);
+    test_int(ecs_vector_count(d->changed), 1);
+
+    ecs_snapshot_diff_entity_t *c = ecs_vector_first(
+        d->created, ecs_snapshot_diff_entity_t);
+    test_int(c->entity, e);
+    test_assert(c->type == ecs_get_type(world, e));
+
+    ecs_snapshot_diff_range_t *r = ecs_vector_first(
+        d->changed, ecs_snapshot_diff_range_t);
+    test_int(r->count, 1);
+    test_bool(r->is_set, true);
+    test_int(r->entities[0], e);
+    test_int(((Position*)r->delta)->x, 30);
+    test_int(((Position*)r->delta)->y, 40);
+
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    ecs_snapshot_diff_free(d);
+
+    ecs_snapshot_restore(world, s);
+    test_assert(!ecs_is_alive(world, e));
+
+    test_int(ecs_snapshot_diff_apply(world, blob, size), 0);
+    ecs_os_free(blob);
+
+    test_assert(ecs_is_alive(world, e));
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    test_assert(ecs_new(world, 0) != e);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_deleted() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_delete(world, e1);
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    test_int(ecs_vector_count(d->deleted), 1);
+    test_int(ecs_vector_count(d->created), 0);
+    test_int(ecs_vector_count(d->moved), 0);
+    test_int(ecs_vector_count(d->changed), 0);
+    test_int(*ecs_vector_first(d->deleted, ecs_entity_t), e1);
+
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    ecs_snapshot_diff_free(d);
+
+    ecs_snapshot_restore(world, s);
+    test_assert(ecs_is_alive(world, e1));
+
+    test_int(ecs_snapshot_diff_apply(world, blob, size), 0);
+    ecs_os_free(blob);
+
+    test_assert(!ecs_is_alive(world, e1));
+    test_assert(ecs_is_alive(world, e2));
+
+    const Position *p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_moved() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    test_int(ecs_vector_count(d->deleted), 0);
+    test_int(ecs_vector_count(d->created), 0);
+    test_int(ecs_vector_count(d->moved), 1);
+
+    ecs_snapshot_diff_entity_t *m = ecs_vector_first(
+        d->moved, ecs_snapshot_diff_entity_t);
+    test_int(m->entity, e);
+    test_assert(m->type == ecs_get_type(world, e));
+
+    /* Position did not change, so only Velocity is in the diff */
+    test_int(ecs_vector_count(d->changed), 1);
+    ecs_snapshot_diff_range_t *r = ecs_vector_first(
+        d->changed, ecs_snapshot_diff_range_t);
+    test_int(r->component, ecs_id(Velocity));
+    test_int(r->count, 1);
+    test_bool(r->is_set, true);
+    test_int(r->entities[0], e);
+
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    ecs_snapshot_diff_free(d);
+
+    ecs_snapshot_restore(world, s);
+    test_assert(!ecs_has(world, e, Velocity));
+
+    test_int(ecs_snapshot_diff_apply(world, blob, size), 0);
+    ecs_os_free(blob);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    const Velocity *v = ecs_get(world, e, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_moved_remove() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_remove(world, e, Velocity);
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    test_int(ecs_vector_count(d->moved), 1);
+    test_int(ecs_vector_count(d->changed), 0);
+
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    ecs_snapshot_diff_free(d);
+
+    ecs_snapshot_restore(world, s);
+    test_assert(ecs_has(world, e, Velocity));
+
+    test_int(ecs_snapshot_diff_apply(world, blob, size), 0);
+    ecs_os_free(blob);
+
+    test_assert(ecs_has(world, e, Position));
+    test_assert(!ecs_has(world, e, Velocity));
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_two_snapshots() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+
+    ecs_snapshot_t *s1 = ecs_snapshot_take(world);
+
+    ecs_set(world, e1, Position, {50, 60});
+
+    ecs_snapshot_t *s2 = ecs_snapshot_take(world);
+
+    ecs_set(world, e2, Position, {70, 80});
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s1, s2);
+    test_int(ecs_vector_count(d->changed), 1);
+
+    ecs_snapshot_diff_range_t *r = ecs_vector_first(
+        d->changed, ecs_snapshot_diff_range_t);
+    test_int(r->count, 1);
+    test_int(r->entities[0], e1);
+
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    ecs_snapshot_diff_free(d);
+    ecs_snapshot_free(s2);
+
+    ecs_snapshot_restore(world, s1);
+    test_int(ecs_snapshot_diff_apply(world, blob, size), 0);
+    ecs_os_free(blob);
+
+    const Position *p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 50);
+    test_int(p->y, 60);
+
+    p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_incremental() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e1, Velocity, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_set(world, e2, Velocity, {3, 4});
+
+    ecs_snapshot_t *s1 = ecs_snapshot_take_incremental(world, NULL);
+
+    ecs_set(world, e2, Position, {50, 60});
+
+    ecs_snapshot_t *s2 = ecs_snapshot_take_incremental(world, s1);
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s1, s2);
+    test_int(ecs_vector_count(d->deleted), 0);
+    test_int(ecs_vector_count(d->created), 0);
+    test_int(ecs_vector_count(d->moved), 0);
+    test_int(ecs_vector_count(d->changed), 1);
+
+    ecs_snapshot_diff_range_t *r = ecs_vector_first(
+        d->changed, ecs_snapshot_diff_range_t);
+    test_int(r->component, ecs_id(Position));
+    test_int(r->count, 1);
+    test_int(r->entities[0], e2);
+
+    ecs_snapshot_diff_free(d);
+    ecs_snapshot_free(s1);
+    ecs_snapshot_free(s2);
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_apply_other_world() {
+    ecs_world_t *world = ecs_init();
+    ecs_world_t *replica = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    test_int(ecs_component_init(replica, &(ecs_component_desc_t){
+        .entity.name = "Position",
+        .size = sizeof(Position),
+        .alignment = ECS_ALIGNOF(Position)
+    }), ecs_id(Position));
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    test_int(ecs_set(replica, 0, Position, {10, 20}), e1);
+    test_int(ecs_set(replica, 0, Position, {30, 40}), e2);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_set(world, e1, Position, {50, 60});
+    ecs_delete(world, e2);
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {70, 80});
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    ecs_snapshot_diff_free(d);
+    ecs_snapshot_free(s);
+
+    test_int(ecs_snapshot_diff_apply(replica, blob, size), 0);
+    ecs_os_free(blob);
+
+    const Position *p = ecs_get(replica, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 50);
+    test_int(p->y, 60);
+
+    test_assert(!ecs_is_alive(replica, e2));
+
+    test_assert(ecs_is_alive(replica, e3));
+    p = ecs_get(replica, e3, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 70);
+    test_int(p->y, 80);
+
+    ecs_fini(world);
+    ecs_fini(replica);
+}
+
+void Snapshot_snapshot_diff_apply_malformed() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_set(world, e, Position, {30, 40});
+    ecs_entity_t e2 = ecs_new(world, Position);
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    ecs_size_t size;
+    uint8_t *blob = ecs_snapshot_diff_encode(d, &size);
+    ecs_snapshot_diff_free(d);
+    
+    ecs_snapshot_restore(world, s);
+
+    /* Truncated diff */
+    test_assert(ecs_snapshot_diff_apply(world, blob, size - 1) != 0);
+    test_assert(!ecs_is_alive(world, e2));
+
+    /* Diff with trailing data */
+    uint8_t *long_blob = ecs_os_malloc(size + 1);
+    ecs_os_memcpy(long_blob, blob, size);
+    long_blob[size] = 0;
+    test_assert(ecs_snapshot_diff_apply(world, long_blob, size + 1) != 0);
+    test_assert(!ecs_is_alive(world, e2));
+    ecs_os_free(long_blob);
+
+    /* Data that is not a diff */
+    blob[0] ++;
+    test_assert(ecs_snapshot_diff_apply(world, blob, size) != 0);
+    test_assert(!ecs_is_alive(world, e2));
+    ecs_os_free(blob);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_snapshot_diff_encode_size() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = 0;
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        ecs_entity_t ent = ecs_set(world, 0, Position, {i, i});
+        if (i == 500) {
+            e = ent;
+        }
+    }
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    Position *p = ecs_get_mut(world, e, Position, NULL);
+    p->x ++;
+    ecs_modified(world, e, Position);
+
+    ecs_snapshot_diff_t *d = ecs_snapshot_diff(s, NULL);
+    ecs_size_t size;
+    void *blob = ecs_snapshot_diff_encode(d, &size);
+    test_assert(size < 32);
+
+    ecs_os_free(blob);
+    ecs_snapshot_diff_free(d);
+    ecs_snapshot_free(s);
+    ecs_fini(world);
+}
@@ -71,10 +71,10 @@ void Sorting_sort_by_component_same_value_1() {
     
 
     test_assert(it.entities[0] == e5);
-    test_assert(it.entities[1] == e4);
-    test_assert(it.entities[2] == e3);
-    test_assert(it.entities[3] == e2);
-    test_assert(it.entities[4] == e1);
+    test_assert(it.entities[1] == e3);
+    test_assert(it.entities[2] == e4);
+    test_assert(it.entities[3] == e1);
+    test_assert(it.entities[4] == e2);
 
     test_assert(!ecs_query_next(&it));
 
@@ -101,12 +101,12 @@ void Sorting_sort_by_component_same_value_2() {
     test_assert(ecs_query_next(&it));
 
     test_int(it.count, 6);
-    test_assert(it.entities[0] == e4);
-    test_assert(it.entities[1] == e6);
-    test_assert(it.entities[2] == e2);
-    test_assert(it.entities[3] == e1);
-    test_assert(it.entities[4] == e3);
-    test_assert(it.entities[5] == e5);
+    test_assert(it.entities[0] == e2);
+    test_assert(it.entities[1] == e4);
+    test_assert(it.entities[2] == e6);
+    test_assert(it.entities[3] == e5);
+    test_assert(it.entities[4] == e1);
+    test_assert(it.entities[5] == e3);
 
     test_assert(!ecs_query_next(&it));
 
@@ -1489,3 +1489,118 @@ void Sorting_sort_relation_marked() {
 
     ecs_fini(world);
 }
+
+void Sorting_sort_after_add_to_sorted_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    ecs_query_order_by(world, q, ecs_typeid(Position), compare_position);
+
+    for (int i = 0; i < 1000; i ++) {
+        ecs_set(world, 0, Position, {rand()});
+    }
+
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) { }
+
+    /* Append a few entities to the sorted table */
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {-1});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {1000});
+    ecs_set(world, 0, Position, {rand()});
+
+    int32_t count = 0, x = -1;
+    it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        Position *p = ecs_term(&it, Position, 1);
+
+        int32_t j;
+        for (j = 0; j < it.count; j ++) {
+            test_assert(x <= p[j].x);
+            x = p[j].x;
+        }
+
+        count += it.count;
+    }
+
+    test_int(count, 1003);
+    test_int(ecs_get(world, e1, Position)->x, -1);
+    test_int(ecs_get(world, e2, Position)->x, 1000);
+
+    ecs_fini(world);
+}
+
+void Sorting_sort_after_modify_sorted_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    ecs_query_order_by(world, q, ecs_typeid(Position), compare_position);
+
+    ecs_entity_t e = 0;
+    for (int i = 0; i < 1000; i ++) {
+        e = ecs_set(world, 0, Position, {i});
+    }
+
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) { }
+
+    /* Move the last entity to the front */
+    ecs_set(world, e, Position, {-1});
+
+    it = ecs_query_iter(q);
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1000);
+    test_assert(it.entities[0] == e);
+
+    Position *p = ecs_term(&it, Position, 1);
+    test_int(p[0].x, -1);
+
+    int32_t j;
+    for (j = 1; j < it.count; j ++) {
+        test_int(p[j].x, j - 1);
+    }
+
+    test_assert(!ecs_query_next(&it));
+
+    ecs_fini(world);
+}
+
+void Sorting_sort_1000_entities_16_types() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    ecs_query_order_by(world, q, ecs_typeid(Position), compare_position);
+
+    ecs_entity_t tags[16];
+    for (int i = 0; i < 16; i ++) {
+        tags[i] = ecs_new_id(world);
+    }
+
+    for (int i = 0; i < 1000; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {rand()});
+        ecs_add_id(world, e, tags[i % 16]);
+    }
+
+    int32_t count = 0, x = 0;
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        Position *p = ecs_term(&it, Position, 1);
+
+        int32_t j;
+        for (j = 0; j < it.count; j ++) {
+            test_assert(x <= p[j].x);
+            x = p[j].x;
+        }
+
+        count += it.count;
+    }
+
+    test_int(count, 1000);
+
+    ecs_fini(world);
+}
@@ -309,8 +309,8 @@ void Switch_query_1_case_1_type() {
     test_int(ctx.column_count, 1);
     test_null(ctx.param);
 
-    test_int(ctx.e[0], e3);
-    test_int(ctx.e[1], e1);
+    test_int(ctx.e[0], e1);
+    test_int(ctx.e[1], e3);
     test_int(ctx.c[0][0], ECS_CASE | Running);
     test_int(ctx.s[0][0], 0);
 
@@ -348,10 +348,10 @@ void Switch_query_1_case_2_types() {
     test_int(ctx.column_count, 1);
     test_null(ctx.param);
 
-    test_int(ctx.e[0], e3);
-    test_int(ctx.e[1], e1);
-    test_int(ctx.e[2], e7);
-    test_int(ctx.e[3], e5);    
+    test_int(ctx.e[0], e1);
+    test_int(ctx.e[1], e3);
+    test_int(ctx.e[2], e5);
+    test_int(ctx.e[3], e7);
     test_int(ctx.c[0][0], ECS_CASE | Running);
     test_int(ctx.s[0][0], 0);
 
@@ -401,8 +401,8 @@ void Switch_query_2_cases_1_type() {
     test_int(ctx.column_count, 2);
     test_null(ctx.param);
 
-    test_int(ctx.e[0], e4);
-    test_int(ctx.e[1], e1);
+    test_int(ctx.e[0], e1);
+    test_int(ctx.e[1], e4);
     test_int(ctx.c[0][0], ECS_CASE | Running);
     test_int(ctx.c[0][1], ECS_CASE | Front);
     test_int(ctx.s[0][0], 0);
@@ -467,8 +467,8 @@ void Switch_query_2_cases_2_types() {
     test_int(ctx.column_count, 2);
     test_null(ctx.param);
 
-    test_int(ctx.e[0], e4);
-    test_int(ctx.e[1], e1);
+    test_int(ctx.e[0], e1);
+    test_int(ctx.e[1], e4);
     test_int(ctx.e[2], e7);
     test_int(ctx.c[0][0], ECS_CASE | Running);
     test_int(ctx.c[0][1], ECS_CASE | Front);
@@ -497,28 +497,25 @@ void Switch_query_after_remove() {
     ecs_query_t *q_running = ecs_query_new(world, "CASE | Running");
     ecs_query_t *q_jumping = ecs_query_new(world, "CASE | Jumping");
 
-    /* Verify all queries are correctly matched */
+    /* Verify all queries are correctly matched. Entities with the same case
+     * are stored next to each other, so are returned in a single result. */
     ecs_iter_t it = ecs_query_iter(q_walking);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e2);
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e1);
+    test_int(it.count, 2);
+    test_int(it.entities[0], e1); test_int(it.entities[1], e2);
     test_assert(!ecs_query_next(&it));
 
     it = ecs_query_iter(q_running);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e5);
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e4);
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e3);    
+    test_int(it.count, 3);
+    test_int(it.entities[0], e3); test_int(it.entities[1], e4);
+    test_int(it.entities[2], e5);
     test_assert(!ecs_query_next(&it));
 
     it = ecs_query_iter(q_jumping);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e7);
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e6);
+    test_int(it.count, 2);
+    test_int(it.entities[0], e6); test_int(it.entities[1], e7);
     test_assert(!ecs_query_next(&it));
 
     ecs_remove_id(world, e4, ECS_CASE | Running);
@@ -529,24 +526,22 @@ void Switch_query_after_remove() {
     /* Verify queries are still correctly matched, now excluding e4 */
     it = ecs_query_iter(q_walking);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e2);
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e1);
+    test_int(it.count, 2);
+    test_int(it.entities[0], e1); test_int(it.entities[1], e2);
     test_assert(!ecs_query_next(&it));
 
     it = ecs_query_iter(q_running);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e5);
+    test_int(it.count, 1); test_int(it.entities[0], e3);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e3);    
+    test_int(it.count, 1); test_int(it.entities[0], e5);
     test_assert(!ecs_query_next(&it));
 
     it = ecs_query_iter(q_jumping);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e7);
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e6);
-    test_assert(!ecs_query_next(&it));    
+    test_int(it.count, 2);
+    test_int(it.entities[0], e6); test_int(it.entities[1], e7);
+    test_assert(!ecs_query_next(&it));
 
     ecs_add_id(world, e4, ECS_CASE | Running);
     test_assert(ecs_has_entity(world, e4, ECS_CASE | Running));
@@ -556,25 +551,21 @@ void Switch_query_after_remove() {
     /* Verify e4 is now matched again */
     it = ecs_query_iter(q_walking);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e2);
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e1);
+    test_int(it.count, 2);
+    test_int(it.entities[0], e1); test_int(it.entities[1], e2);
     test_assert(!ecs_query_next(&it));
 
     it = ecs_query_iter(q_running);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e4);      
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e5);
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e3);      
+    test_int(it.count, 3);
+    test_int(it.entities[0], e3); test_int(it.entities[1], e4);
+    test_int(it.entities[2], e5);
     test_assert(!ecs_query_next(&it));
 
     it = ecs_query_iter(q_jumping);
     test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e7);
-    test_assert(ecs_query_next(&it));
-    test_int(it.count, 1); test_int(it.entities[0], e6);
+    test_int(it.count, 2);
+    test_int(it.entities[0], e6); test_int(it.entities[1], e7);
     test_assert(!ecs_query_next(&it));
 
     ecs_fini(world);
@@ -973,3 +964,81 @@ void Switch_query_recycled_tags() {
 
     ecs_fini(world);
 }
+
+void Switch_query_case_runs() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Walking);
+    ECS_TAG(world, Running);
+    ECS_TYPE(world, Movement, Walking, Running);
+
+    /* Alternating runs of 10 walking and 10 running entities */
+    int32_t i;
+    for (i = 0; i < 100; i ++) {
+        ecs_entity_t e = ecs_new_w_id(world, ECS_SWITCH | Movement);
+        if ((i / 10) % 2) {
+            ecs_add_id(world, e, ECS_CASE | Running);
+        } else {
+            ecs_add_id(world, e, ECS_CASE | Walking);
+        }
+    }
+
+    ecs_query_t *q = ecs_query_new(world, "CASE | Running");
+    ecs_iter_t it = ecs_query_iter(q);
+
+    int32_t runs = 0;
+    while (ecs_query_next(&it)) {
+        test_int(it.offset, runs * 20 + 10);
+        test_int(it.count, 10);
+        for (i = 0; i < it.count; i ++) {
+            test_int(ecs_get_case(world, it.entities[i], Movement), Running);
+        }
+        runs ++;
+    }
+
+    test_int(runs, 5);
+
+    ecs_fini(world);
+}
+
+void Switch_query_rare_case_after_remove() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Walking);
+    ECS_TAG(world, Running);
+    ECS_TYPE(world, Movement, Walking, Running);
+
+    /* Case is rare enough to be iterated one entity at a time */
+    ecs_entity_t running[3];
+    int32_t i;
+    for (i = 0; i < 200; i ++) {
+        ecs_entity_t e = ecs_new_w_id(world, ECS_SWITCH | Movement);
+        if (!(i % 50) && i < 150) {
+            ecs_add_id(world, e, ECS_CASE | Running);
+            running[i / 50] = e;
+        } else {
+            ecs_add_id(world, e, ECS_CASE | Walking);
+        }
+    }
+
+    ecs_remove_id(world, running[1], ECS_CASE | Running);
+
+    ecs_query_t *q = ecs_query_new(world, "CASE | Running");
+    ecs_iter_t it = ecs_query_iter(q);
+
+    int32_t count = 0;
+    bool found_0 = false, found_2 = false;
+    while (ecs_query_next(&it)) {
+        test_int(it.count, 1);
+        found_0 |= it.entities[0] == running[0];
+        found_2 |= it.entities[0] == running[2];
+        test_assert(it.entities[0] != running[1]);
+        count ++;
+    }
+
+    test_int(count, 2);
+    test_assert(found_0);
+    test_assert(found_2);
+
+    ecs_fini(world);
+}
@@ -611,3 +611,305 @@ void Timer_naked_tick_entity() {
 
     ecs_fini(world);
 }
+
+void Timer_wheel_timeout() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_enable_timer_wheel(world, 0);
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, SystemA, EcsOnUpdate, Position);
+
+    ecs_new(world, Position);
+
+    ecs_entity_t timer = ecs_set_timeout(world, SystemA, 3.0);
+    test_assert(timer != 0);
+    test_assert(timer == SystemA);
+
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, true);
+
+    system_a_invoked = false;
+
+    /* Make sure this was a one-shot timer */
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);    
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_interval() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_enable_timer_wheel(world, 0);
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, SystemA, EcsOnUpdate, Position);
+
+    ecs_new(world, Position);
+
+    ecs_entity_t timer = ecs_set_interval(world, SystemA, 3.0);
+    test_assert(timer != 0);
+    test_assert(timer == SystemA);
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        test_bool(system_a_invoked, false);
+        ecs_progress(world, 1.0);
+        test_bool(system_a_invoked, false);
+        ecs_progress(world, 1.0);
+        test_bool(system_a_invoked, false);
+        ecs_progress(world, 1.0);
+        test_bool(system_a_invoked, true);
+        system_a_invoked = false;
+    }
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_start_stop_interval() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_enable_timer_wheel(world, 0);
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, SystemA, EcsOnUpdate, Position);
+
+    ecs_new(world, Position);
+
+    ecs_entity_t timer = ecs_set_interval(world, SystemA, 3.0);
+    test_assert(timer != 0);
+
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+
+    /* Stop timer */
+    ecs_stop_timer(world, timer);
+
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+
+    /* Start timer, this should reset timer */
+    ecs_start_timer(world, timer);
+
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);    
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, true);
+
+    system_a_invoked = false;
+
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, true);
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_rate_filter_w_timer_src() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_enable_timer_wheel(world, 0);
+
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, SystemC, EcsOnUpdate, Position);
+    ECS_ENTITY(world, E1, Position);
+
+    ecs_entity_t timer = ecs_set_interval(world, 0, 2.0);
+    test_assert(timer != 0);
+
+    ecs_entity_t filter = ecs_set_rate(world, SystemC, 3, timer);
+    test_assert(filter != 0);
+    test_assert(filter == SystemC);
+
+    int i, j;
+    for (j = 0; j < 2; j ++) {
+        for (i = 0; i < 5; i ++) {
+            ecs_progress(world, 1.0);
+            test_bool(system_c_invoked, false);
+        }
+
+        ecs_progress(world, 1.0);
+        test_bool(system_c_invoked, true);
+        system_c_invoked = false;
+    }
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_tick_entity() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_enable_timer_wheel(world, 0);
+
+    ecs_entity_t timer = ecs_set_interval(world, 0, 1.0);
+
+    int i;
+    for (i = 0; i < 16; i ++) {
+        ecs_progress(world, 0.25);
+        const EcsTickSource *src = ecs_get(world, timer, EcsTickSource);
+        test_assert(src != NULL);
+        test_bool(src->tick, (i % 4) == 3);
+        if (src->tick) {
+            test_flt(src->time_elapsed, 1.0);
+        }
+    }
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_long_timeout() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_enable_timer_wheel(world, 0.001);
+
+    /* 100 seconds is 100k ticks, which is stored in the third level */
+    ecs_entity_t timer = ecs_set_interval(world, 0, 100.0);
+
+    int i;
+    for (i = 0; i < 300; i ++) {
+        ecs_progress(world, 1.0);
+        const EcsTickSource *src = ecs_get(world, timer, EcsTickSource);
+        test_assert(src != NULL);
+        test_bool(src->tick, (i % 100) == 99);
+    }
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_overflow() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_enable_timer_wheel(world, 0.001);
+
+    /* 20000 seconds does not fit in the wheel at this resolution */
+    ecs_entity_t timer = ecs_set_timeout(world, 0, 20000.0);
+
+    int i;
+    for (i = 0; i < 30; i ++) {
+        ecs_progress(world, 1000.0);
+        const EcsTickSource *src = ecs_get(world, timer, EcsTickSource);
+        test_assert(src != NULL);
+        test_bool(src->tick, i == 19);
+    }
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_existing_timers() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t t1 = ecs_set_interval(world, 0, 1.0);
+    ecs_entity_t t2 = ecs_set_timeout(world, 0, 3.0);
+
+    ecs_progress(world, 1.0);
+    test_bool(ecs_get(world, t1, EcsTickSource)->tick, true);
+    test_bool(ecs_get(world, t2, EcsTickSource)->tick, false);
+
+    ecs_progress(world, 1.0);
+
+    ecs_enable_timer_wheel(world, 0);
+
+    ecs_progress(world, 0.5);
+    test_bool(ecs_get(world, t1, EcsTickSource)->tick, false);
+    test_bool(ecs_get(world, t2, EcsTickSource)->tick, false);
+
+    ecs_progress(world, 0.5);
+    test_bool(ecs_get(world, t1, EcsTickSource)->tick, true);
+    test_bool(ecs_get(world, t2, EcsTickSource)->tick, true);
+
+    ecs_progress(world, 1.0);
+    test_bool(ecs_get(world, t1, EcsTickSource)->tick, true);
+    test_bool(ecs_get(world, t2, EcsTickSource)->tick, false);
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_delete_timer() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_enable_timer_wheel(world, 0);
+
+    ecs_entity_t t1 = ecs_set_interval(world, 0, 1.0);
+    ecs_entity_t t2 = ecs_set_interval(world, 0, 1.0);
+
+    ecs_progress(world, 1.0);
+    test_bool(ecs_get(world, t1, EcsTickSource)->tick, true);
+
+    ecs_delete(world, t1);
+    ecs_delete(world, t2);
+
+    ecs_progress(world, 1.0);
+    ecs_progress(world, 1.0);
+
+    /* Recycled id with a new timer must not inherit the old schedule */
+    ecs_entity_t t3 = ecs_set_interval(world, 0, 2.0);
+    ecs_progress(world, 1.0);
+    test_bool(ecs_get(world, t3, EcsTickSource)->tick, false);
+    ecs_progress(world, 1.0);
+    test_bool(ecs_get(world, t3, EcsTickSource)->tick, true);
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_same_as_timers() {
+    ecs_world_t *world = ecs_init();
+    ecs_world_t *world_w = ecs_init();
+
+    ecs_enable_timer_wheel(world_w, 0.01);
+
+    ecs_entity_t timers[256], timers_w[256];
+
+    int i, j;
+    for (i = 0; i < 256; i ++) {
+        FLECS_FLOAT timeout = (FLECS_FLOAT)((i % 37) + 1) * (FLECS_FLOAT)0.125;
+        if (i % 3) {
+            timers[i] = ecs_set_interval(world, 0, timeout);
+            timers_w[i] = ecs_set_interval(world_w, 0, timeout);
+        } else {
+            timers[i] = ecs_set_timeout(world, 0, timeout);
+            timers_w[i] = ecs_set_timeout(world_w, 0, timeout);
+        }
+    }
+
+    for (j = 0; j < 200; j ++) {
+        FLECS_FLOAT delta_time = (FLECS_FLOAT)((j % 5) + 1) * (FLECS_FLOAT)0.0625;
+        ecs_progress(world, delta_time);
+        ecs_progress(world_w, delta_time);
+
+        for (i = 0; i < 256; i ++) {
+            const EcsTickSource *src = ecs_get(world, timers[i], EcsTickSource);
+            const EcsTickSource *src_w = ecs_get(
+                world_w, timers_w[i], EcsTickSource);
+            test_bool(src->tick, src_w->tick);
+            if (src->tick) {
+                test_flt(src->time_elapsed, src_w->time_elapsed);
+            }
+        }
+    }
+
+    ecs_fini(world);
+    ecs_fini(world_w);
+}
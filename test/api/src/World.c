@@ -1036,3 +1036,297 @@ void World_system_time_scale() {
 
     ecs_fini(world);
 }
+
+void World_stats_table_edge_memory() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_add(world, e, Velocity);
+
+    ecs_world_stats_t s = {0};
+    ecs_get_world_stats(world, &s);
+
+    float memory = s.table_edge_memory.avg[s.t];
+    test_assert(memory > 0);
+
+    ecs_fini(world);
+}
+
+static
+int32_t world_table_count(
+    ecs_world_t *world)
+{
+    ecs_world_stats_t s = {0};
+    ecs_get_world_stats(world, &s);
+    return (int32_t)s.table_count.avg[s.t];
+}
+
+void World_delete_empty_tables() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+
+    /* Delete empty tables created by the world */
+    ecs_delete_empty_tables(world, 0);
+    int32_t table_count = world_table_count(world);
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_add(world, e, TagA);
+    ecs_add(world, e, TagB);
+    test_int(world_table_count(world), table_count + 3);
+
+    /* Intermediate tables [Position] and [Position, TagA] are empty */
+    test_int(ecs_delete_empty_tables(world, 0), 2);
+    test_int(world_table_count(world), table_count + 1);
+    test_assert(ecs_has(world, e, Position));
+    test_assert(ecs_has(world, e, TagA));
+    test_assert(ecs_has(world, e, TagB));
+
+    ecs_delete(world, e);
+    test_int(ecs_delete_empty_tables(world, 0), 1);
+    test_int(world_table_count(world), table_count);
+    test_int(ecs_delete_empty_tables(world, 0), 0);
+
+    ecs_fini(world);
+}
+
+void World_delete_empty_tables_after_frames() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+
+    ecs_delete_empty_tables(world, 0);
+
+    ecs_entity_t e = ecs_new_w_id(world, TagA);
+    ecs_add(world, e, TagB);
+    ecs_remove(world, e, TagB);
+
+    test_int(ecs_delete_empty_tables(world, 2), 0);
+    test_int(ecs_delete_empty_tables(world, 2), 0);
+
+    /* Table becomes non-empty, which resets the empty count */
+    ecs_add(world, e, TagB);
+    test_int(ecs_delete_empty_tables(world, 2), 0);
+    ecs_remove(world, e, TagB);
+
+    test_int(ecs_delete_empty_tables(world, 2), 0);
+    test_int(ecs_delete_empty_tables(world, 2), 0);
+    test_int(ecs_delete_empty_tables(world, 2), 1);
+
+    test_assert(ecs_has(world, e, TagA));
+    test_assert(!ecs_has(world, e, TagB));
+
+    ecs_fini(world);
+}
+
+void World_table_gc_progress() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+
+    ecs_delete_empty_tables(world, 0);
+    int32_t table_count = world_table_count(world);
+
+    ecs_set_table_gc(world, 1);
+
+    ecs_entity_t e = ecs_new_w_id(world, TagA);
+    ecs_add(world, e, TagB);
+    ecs_delete(world, e);
+    test_int(world_table_count(world), table_count + 2);
+
+    ecs_progress(world, 1);
+    test_int(world_table_count(world), table_count + 2);
+
+    ecs_progress(world, 1);
+    test_int(world_table_count(world), table_count);
+
+    /* Disable table GC */
+    ecs_set_table_gc(world, 0);
+
+    e = ecs_new_w_id(world, TagA);
+    ecs_delete(world, e);
+
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+    test_int(world_table_count(world), table_count + 1);
+
+    ecs_fini(world);
+}
+
+void World_delete_empty_tables_recreate() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TAG(world, Tag);
+
+    ecs_query_t *q = ecs_query_new(world, "Position, Velocity");
+
+    int32_t i;
+    for (i = 0; i < 3; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i});
+        ecs_set(world, e, Velocity, {i, i});
+        ecs_add(world, e, Tag);
+        ecs_remove(world, e, Velocity);
+        ecs_add(world, e, Velocity);
+
+        test_assert(ecs_has(world, e, Position));
+        test_assert(ecs_has(world, e, Velocity));
+        test_assert(ecs_has(world, e, Tag));
+
+        int32_t count = 0;
+        ecs_iter_t it = ecs_query_iter(q);
+        while (ecs_query_next(&it)) {
+            Position *p = ecs_term(&it, Position, 1);
+            test_int(it.count, 1);
+            test_int(it.entities[0], e);
+            test_int(p->x, i);
+            count ++;
+        }
+        test_int(count, 1);
+
+        ecs_delete(world, e);
+        test_assert(ecs_delete_empty_tables(world, 0) != 0);
+
+        it = ecs_query_iter(q);
+        test_assert(!ecs_query_next(&it));
+    }
+
+    ecs_fini(world);
+}
+
+void World_delete_empty_tables_switch() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Walking);
+    ECS_TAG(world, Running);
+    ECS_TYPE(world, Movement, Walking, Running);
+    ECS_TAG(world, Tag);
+
+    int32_t i;
+    for (i = 0; i < 3; i ++) {
+        ecs_entity_t e = ecs_new_w_id(world, ECS_SWITCH | Movement);
+        ecs_add_id(world, e, ECS_CASE | Walking);
+        ecs_add(world, e, Tag);
+        ecs_add_id(world, e, ECS_CASE | Running);
+        ecs_remove(world, e, Tag);
+
+        test_assert(ecs_has_id(world, e, ECS_CASE | Running));
+        test_assert(!ecs_has_id(world, e, ECS_CASE | Walking));
+        test_assert(!ecs_has(world, e, Tag));
+
+        ecs_delete(world, e);
+        ecs_delete_empty_tables(world, 0);
+    }
+
+    ecs_fini(world);
+}
+
+void World_delete_empty_tables_pinned_type() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TYPE(world, MyType, Position, Velocity);
+
+    ecs_type_t type = ecs_type_from_str(world, "Position, Velocity");
+    test_assert(type != NULL);
+
+    ecs_delete_empty_tables(world, 0);
+
+    ecs_entity_t e = ecs_new(world, MyType);
+    test_assert(ecs_has(world, e, Position));
+    test_assert(ecs_has(world, e, Velocity));
+    test_assert(ecs_get_type(world, e) == type);
+
+    e = ecs_new(world, Position);
+    test_assert(ecs_has(world, e, Position));
+    test_assert(!ecs_has(world, e, Velocity));
+
+    ecs_fini(world);
+}
+
+void World_delete_empty_tables_w_snapshot() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_delete_empty_tables(world, 0);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_add(world, e, Tag);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_delete(world, e);
+
+    /* Tables are not deleted while a snapshot is alive */
+    test_int(ecs_delete_empty_tables(world, 0), 0);
+
+    ecs_snapshot_restore(world, s);
+    test_assert(ecs_has(world, e, Tag));
+
+    const Position *p = ecs_get(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_delete(world, e);
+    test_int(ecs_delete_empty_tables(world, 0), 2);
+
+    ecs_fini(world);
+}
+
+void World_delete_empty_tables_shrink() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t ids[1000];
+    int32_t i;
+    for (i = 0; i < 1000; i ++) {
+        ids[i] = ecs_set(world, 0, Position, {i, i * 2});
+    }
+
+    ecs_ref_t ref = {0};
+    const Position *p = ecs_get_ref(world, &ref, ids[999], Position);
+    test_int(p->x, 999);
+
+    for (i = 10; i < 990; i ++) {
+        ecs_delete(world, ids[i]);
+    }
+
+    ecs_delete_empty_tables(world, 0);
+
+    for (i = 0; i < 1000; i ++) {
+        if (i >= 10 && i < 990) {
+            test_assert(!ecs_is_alive(world, ids[i]));
+            continue;
+        }
+
+        p = ecs_get(world, ids[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+    }
+
+    /* Cached pointer is invalidated after shrinking */
+    p = ecs_get_ref(world, &ref, ids[999], Position);
+    test_assert(p == ecs_get(world, ids[999], Position));
+    test_int(p->x, 999);
+
+    test_int(ecs_count(world, Position), 20);
+    ecs_entity_t e = ecs_set(world, 0, Position, {1, 2});
+    p = ecs_get(world, e, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_fini(world);
+}
@@ -179,6 +179,8 @@ void Switch_add_pair_to_entity_w_switch(void);
 void Switch_sort(void);
 void Switch_recycled_tags(void);
 void Switch_query_recycled_tags(void);
+void Switch_query_case_runs(void);
+void Switch_query_rare_case_after_remove(void);
 
 // Testsuite 'EnabledComponents'
 void EnabledComponents_is_component_enabled(void);
@@ -218,6 +220,9 @@ void EnabledComponents_query_randomized_3_bitsets(void);
 void EnabledComponents_query_randomized_4_bitsets(void);
 void EnabledComponents_defer_enable(void);
 void EnabledComponents_sort(void);
+void EnabledComponents_query_disabled_2_tables(void);
+void EnabledComponents_query_disabled_long_runs(void);
+void EnabledComponents_query_disabled_long_runs_2_bitsets(void);
 
 // Testsuite 'Remove'
 void Remove_zero(void);
@@ -471,6 +476,7 @@ void Add_remove_bulk_add_remove_add_only(void);
 void Add_remove_bulk_add_remove_remove_only(void);
 void Add_remove_bulk_add_remove_both(void);
 void Add_remove_bulk_add_remove_same(void);
+void Add_add_remove_many_lo_ids(void);
 
 // Testsuite 'Has'
 void Has_zero(void);
@@ -667,6 +673,13 @@ void Lookup_define_duplicate_alias(void);
 void Lookup_define_alias_in_scope(void);
 void Lookup_lookup_null(void);
 void Lookup_lookup_symbol_null(void);
+void Lookup_lookup_child_after_reparent(void);
+void Lookup_lookup_child_after_rename(void);
+void Lookup_lookup_child_after_remove_name(void);
+void Lookup_lookup_deleted_child(void);
+void Lookup_lookup_child_many(void);
+void Lookup_lookup_symbol_after_set_symbol(void);
+void Lookup_lookup_child_after_snapshot_restore(void);
 
 // Testsuite 'Singleton'
 void Singleton_set(void);
@@ -741,6 +754,8 @@ void ComponentLifecycle_allow_lifecycle_overwrite_equal_callbacks(void);
 void ComponentLifecycle_set_lifecycle_after_trigger(void);
 void ComponentLifecycle_valid_entity_in_dtor_after_delete(void);
 void ComponentLifecycle_ctor_w_emplace(void);
+void ComponentLifecycle_dtor_on_realloc(void);
+void ComponentLifecycle_move_ctor_on_realloc(void);
 
 // Testsuite 'Pipeline'
 void Pipeline_setup(void);
@@ -892,6 +907,9 @@ void Sorting_sort_w_tags_only(void);
 void Sorting_sort_childof_marked(void);
 void Sorting_sort_isa_marked(void);
 void Sorting_sort_relation_marked(void);
+void Sorting_sort_after_add_to_sorted_table(void);
+void Sorting_sort_after_modify_sorted_table(void);
+void Sorting_sort_1000_entities_16_types(void);
 
 // Testsuite 'Queries'
 void Queries_query_changed_after_new(void);
@@ -931,6 +949,13 @@ void Queries_only_from_singleton(void);
 void Queries_only_not_from_entity(void);
 void Queries_only_not_from_singleton(void);
 void Queries_get_filter(void);
+void Queries_match_new_table_w_rare_term(void);
+void Queries_match_new_table_w_isa_base(void);
+void Queries_match_existing_table_w_isa_base(void);
+void Queries_match_new_table_after_query_fini(void);
+void Queries_query_overaligned_component(void);
+void Queries_query_terms_w_size(void);
+void Queries_query_terms_w_size_shared(void);
 
 // Testsuite 'Pairs'
 void Pairs_type_w_one_pair(void);
@@ -1242,6 +1267,16 @@ void Timer_rate_entity(void);
 void Timer_nested_rate_entity(void);
 void Timer_nested_rate_entity_empty_src(void);
 void Timer_naked_tick_entity(void);
+void Timer_wheel_timeout(void);
+void Timer_wheel_interval(void);
+void Timer_wheel_start_stop_interval(void);
+void Timer_wheel_rate_filter_w_timer_src(void);
+void Timer_wheel_tick_entity(void);
+void Timer_wheel_long_timeout(void);
+void Timer_wheel_overflow(void);
+void Timer_wheel_existing_timers(void);
+void Timer_wheel_delete_timer(void);
+void Timer_wheel_same_as_timers(void);
 
 // Testsuite 'SystemOnDemand'
 void SystemOnDemand_enable_out_after_in(void);
@@ -1381,6 +1416,12 @@ void Prefab_override_from_recycled_base(void);
 void Prefab_remove_override_from_recycled_base(void);
 void Prefab_instantiate_tree_from_recycled_base(void);
 void Prefab_rematch_after_add_to_recycled_base(void);
+void Prefab_get_after_base_add(void);
+void Prefab_get_after_base_remove(void);
+void Prefab_get_after_base_row_change(void);
+void Prefab_get_after_nested_base_override(void);
+void Prefab_get_after_base_delete(void);
+void Prefab_get_deferred_after_base_set(void);
 
 // Testsuite 'System_w_FromContainer'
 void System_w_FromContainer_setup(void);
@@ -1455,6 +1496,15 @@ void World_no_threading(void);
 void World_no_time(void);
 void World_is_entity_enabled(void);
 void World_get_stats(void);
+void World_stats_table_edge_memory(void);
+void World_delete_empty_tables(void);
+void World_delete_empty_tables_after_frames(void);
+void World_table_gc_progress(void);
+void World_delete_empty_tables_recreate(void);
+void World_delete_empty_tables_switch(void);
+void World_delete_empty_tables_pinned_type(void);
+void World_delete_empty_tables_w_snapshot(void);
+void World_delete_empty_tables_shrink(void);
 
 // Testsuite 'Type'
 void Type_setup(void);
@@ -1614,6 +1664,12 @@ void MultiThread_multithread_quit(void);
 void MultiThread_schedule_w_tasks(void);
 void MultiThread_reactive_system(void);
 void MultiThread_fini_after_set_threads(void);
+void MultiThread_work_stealing_2_thread_uneven_tables(void);
+void MultiThread_work_stealing_6_thread_1000_entity(void);
+void MultiThread_work_stealing_w_deferred_add(void);
+void MultiThread_parallel_systems_disjoint(void);
+void MultiThread_parallel_systems_conflicting(void);
+void MultiThread_parallel_systems_w_merge(void);
 
 // Testsuite 'DeferredActions'
 void DeferredActions_defer_new(void);
@@ -1665,6 +1721,15 @@ void DeferredActions_register_component_while_staged(void);
 void DeferredActions_register_component_while_deferred(void);
 void DeferredActions_defer_enable(void);
 void DeferredActions_defer_disable(void);
+void DeferredActions_defer_set_1000(void);
+void DeferredActions_defer_set_large_value(void);
+void DeferredActions_defer_get_mut_after_many_ops(void);
+void DeferredActions_defer_bulk_new_w_data_after_many_ops(void);
+void DeferredActions_defer_batch_add_3_components(void);
+void DeferredActions_defer_batch_add_1000_w_on_add(void);
+void DeferredActions_defer_batch_add_set_add(void);
+void DeferredActions_defer_batch_add_remove_same(void);
+void DeferredActions_defer_batch_new_w_component(void);
 
 // Testsuite 'SingleThreadStaging'
 void SingleThreadStaging_setup(void);
@@ -1748,6 +1813,9 @@ void MultiThreadStaging_new_w_count(void);
 void MultiThreadStaging_custom_thread_auto_merge(void);
 void MultiThreadStaging_custom_thread_manual_merge(void);
 void MultiThreadStaging_custom_thread_partial_manual_merge(void);
+void MultiThreadStaging_new_id_unique_across_stages(void);
+void MultiThreadStaging_new_id_recycle_in_stage(void);
+void MultiThreadStaging_new_id_release_unused(void);
 
 // Testsuite 'Stresstests'
 void Stresstests_setup(void);
@@ -1794,6 +1862,24 @@ void Snapshot_set_after_snapshot(void);
 void Snapshot_restore_recycled(void);
 void Snapshot_snapshot_w_new_in_onset(void);
 void Snapshot_snapshot_w_new_in_onset_in_snapshot_table(void);
+void Snapshot_snapshot_incremental(void);
+void Snapshot_snapshot_incremental_free_prev(void);
+void Snapshot_snapshot_incremental_free_next(void);
+void Snapshot_snapshot_incremental_chain(void);
+void Snapshot_snapshot_incremental_after_new(void);
+void Snapshot_snapshot_incremental_restore_unchanged(void);
+void Snapshot_snapshot_diff_no_changes(void);
+void Snapshot_snapshot_diff_changed_value(void);
+void Snapshot_snapshot_diff_changed_range(void);
+void Snapshot_snapshot_diff_created(void);
+void Snapshot_snapshot_diff_deleted(void);
+void Snapshot_snapshot_diff_moved(void);
+void Snapshot_snapshot_diff_moved_remove(void);
+void Snapshot_snapshot_diff_two_snapshots(void);
+void Snapshot_snapshot_diff_incremental(void);
+void Snapshot_snapshot_diff_apply_other_world(void);
+void Snapshot_snapshot_diff_apply_malformed(void);
+void Snapshot_snapshot_diff_encode_size(void);
 
 // Testsuite 'ReaderWriter'
 void ReaderWriter_simple(void);
@@ -1819,6 +1905,16 @@ void ReaderWriter_invalid_header(void);
 void ReaderWriter_recycled_id(void);
 void ReaderWriter_new_component_after_restore(void);
 void ReaderWriter_delete_all_after_restore(void);
+void ReaderWriter_blob_simple(void);
+void ReaderWriter_blob_tag(void);
+void ReaderWriter_blob_names(void);
+void ReaderWriter_blob_aligned_columns(void);
+void ReaderWriter_blob_buffer_too_small(void);
+void ReaderWriter_blob_invalid_header(void);
+void ReaderWriter_blob_invalid_table(void);
+void ReaderWriter_blob_invalid_name(void);
+void ReaderWriter_blob_recycled_id(void);
+void ReaderWriter_blob_deserialize_twice(void);
 
 // Testsuite 'FilterIter'
 void FilterIter_iter_one_table(void);
@@ -2444,6 +2540,10 @@ bake_test_case Add_testcases[] = {
     {
         "add_after_remove_xor",
         Add_add_after_remove_xor
+    },
+    {
+        "add_remove_many_lo_ids",
+        Add_add_remove_many_lo_ids
     }
 };
 
@@ -2563,6 +2663,14 @@ bake_test_case Switch_testcases[] = {
     {
         "query_recycled_tags",
         Switch_query_recycled_tags
+    },
+    {
+        "query_case_runs",
+        Switch_query_case_runs
+    },
+    {
+        "query_rare_case_after_remove",
+        Switch_query_rare_case_after_remove
     }
 };
 
@@ -2714,6 +2822,18 @@ bake_test_case EnabledComponents_testcases[] = {
     {
         "sort",
         EnabledComponents_sort
+    },
+    {
+        "query_disabled_2_tables",
+        EnabledComponents_query_disabled_2_tables
+    },
+    {
+        "query_disabled_long_runs",
+        EnabledComponents_query_disabled_long_runs
+    },
+    {
+        "query_disabled_long_runs_2_bitsets",
+        EnabledComponents_query_disabled_long_runs_2_bitsets
     }
 };
 
@@ -4410,6 +4530,34 @@ bake_test_case Lookup_testcases[] = {
     {
         "lookup_symbol_null",
         Lookup_lookup_symbol_null
+    },
+    {
+        "lookup_child_after_reparent",
+        Lookup_lookup_child_after_reparent
+    },
+    {
+        "lookup_child_after_rename",
+        Lookup_lookup_child_after_rename
+    },
+    {
+        "lookup_child_after_remove_name",
+        Lookup_lookup_child_after_remove_name
+    },
+    {
+        "lookup_deleted_child",
+        Lookup_lookup_deleted_child
+    },
+    {
+        "lookup_child_many",
+        Lookup_lookup_child_many
+    },
+    {
+        "lookup_symbol_after_set_symbol",
+        Lookup_lookup_symbol_after_set_symbol
+    },
+    {
+        "lookup_child_after_snapshot_restore",
+        Lookup_lookup_child_after_snapshot_restore
     }
 };
 
@@ -4687,6 +4835,14 @@ bake_test_case ComponentLifecycle_testcases[] = {
     {
         "ctor_w_emplace",
         ComponentLifecycle_ctor_w_emplace
+    },
+    {
+        "dtor_on_realloc",
+        ComponentLifecycle_dtor_on_realloc
+    },
+    {
+        "move_ctor_on_realloc",
+        ComponentLifecycle_move_ctor_on_realloc
     }
 };
 
@@ -5268,6 +5424,18 @@ bake_test_case Sorting_testcases[] = {
     {
         "sort_relation_marked",
         Sorting_sort_relation_marked
+    },
+    {
+        "sort_after_add_to_sorted_table",
+        Sorting_sort_after_add_to_sorted_table
+    },
+    {
+        "sort_after_modify_sorted_table",
+        Sorting_sort_after_modify_sorted_table
+    },
+    {
+        "sort_1000_entities_16_types",
+        Sorting_sort_1000_entities_16_types
     }
 };
 
@@ -5419,6 +5587,34 @@ bake_test_case Queries_testcases[] = {
     {
         "get_filter",
         Queries_get_filter
+    },
+    {
+        "match_new_table_w_rare_term",
+        Queries_match_new_table_w_rare_term
+    },
+    {
+        "match_new_table_w_isa_base",
+        Queries_match_new_table_w_isa_base
+    },
+    {
+        "match_existing_table_w_isa_base",
+        Queries_match_existing_table_w_isa_base
+    },
+    {
+        "match_new_table_after_query_fini",
+        Queries_match_new_table_after_query_fini
+    },
+    {
+        "query_overaligned_component",
+        Queries_query_overaligned_component
+    },
+    {
+        "query_terms_w_size",
+        Queries_query_terms_w_size
+    },
+    {
+        "query_terms_w_size_shared",
+        Queries_query_terms_w_size_shared
     }
 };
 
@@ -6604,6 +6800,46 @@ bake_test_case Timer_testcases[] = {
     {
         "naked_tick_entity",
         Timer_naked_tick_entity
+    },
+    {
+        "wheel_timeout",
+        Timer_wheel_timeout
+    },
+    {
+        "wheel_interval",
+        Timer_wheel_interval
+    },
+    {
+        "wheel_start_stop_interval",
+        Timer_wheel_start_stop_interval
+    },
+    {
+        "wheel_rate_filter_w_timer_src",
+        Timer_wheel_rate_filter_w_timer_src
+    },
+    {
+        "wheel_tick_entity",
+        Timer_wheel_tick_entity
+    },
+    {
+        "wheel_long_timeout",
+        Timer_wheel_long_timeout
+    },
+    {
+        "wheel_overflow",
+        Timer_wheel_overflow
+    },
+    {
+        "wheel_existing_timers",
+        Timer_wheel_existing_timers
+    },
+    {
+        "wheel_delete_timer",
+        Timer_wheel_delete_timer
+    },
+    {
+        "wheel_same_as_timers",
+        Timer_wheel_same_as_timers
     }
 };
 
@@ -7127,6 +7363,30 @@ bake_test_case Prefab_testcases[] = {
     {
         "rematch_after_add_to_recycled_base",
         Prefab_rematch_after_add_to_recycled_base
+    },
+    {
+        "get_after_base_add",
+        Prefab_get_after_base_add
+    },
+    {
+        "get_after_base_remove",
+        Prefab_get_after_base_remove
+    },
+    {
+        "get_after_base_row_change",
+        Prefab_get_after_base_row_change
+    },
+    {
+        "get_after_nested_base_override",
+        Prefab_get_after_nested_base_override
+    },
+    {
+        "get_after_base_delete",
+        Prefab_get_after_base_delete
+    },
+    {
+        "get_deferred_after_base_set",
+        Prefab_get_deferred_after_base_set
     }
 };
 
@@ -7390,6 +7650,42 @@ bake_test_case World_testcases[] = {
     {
         "get_stats",
         World_get_stats
+    },
+    {
+        "stats_table_edge_memory",
+        World_stats_table_edge_memory
+    },
+    {
+        "delete_empty_tables",
+        World_delete_empty_tables
+    },
+    {
+        "delete_empty_tables_after_frames",
+        World_delete_empty_tables_after_frames
+    },
+    {
+        "table_gc_progress",
+        World_table_gc_progress
+    },
+    {
+        "delete_empty_tables_recreate",
+        World_delete_empty_tables_recreate
+    },
+    {
+        "delete_empty_tables_switch",
+        World_delete_empty_tables_switch
+    },
+    {
+        "delete_empty_tables_pinned_type",
+        World_delete_empty_tables_pinned_type
+    },
+    {
+        "delete_empty_tables_w_snapshot",
+        World_delete_empty_tables_w_snapshot
+    },
+    {
+        "delete_empty_tables_shrink",
+        World_delete_empty_tables_shrink
     }
 };
 
@@ -7999,6 +8295,30 @@ bake_test_case MultiThread_testcases[] = {
     {
         "fini_after_set_threads",
         MultiThread_fini_after_set_threads
+    },
+    {
+        "work_stealing_2_thread_uneven_tables",
+        MultiThread_work_stealing_2_thread_uneven_tables
+    },
+    {
+        "work_stealing_6_thread_1000_entity",
+        MultiThread_work_stealing_6_thread_1000_entity
+    },
+    {
+        "work_stealing_w_deferred_add",
+        MultiThread_work_stealing_w_deferred_add
+    },
+    {
+        "parallel_systems_disjoint",
+        MultiThread_parallel_systems_disjoint
+    },
+    {
+        "parallel_systems_conflicting",
+        MultiThread_parallel_systems_conflicting
+    },
+    {
+        "parallel_systems_w_merge",
+        MultiThread_parallel_systems_w_merge
     }
 };
 
@@ -8198,6 +8518,42 @@ bake_test_case DeferredActions_testcases[] = {
     {
         "defer_disable",
         DeferredActions_defer_disable
+    },
+    {
+        "defer_set_1000",
+        DeferredActions_defer_set_1000
+    },
+    {
+        "defer_set_large_value",
+        DeferredActions_defer_set_large_value
+    },
+    {
+        "defer_get_mut_after_many_ops",
+        DeferredActions_defer_get_mut_after_many_ops
+    },
+    {
+        "defer_bulk_new_w_data_after_many_ops",
+        DeferredActions_defer_bulk_new_w_data_after_many_ops
+    },
+    {
+        "defer_batch_add_3_components",
+        DeferredActions_defer_batch_add_3_components
+    },
+    {
+        "defer_batch_add_1000_w_on_add",
+        DeferredActions_defer_batch_add_1000_w_on_add
+    },
+    {
+        "defer_batch_add_set_add",
+        DeferredActions_defer_batch_add_set_add
+    },
+    {
+        "defer_batch_add_remove_same",
+        DeferredActions_defer_batch_add_remove_same
+    },
+    {
+        "defer_batch_new_w_component",
+        DeferredActions_defer_batch_new_w_component
     }
 };
 
@@ -8512,6 +8868,18 @@ bake_test_case MultiThreadStaging_testcases[] = {
     {
         "custom_thread_partial_manual_merge",
         MultiThreadStaging_custom_thread_partial_manual_merge
+    },
+    {
+        "new_id_unique_across_stages",
+        MultiThreadStaging_new_id_unique_across_stages
+    },
+    {
+        "new_id_recycle_in_stage",
+        MultiThreadStaging_new_id_recycle_in_stage
+    },
+    {
+        "new_id_release_unused",
+        MultiThreadStaging_new_id_release_unused
     }
 };
 
@@ -8682,6 +9050,78 @@ bake_test_case Snapshot_testcases[] = {
     {
         "snapshot_w_new_in_onset_in_snapshot_table",
         Snapshot_snapshot_w_new_in_onset_in_snapshot_table
+    },
+    {
+        "snapshot_incremental",
+        Snapshot_snapshot_incremental
+    },
+    {
+        "snapshot_incremental_free_prev",
+        Snapshot_snapshot_incremental_free_prev
+    },
+    {
+        "snapshot_incremental_free_next",
+        Snapshot_snapshot_incremental_free_next
+    },
+    {
+        "snapshot_incremental_chain",
+        Snapshot_snapshot_incremental_chain
+    },
+    {
+        "snapshot_incremental_after_new",
+        Snapshot_snapshot_incremental_after_new
+    },
+    {
+        "snapshot_incremental_restore_unchanged",
+        Snapshot_snapshot_incremental_restore_unchanged
+    },
+    {
+        "snapshot_diff_no_changes",
+        Snapshot_snapshot_diff_no_changes
+    },
+    {
+        "snapshot_diff_changed_value",
+        Snapshot_snapshot_diff_changed_value
+    },
+    {
+        "snapshot_diff_changed_range",
+        Snapshot_snapshot_diff_changed_range
+    },
+    {
+        "snapshot_diff_created",
+        Snapshot_snapshot_diff_created
+    },
+    {
+        "snapshot_diff_deleted",
+        Snapshot_snapshot_diff_deleted
+    },
+    {
+        "snapshot_diff_moved",
+        Snapshot_snapshot_diff_moved
+    },
+    {
+        "snapshot_diff_moved_remove",
+        Snapshot_snapshot_diff_moved_remove
+    },
+    {
+        "snapshot_diff_two_snapshots",
+        Snapshot_snapshot_diff_two_snapshots
+    },
+    {
+        "snapshot_diff_incremental",
+        Snapshot_snapshot_diff_incremental
+    },
+    {
+        "snapshot_diff_apply_other_world",
+        Snapshot_snapshot_diff_apply_other_world
+    },
+    {
+        "snapshot_diff_apply_malformed",
+        Snapshot_snapshot_diff_apply_malformed
+    },
+    {
+        "snapshot_diff_encode_size",
+        Snapshot_snapshot_diff_encode_size
     }
 };
 
@@ -8777,6 +9217,46 @@ bake_test_case ReaderWriter_testcases[] = {
     {
         "delete_all_after_restore",
         ReaderWriter_delete_all_after_restore
+    },
+    {
+        "blob_simple",
+        ReaderWriter_blob_simple
+    },
+    {
+        "blob_tag",
+        ReaderWriter_blob_tag
+    },
+    {
+        "blob_names",
+        ReaderWriter_blob_names
+    },
+    {
+        "blob_aligned_columns",
+        ReaderWriter_blob_aligned_columns
+    },
+    {
+        "blob_buffer_too_small",
+        ReaderWriter_blob_buffer_too_small
+    },
+    {
+        "blob_invalid_header",
+        ReaderWriter_blob_invalid_header
+    },
+    {
+        "blob_invalid_table",
+        ReaderWriter_blob_invalid_table
+    },
+    {
+        "blob_invalid_name",
+        ReaderWriter_blob_invalid_name
+    },
+    {
+        "blob_recycled_id",
+        ReaderWriter_blob_recycled_id
+    },
+    {
+        "blob_deserialize_twice",
+        ReaderWriter_blob_deserialize_twice
     }
 };
 
@@ -9128,21 +9608,21 @@ static bake_test_suite suites[] = {
         "Add",
         NULL,
         NULL,
-        37,
+        38,
         Add_testcases
     },
     {
         "Switch",
         Switch_setup,
         NULL,
-        29,
+        31,
         Switch_testcases
     },
     {
         "EnabledComponents",
         NULL,
         NULL,
-        37,
+        40,
         EnabledComponents_testcases
     },
     {
@@ -9254,7 +9734,7 @@ static bake_test_suite suites[] = {
         "Lookup",
         Lookup_setup,
         NULL,
-        21,
+        28,
         Lookup_testcases
     },
     {
@@ -9275,7 +9755,7 @@ static bake_test_suite suites[] = {
         "ComponentLifecycle",
         ComponentLifecycle_setup,
         NULL,
-        43,
+        45,
         ComponentLifecycle_testcases
     },
     {
@@ -9296,14 +9776,14 @@ static bake_test_suite suites[] = {
         "Sorting",
         NULL,
         NULL,
-        30,
+        33,
         Sorting_testcases
     },
     {
         "Queries",
         NULL,
         NULL,
-        37,
+        44,
         Queries_testcases
     },
     {
@@ -9380,7 +9860,7 @@ static bake_test_suite suites[] = {
         "Timer",
         NULL,
         NULL,
-        16,
+        26,
         Timer_testcases
     },
     {
@@ -9415,7 +9895,7 @@ static bake_test_suite suites[] = {
         "Prefab",
         Prefab_setup,
         NULL,
-        86,
+        92,
         Prefab_testcases
     },
     {
@@ -9450,7 +9930,7 @@ static bake_test_suite suites[] = {
         "World",
         World_setup,
         NULL,
-        33,
+        42,
         World_testcases
     },
     {
@@ -9471,14 +9951,14 @@ static bake_test_suite suites[] = {
         "MultiThread",
         MultiThread_setup,
         NULL,
-        35,
+        41,
         MultiThread_testcases
     },
     {
         "DeferredActions",
         NULL,
         NULL,
-        49,
+        58,
         DeferredActions_testcases
     },
     {
@@ -9492,7 +9972,7 @@ static bake_test_suite suites[] = {
         "MultiThreadStaging",
         MultiThreadStaging_setup,
         NULL,
-        10,
+        13,
         MultiThreadStaging_testcases
     },
     {
@@ -9506,14 +9986,14 @@ static bake_test_suite suites[] = {
         "Snapshot",
         NULL,
         NULL,
-        26,
+        44,
         Snapshot_testcases
     },
     {
         "ReaderWriter",
         NULL,
         NULL,
-        23,
+        33,
         ReaderWriter_testcases
     },
     {
@@ -284,7 +284,7 @@ void Map_grow() {
         ecs_map_set(map, i, &v);
     }
 
-    test_int(malloc_count, 20);
+    test_int(malloc_count, 0);
 
     ecs_map_free(map);
 }
@@ -309,3 +309,88 @@ void Map_ensure() {
 
     ecs_map_free(map);
 }
+
+void Map_set_remove_many() {
+    ecs_map_t *map = ecs_map_new(int32_t, 0);
+
+    int32_t i;
+    for (i = 0; i < 1000; i ++) {
+        ecs_map_set(map, i, &i);
+    }
+    test_int(ecs_map_count(map), 1000);
+
+    for (i = 0; i < 1000; i += 2) {
+        ecs_map_remove(map, i);
+    }
+    test_int(ecs_map_count(map), 500);
+
+    for (i = 0; i < 1000; i ++) {
+        int32_t *v = ecs_map_get(map, int32_t, i);
+        if (i % 2) {
+            test_assert(v != NULL);
+            test_int(*v, i);
+        } else {
+            test_assert(v == NULL);
+        }
+    }
+
+    /* Reinsert removed keys, which reuses deleted slots */
+    for (i = 0; i < 1000; i += 2) {
+        ecs_map_set(map, i, &i);
+    }
+    test_int(ecs_map_count(map), 1000);
+
+    for (i = 0; i < 1000; i ++) {
+        int32_t *v = ecs_map_get(map, int32_t, i);
+        test_assert(v != NULL);
+        test_int(*v, i);
+    }
+
+    ecs_map_free(map);
+}
+
+void Map_remove_while_iterating() {
+    ecs_map_t *map = ecs_map_new(int32_t, 0);
+
+    int32_t i;
+    for (i = 0; i < 100; i ++) {
+        ecs_map_set(map, i, &i);
+    }
+
+    int32_t count = 0;
+    ecs_map_iter_t it = ecs_map_iter(map);
+    ecs_map_key_t key;
+    int32_t *v;
+    while ((v = ecs_map_next(&it, int32_t, &key))) {
+        test_int(*v, (int32_t)key);
+        ecs_map_remove(map, key);
+        count ++;
+    }
+
+    test_int(count, 100);
+    test_int(ecs_map_count(map), 0);
+
+    ecs_map_free(map);
+}
+
+void Map_set_colliding_keys() {
+    ecs_map_t *map = ecs_map_new(int32_t, 0);
+
+    /* Keys that only differ in their upper 32 bits, like pairs with the
+     * same object */
+    int32_t i;
+    for (i = 0; i < 100; i ++) {
+        ecs_map_key_t key = ((ecs_map_key_t)i << 32) | 10;
+        ecs_map_set(map, key, &i);
+    }
+    test_int(ecs_map_count(map), 100);
+
+    for (i = 0; i < 100; i ++) {
+        ecs_map_key_t key = ((ecs_map_key_t)i << 32) | 10;
+        int32_t *v = ecs_map_get(map, int32_t, key);
+        test_assert(v != NULL);
+        test_int(*v, i);
+    }
+
+    ecs_map_free(map);
+}
@@ -399,3 +399,47 @@ void Sparse_size_of_null() {
 void Sparse_copy_null() {
     test_assert(ecs_sparse_copy(NULL) == NULL);
 }
+
+void Sparse_new_ids_recycled_and_new() {
+    ecs_sparse_t *sp = ecs_sparse_new(int);
+
+    uint64_t id_1 = ecs_sparse_new_id(sp);
+    uint64_t id_2 = ecs_sparse_new_id(sp);
+    ecs_sparse_remove(sp, id_1);
+    test_int(ecs_sparse_count(sp), 1);
+
+    /* One recycled and two new ids */
+    const uint64_t *ids = ecs_sparse_new_ids(sp, 3);
+    uint64_t new_ids[3] = {ids[0], ids[1], ids[2]};
+    test_int(ecs_sparse_count(sp), 4);
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        test_assert(ecs_sparse_is_alive(sp, new_ids[i]));
+        test_assert(new_ids[i] != id_2);
+    }
+    test_assert(ecs_sparse_is_alive(sp, id_2));
+
+    ecs_sparse_free(sp);
+}
+
+void Sparse_release_id() {
+    ecs_sparse_t *sp = ecs_sparse_new(int);
+
+    uint64_t id_1 = ecs_sparse_new_id(sp);
+    uint64_t id_2 = ecs_sparse_new_id(sp);
+    *ecs_sparse_get_sparse(sp, int, id_1) = 10;
+
+    ecs_sparse_release_id(sp, id_1);
+    test_int(ecs_sparse_count(sp), 1);
+    test_assert(!ecs_sparse_is_alive(sp, id_1));
+    test_assert(ecs_sparse_is_alive(sp, id_2));
+
+    /* Released id is recycled without a new generation */
+    uint64_t id_3 = ecs_sparse_new_id(sp);
+    test_int(id_3, id_1);
+    test_assert(ecs_sparse_is_alive(sp, id_1));
+    test_int(*ecs_sparse_get_sparse(sp, int, id_3), 0);
+
+    ecs_sparse_free(sp);
+}
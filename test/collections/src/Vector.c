@@ -359,3 +359,82 @@ void Vector_set_min_size_to_smaller() {
 
     ecs_vector_free(array);
 }
+
+void Vector_aligned_add() {
+    ecs_vector_t *array = ecs_vector_new_t(ECS_SIZEOF(int), 64, 0);
+    test_assert(array != NULL);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        int *elem = ecs_vector_add_t(&array, ECS_SIZEOF(int), 64);
+        test_assert(elem != NULL);
+        *elem = i;
+
+        int *first = ecs_vector_first_t(array, ECS_SIZEOF(int), 64);
+        test_assert(!((uintptr_t)first & 63));
+    }
+
+    int *first = ecs_vector_first_t(array, ECS_SIZEOF(int), 64);
+    for (i = 0; i < 100; i ++) {
+        test_int(first[i], i);
+    }
+
+    ecs_vector_free(array);
+}
+
+void Vector_aligned_set_size() {
+    ecs_vector_t *array = NULL;
+    ecs_vector_set_count_t(&array, ECS_SIZEOF(int), 32, 3);
+    int *first = ecs_vector_first_t(array, ECS_SIZEOF(int), 32);
+    test_assert(!((uintptr_t)first & 31));
+    first[0] = 10;
+    first[1] = 20;
+    first[2] = 30;
+
+    ecs_vector_set_size_t(&array, ECS_SIZEOF(int), 32, 1000);
+    test_int(ecs_vector_size(array), 1024);
+    test_int(ecs_vector_count(array), 3);
+
+    first = ecs_vector_first_t(array, ECS_SIZEOF(int), 32);
+    test_assert(!((uintptr_t)first & 31));
+    test_int(first[0], 10);
+    test_int(first[1], 20);
+    test_int(first[2], 30);
+
+    ecs_vector_free(array);
+}
+
+void Vector_aligned_padded() {
+    ecs_vector_t *array = ecs_vector_new_t(ECS_SIZEOF(int), 64, 1);
+    int *elem = ecs_vector_add_t(&array, ECS_SIZEOF(int), 64);
+    test_assert(elem != NULL);
+
+    /* Storage is padded to a multiple of the alignment, so writing a full
+     * block must stay within the allocation */
+    ecs_os_memset(elem, 0, 64);
+
+    ecs_vector_free(array);
+}
+
+void Vector_aligned_copy() {
+    ecs_vector_t *array = ecs_vector_new_t(ECS_SIZEOF(int), 64, 0);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        int *elem = ecs_vector_add_t(&array, ECS_SIZEOF(int), 64);
+        *elem = i;
+    }
+
+    ecs_vector_t *copy = ecs_vector_copy_t(array, ECS_SIZEOF(int), 64);
+    test_assert(copy != NULL);
+    test_int(ecs_vector_count(copy), 10);
+
+    int *first = ecs_vector_first_t(copy, ECS_SIZEOF(int), 64);
+    test_assert(!((uintptr_t)first & 63));
+    for (i = 0; i < 10; i ++) {
+        test_int(first[i], i);
+    }
+
+    ecs_vector_free(array);
+    ecs_vector_free(copy);
+}
@@ -41,6 +41,10 @@ void Vector_addn_to_0_size(void);
 void Vector_set_min_count(void);
 void Vector_set_min_size(void);
 void Vector_set_min_size_to_smaller(void);
+void Vector_aligned_add(void);
+void Vector_aligned_set_size(void);
+void Vector_aligned_padded(void);
+void Vector_aligned_copy(void);
 
 // Testsuite 'Queue'
 void Queue_setup(void);
@@ -70,6 +74,9 @@ void Map_remove_unknown(void);
 void Map_grow(void);
 void Map_set_size_0(void);
 void Map_ensure(void);
+void Map_set_remove_many(void);
+void Map_remove_while_iterating(void);
+void Map_set_colliding_keys(void);
 
 // Testsuite 'Sparse'
 void Sparse_setup(void);
@@ -96,6 +103,8 @@ void Sparse_create_delete_2(void);
 void Sparse_count_of_null(void);
 void Sparse_size_of_null(void);
 void Sparse_copy_null(void);
+void Sparse_new_ids_recycled_and_new(void);
+void Sparse_release_id(void);
 
 // Testsuite 'Strbuf'
 void Strbuf_setup(void);
@@ -238,6 +247,22 @@ bake_test_case Vector_testcases[] = {
     {
         "set_min_size_to_smaller",
         Vector_set_min_size_to_smaller
+    },
+    {
+        "aligned_add",
+        Vector_aligned_add
+    },
+    {
+        "aligned_set_size",
+        Vector_aligned_set_size
+    },
+    {
+        "aligned_padded",
+        Vector_aligned_padded
+    },
+    {
+        "aligned_copy",
+        Vector_aligned_copy
     }
 };
 
@@ -336,6 +361,18 @@ bake_test_case Map_testcases[] = {
     {
         "ensure",
         Map_ensure
+    },
+    {
+        "set_remove_many",
+        Map_set_remove_many
+    },
+    {
+        "remove_while_iterating",
+        Map_remove_while_iterating
+    },
+    {
+        "set_colliding_keys",
+        Map_set_colliding_keys
     }
 };
 
@@ -431,6 +468,14 @@ bake_test_case Sparse_testcases[] = {
     {
         "copy_null",
         Sparse_copy_null
+    },
+    {
+        "new_ids_recycled_and_new",
+        Sparse_new_ids_recycled_and_new
+    },
+    {
+        "release_id",
+        Sparse_release_id
     }
 };
 
@@ -498,7 +543,7 @@ static bake_test_suite suites[] = {
         "Vector",
         Vector_setup,
         NULL,
-        31,
+        35,
         Vector_testcases
     },
     {
@@ -512,14 +557,14 @@ static bake_test_suite suites[] = {
         "Map",
         Map_setup,
         NULL,
-        19,
+        22,
         Map_testcases
     },
     {
         "Sparse",
         Sparse_setup,
         NULL,
-        23,
+        25,
         Sparse_testcases
     },
     {
@@ -356,8 +356,9 @@ void ComponentLifecycle_implicit_component() {
 
     flecs::entity(world).add<Pod>();
     flecs::entity(world).add<Pod>();
-    test_int(Pod::ctor_invoked, 5);
-    test_int(Pod::move_invoked, 2); 
+    test_int(Pod::ctor_invoked, 3);
+    test_int(Pod::move_ctor_invoked, 2);
+    test_int(Pod::dtor_invoked, 2);
 }
 
 void ComponentLifecycle_implicit_after_query() {
@@ -382,8 +383,9 @@ void ComponentLifecycle_implicit_after_query() {
 
     flecs::entity(world).add<Pod>();
     flecs::entity(world).add<Pod>();
-    test_int(Pod::ctor_invoked, 5);
-    test_int(Pod::move_invoked, 2); 
+    test_int(Pod::ctor_invoked, 3);
+    test_int(Pod::move_ctor_invoked, 2);
+    test_int(Pod::dtor_invoked, 2);
 }
 
 template <typename T, typename std::enable_if<
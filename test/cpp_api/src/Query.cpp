@@ -1165,3 +1165,195 @@ void Query_iter_type() {
         test_assert(it.type().has<Position>());
     });
 }
+
+struct AlignedValue {
+    float value;
+};
+
+namespace flecs {
+    template <>
+    struct column_alignment<AlignedValue> 
+        : std::integral_constant<size_t, 64> { };
+}
+
+void Query_iter_aligned_column() {
+    flecs::world ecs;
+
+    for (int i = 0; i < 100; i ++) {
+        auto e = ecs.entity().set<AlignedValue>({static_cast<float>(i)});
+        if (i % 2) {
+            e.add<Position>();
+        }
+    }
+
+    test_int(ecs.component<AlignedValue>().get<flecs::Component>()->alignment, 64);
+
+    auto q = ecs.query<AlignedValue>();
+
+    int32_t count = 0;
+    q.iter([&](flecs::iter& it, AlignedValue *ptr) {
+        auto v = it.term<const AlignedValue>(1);
+        test_int(decltype(v)::alignment(), 64);
+        test_assert(v.is_aligned());
+        test_int(v.count(), it.count());
+
+        size_t padded = v.padded_count();
+        test_assert(padded >= v.count());
+        test_int(padded % 16, 0);
+
+        // Process the array in blocks, including the padded tail
+        for (size_t i = 0; i < padded; i ++) {
+            ptr[i].value += 1;
+        }
+
+        count += it.count();
+    });
+
+    test_int(count, 100);
+}
+
+void Query_iter_batches() {
+    flecs::world ecs;
+
+    for (int i = 0; i < 20; i ++) {
+        ecs.entity()
+            .set<Position>({static_cast<float>(i), 0})
+            .set<Velocity>({1, 2});
+    }
+
+    auto q = ecs.query<Position, const Velocity>();
+
+    int32_t batch_count = 0;
+    size_t count = 0;
+    q.iter_batches<8>([&](size_t n, flecs::span<Position> p, 
+        flecs::span<const Velocity> v) 
+    {
+        test_int(p.size(), n);
+        test_int(v.size(), n);
+
+        if (batch_count < 2) {
+            test_int(n, 8);
+        } else {
+            test_int(n, 4);
+        }
+
+        for (size_t i = 0; i < n; i ++) {
+            test_int(p[i].x, count + i);
+            p[i].x += v[i].x;
+            p[i].y += v[i].y;
+        }
+
+        count += n;
+        batch_count ++;
+    });
+
+    test_int(batch_count, 3);
+    test_int(count, 20);
+
+    int32_t i = 0;
+    q.each([&](Position& p, const Velocity&) {
+        test_int(p.x, i + 1);
+        test_int(p.y, 2);
+        i ++;
+    });
+
+    test_int(i, 20);
+}
+
+void Query_iter_batches_tables() {
+    flecs::world ecs;
+
+    for (int i = 0; i < 10; i ++) {
+        ecs.entity().set<Position>({0, 0});
+    }
+
+    for (int i = 0; i < 3; i ++) {
+        ecs.entity().set<Position>({0, 0}).add<Velocity>();
+    }
+
+    auto q = ecs.query<Position>();
+
+    size_t counts[8];
+    int32_t batch_count = 0;
+    q.iter_batches<4>([&](size_t n, flecs::span<Position> p) {
+        for (auto& v : p) {
+            v.x ++;
+        }
+
+        test_assert(batch_count < 8);
+        counts[batch_count ++] = n;
+    });
+
+    test_int(batch_count, 4);
+    test_int(counts[0], 4);
+    test_int(counts[1], 4);
+    test_int(counts[2], 2);
+    test_int(counts[3], 3);
+
+    int32_t count = 0;
+    q.each([&](Position& p) {
+        test_int(p.x, 1);
+        count ++;
+    });
+
+    test_int(count, 13);
+}
+
+void Query_iter_batches_shared() {
+    flecs::world ecs;
+
+    auto base = ecs.entity().set<Velocity>({1, 2});
+
+    for (int i = 0; i < 5; i ++) {
+        ecs.entity()
+            .set<Position>({10, 20})
+            .add(flecs::IsA, base);
+    }
+
+    auto q = ecs.query_builder<Position, const Velocity>()
+        .arg(2).superset()
+        .build();
+
+    size_t count = 0;
+    q.iter_batches<4>([&](size_t n, flecs::span<Position> p, 
+        const Velocity& v) 
+    {
+        for (size_t i = 0; i < n; i ++) {
+            p[i].x += v.x;
+            p[i].y += v.y;
+        }
+
+        count += n;
+    });
+
+    test_int(count, 5);
+
+    q.each([](Position& p, const Velocity&) {
+        test_int(p.x, 11);
+        test_int(p.y, 22);
+    });
+}
+
+void Query_iter_batches_aligned() {
+    flecs::world ecs;
+
+    for (int i = 0; i < 40; i ++) {
+        ecs.entity().set<AlignedValue>({static_cast<float>(i)});
+    }
+
+    auto q = ecs.query<AlignedValue>();
+
+    size_t count = 0;
+    q.iter_batches<16>([&](size_t n, flecs::span<AlignedValue> v) {
+        test_int(decltype(v)::alignment(), 64);
+        test_assert(v.is_aligned());
+
+        for (size_t i = 0; i < n; i ++) {
+            test_int(v[i].value, count + i);
+        }
+
+        count += n;
+    });
+
+    test_int(count, 40);
+}
@@ -73,7 +73,9 @@ void Switch_system_w_case() {
 
     world.progress();
 
-    test_int(invoke_count, 2);
+    /* Both entities are walking and stored next to each other, so the system
+     * is invoked once for both */
+    test_int(invoke_count, 1);
     test_int(count, 2);
 }
 
@@ -318,6 +318,11 @@ void Query_each_pair_object(void);
 void Query_iter_pair_object(void);
 void Query_iter_query_in_system(void);
 void Query_iter_type(void);
+void Query_iter_aligned_column(void);
+void Query_iter_batches(void);
+void Query_iter_batches_tables(void);
+void Query_iter_batches_shared(void);
+void Query_iter_batches_aligned(void);
 
 // Testsuite 'QueryBuilder'
 void QueryBuilder_builder_assign_same_type(void);
@@ -1772,6 +1777,26 @@ bake_test_case Query_testcases[] = {
     {
         "iter_type",
         Query_iter_type
+    },
+    {
+        "iter_aligned_column",
+        Query_iter_aligned_column
+    },
+    {
+        "iter_batches",
+        Query_iter_batches
+    },
+    {
+        "iter_batches_tables",
+        Query_iter_batches_tables
+    },
+    {
+        "iter_batches_shared",
+        Query_iter_batches_shared
+    },
+    {
+        "iter_batches_aligned",
+        Query_iter_batches_aligned
     }
 };
 
@@ -2773,7 +2798,7 @@ static bake_test_suite suites[] = {
         "Query",
         NULL,
         NULL,
-        45,
+        50,
         Query_testcases
     },
     {